@@ -99,6 +99,9 @@ This script provides helpers for building msquic.
 .PARAMETER EnableHighResolutionTimers
     Configures the system to use high resolution timers.
 
+.PARAMETER EnableProfiling
+    Compiles cycle counters into the hot send and receive paths.
+
 .PARAMETER ExtraArtifactDir
     Add an extra classifier to the artifact directory to allow publishing alternate builds of same base library
 
@@ -222,6 +225,9 @@ param (
     [Parameter(Mandatory = $false)]
     [switch]$EnableHighResolutionTimers = $false,
 
+    [Parameter(Mandatory = $false)]
+    [switch]$EnableProfiling = $false,
+
     [Parameter(Mandatory = $false)]
     [string]$ExtraArtifactDir = "",
 
@@ -528,6 +534,9 @@ function CMake-Generate {
     if ($EnableHighResolutionTimers) {
         $Arguments += " -DQUIC_HIGH_RES_TIMERS=on"
     }
+    if ($EnableProfiling) {
+        $Arguments += " -DQUIC_ENABLE_PROFILING=on"
+    }
     if ($Platform -eq "android") {
         $NDK = $env:ANDROID_NDK_LATEST_HOME
         $env:PATH = "$NDK/toolchains/llvm/prebuilt/linux-x86_64/bin:$env:PATH"
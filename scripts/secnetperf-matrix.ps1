@@ -0,0 +1,362 @@
+<#
+
+.SYNOPSIS
+This script runs a matrix of secnetperf tests (congestion control x IO model x
+network emulation x scenario) over loopback, repeats each test to estimate its
+variance, and compares the results against a stored baseline. It is meant to
+quantify the effect of changes to the congestion control and send paths.
+
+.PARAMETER Config
+    Specifies the build configuration to test.
+
+.PARAMETER Arch
+    The CPU architecture to test.
+
+.PARAMETER Tls
+    The TLS library test.
+
+.PARAMETER Matrix
+    The JSON file describing the test matrix. See secnetperf-matrix.json.
+
+.PARAMETER Baseline
+    A results file from a previous run to compare against. Optional.
+
+.PARAMETER OutputFile
+    Where to write the JSON results.
+
+.PARAMETER UpdateBaseline
+    Also writes the results to the baseline file, for use by later runs.
+
+.PARAMETER Filter
+    Only runs the test cases whose name (<cc>-<io>-<emulation>-<scenario>)
+    matches this wildcard pattern.
+
+.PARAMETER TimeoutMs
+    The maximum time to wait for a single test run.
+
+.EXAMPLE
+    secnetperf-matrix.ps1 -Baseline ./artifacts/perf/baseline.json
+
+.EXAMPLE
+    secnetperf-matrix.ps1 -Filter "cubic-epoll-*" -UpdateBaseline
+
+#>
+
+param (
+    [Parameter(Mandatory = $false)]
+    [ValidateSet("Debug", "Release")]
+    [string]$Config = "Release",
+
+    [Parameter(Mandatory = $false)]
+    [ValidateSet("x86", "x64", "arm", "arm64")]
+    [string]$Arch = "x64",
+
+    [Parameter(Mandatory = $false)]
+    [ValidateSet("schannel", "quictls", "openssl")]
+    [string]$Tls = "",
+
+    [Parameter(Mandatory = $false)]
+    [string]$Matrix = (Join-Path $PSScriptRoot "secnetperf-matrix.json"),
+
+    [Parameter(Mandatory = $false)]
+    [string]$Baseline = "",
+
+    [Parameter(Mandatory = $false)]
+    [string]$OutputFile = "",
+
+    [Parameter(Mandatory = $false)]
+    [switch]$UpdateBaseline = $false,
+
+    [Parameter(Mandatory = $false)]
+    [string]$Filter = "*",
+
+    [Parameter(Mandatory = $false)]
+    [Int32]$TimeoutMs = 60000
+)
+
+Set-StrictMode -Version 'Latest'
+$PSDefaultParameterValues['*:ErrorAction'] = 'Stop'
+
+$psVersion = $PSVersionTable.PSVersion
+if ($psVersion.Major -lt 7) {
+    $IsWindows = $true
+}
+
+# Default TLS based on current platform.
+if ("" -eq $Tls) {
+    if ($IsWindows) {
+        $Tls = "schannel"
+    } else {
+        $Tls = "quictls"
+    }
+}
+
+$RootDir = Split-Path $PSScriptRoot -Parent
+$Platform = if ($IsWindows) { "windows" } elseif ($IsLinux) { "linux" } else { "macos" }
+$ArtifactsDir = Join-Path $RootDir "artifacts/bin/$Platform/$($Arch)_$($Config)_$($Tls)"
+$SecNetPerf = Join-Path $ArtifactsDir $(if ($IsWindows) { "secnetperf.exe" } else { "secnetperf" })
+if (!(Test-Path $SecNetPerf)) {
+    Write-Error "Build does not exist!`n `nRun the following to generate it:`n `n    $(Join-Path $RootDir "scripts" "build.ps1") -Config $Config -Arch $Arch -Tls $Tls`n"
+}
+
+if ("" -eq $OutputFile) {
+    $OutputFile = Join-Path $RootDir "artifacts/perf/secnetperf-matrix-$Platform-$Arch-$Tls.json"
+}
+New-Item -ItemType Directory -Force -Path (Split-Path $OutputFile -Parent) | Out-Null
+
+$MatrixJson = Get-Content -Raw -Path $Matrix | ConvertFrom-Json
+$BaselineJson = $null
+if ("" -ne $Baseline -and (Test-Path $Baseline)) {
+    $BaselineJson = Get-Content -Raw -Path $Baseline | ConvertFrom-Json
+}
+
+# Two-sided critical values of Student's t distribution for 95% and 99%
+# confidence, indexed by degrees of freedom (1-30). Larger df use the normal
+# approximation.
+$TTable95 = @(12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+              2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+              2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042)
+$TTable99 = @(63.657, 9.925, 5.841, 4.604, 4.032, 3.707, 3.499, 3.355, 3.250, 3.169,
+              3.106, 3.055, 3.012, 2.977, 2.947, 2.921, 2.898, 2.878, 2.861, 2.845,
+              2.831, 2.819, 2.807, 2.797, 2.787, 2.779, 2.771, 2.763, 2.756, 2.750)
+
+function Get-TCritical {
+    param ([double]$Df)
+    $Index = [Math]::Max(1, [Math]::Floor($Df))
+    if ($MatrixJson.Confidence -ge 0.99) {
+        if ($Index -gt 30) { return 2.576 }
+        return $TTable99[$Index - 1]
+    }
+    if ($Index -gt 30) { return 1.960 }
+    return $TTable95[$Index - 1]
+}
+
+# Returns the mean, sample standard deviation and confidence interval half
+# width of a set of samples.
+function Get-Statistics {
+    param ([double[]]$Samples)
+    $N = $Samples.Length
+    $Mean = ($Samples | Measure-Object -Average).Average
+    $StdDev = 0
+    if ($N -gt 1) {
+        $SumSq = 0
+        foreach ($Sample in $Samples) { $SumSq += ($Sample - $Mean) * ($Sample - $Mean) }
+        $StdDev = [Math]::Sqrt($SumSq / ($N - 1))
+    }
+    $Ci = 0
+    if ($N -gt 1) { $Ci = (Get-TCritical ($N - 1)) * $StdDev / [Math]::Sqrt($N) }
+    return [pscustomobject]@{ Mean = $Mean; StdDev = $StdDev; Ci = $Ci; Count = $N }
+}
+
+# Compares two sets of samples with Welch's t-test. A change is flagged as a
+# regression only if it is statistically significant, in the bad direction and
+# larger than the configured threshold.
+function Compare-Samples {
+    param ([double[]]$Base, [double[]]$Current, [bool]$HigherIsBetter)
+    $B = Get-Statistics $Base
+    $C = Get-Statistics $Current
+    $ChangePercent = 0
+    if ($B.Mean -ne 0) { $ChangePercent = 100 * ($C.Mean - $B.Mean) / $B.Mean }
+    $Significant = $false
+    if ($B.Count -gt 1 -and $C.Count -gt 1) {
+        $VarB = $B.StdDev * $B.StdDev / $B.Count
+        $VarC = $C.StdDev * $C.StdDev / $C.Count
+        $Se = [Math]::Sqrt($VarB + $VarC)
+        if ($Se -eq 0) {
+            $Significant = $C.Mean -ne $B.Mean
+        } else {
+            $T = ($C.Mean - $B.Mean) / $Se
+            $Df = ($VarB + $VarC) * ($VarB + $VarC) /
+                  (($VarB * $VarB) / ($B.Count - 1) + ($VarC * $VarC) / ($C.Count - 1))
+            $Significant = [Math]::Abs($T) -gt (Get-TCritical $Df)
+        }
+    }
+    $Worse = if ($HigherIsBetter) { $ChangePercent -lt 0 } else { $ChangePercent -gt 0 }
+    $Regression = $Significant -and $Worse -and
+        ([Math]::Abs($ChangePercent) -ge $MatrixJson.RegressionThresholdPercent)
+    return [pscustomobject]@{
+        BaselineMean = $B.Mean
+        ChangePercent = [Math]::Round($ChangePercent, 2)
+        Significant = $Significant
+        Regression = $Regression
+    }
+}
+
+# Starts secnetperf directly (not via a shell), so its CPU time can be queried.
+function Start-SecNetPerf {
+    param ([string]$Arguments)
+    $pinfo = New-Object System.Diagnostics.ProcessStartInfo
+    $pinfo.FileName = $SecNetPerf
+    $pinfo.Arguments = $Arguments
+    $pinfo.RedirectStandardOutput = $true
+    $pinfo.RedirectStandardError = $true
+    $pinfo.UseShellExecute = $false
+    if (!$IsWindows) {
+        $pinfo.Environment["LD_LIBRARY_PATH"] = $ArtifactsDir
+    }
+    $p = New-Object System.Diagnostics.Process
+    $p.StartInfo = $pinfo
+    $p.Start() | Out-Null
+    $p
+}
+
+# Returns the process's CPU time in microseconds, or the last known value if
+# it has already exited (on Linux, exited processes can't be queried).
+function Get-CpuUs {
+    param ($Process, [double]$Last)
+    try { return $Process.TotalProcessorTime.TotalMilliseconds * 1000 } catch { return $Last }
+}
+
+# Runs a single client against the given server and returns the parsed results.
+function Invoke-TestRun {
+    param ($Server, [string]$ClientArgs, [string]$Metric)
+
+    $ServerCpuStart = Get-CpuUs $Server 0
+    $Client = Start-SecNetPerf $ClientArgs
+    $StdOut = $Client.StandardOutput.ReadToEndAsync()
+    $StdErr = $Client.StandardError.ReadToEndAsync()
+    $ClientCpu = 0
+    $Stopwatch = [System.Diagnostics.Stopwatch]::StartNew()
+    while (!$Client.WaitForExit(100)) {
+        $ClientCpu = Get-CpuUs $Client $ClientCpu
+        if ($Stopwatch.ElapsedMilliseconds -gt $TimeoutMs) {
+            try { $Client.Kill() } catch { }
+            throw "Client timed out!"
+        }
+    }
+    $ClientCpu = Get-CpuUs $Client $ClientCpu
+    $ServerCpu = (Get-CpuUs $Server 0) - $ServerCpuStart
+    [System.Threading.Tasks.Task]::WaitAll(@($StdOut, $StdErr))
+    $Output = $StdOut.Result
+    if ($Client.ExitCode -ne 0 -or !($Output -match "Result: ")) {
+        throw "Client failed ($($Client.ExitCode)): $Output $($StdErr.Result)"
+    }
+
+    $Result = [ordered]@{ Value = 0; CpuUsPerUnit = 0; Latency = $null }
+    $Units = 0
+    if ($Metric -eq "throughput") {
+        # Requires -ptput:1 for the aggregate rate and -pctput:1 for the bytes.
+        $Output -match "Result: (?:Upload|Download) (\d+) kbps" | Out-Null
+        $Result.Value = [double]$matches[1]
+        $Bytes = 0
+        foreach ($m in [regex]::Matches($Output, "Result: \w+ (\d+) bytes")) {
+            $Bytes += [double]$m.Groups[1].Value
+        }
+        $Units = $Bytes / 1MB # CPU per MB transferred
+    } elseif ($Metric -eq "hps") {
+        $Output -match "(\d+) HPS" | Out-Null
+        $Result.Value = [double]$matches[1]
+        $Units = $Result.Value # CPU per handshake (per second of runtime)
+    } else {
+        $Output -match "Result: (\d+) RPS" | Out-Null
+        $Result.Value = [double]$matches[1]
+        $Units = $Result.Value # CPU per request (per second of runtime)
+        $Latency = [ordered]@{}
+        foreach ($m in [regex]::Matches($Output, "([\d\.]+th|Max): (\d+)")) {
+            $Latency[$m.Groups[1].Value] = [double]$m.Groups[2].Value
+        }
+        $Result.Latency = $Latency
+    }
+    if ($Units -gt 0) {
+        $Result.CpuUsPerUnit = [Math]::Round(($ClientCpu + $ServerCpu) / $Units, 2)
+    }
+    return $Result
+}
+
+$Results = [ordered]@{}
+$Results["commit"] = (git -C $RootDir rev-parse HEAD 2>$null)
+$Results["platform"] = "$Platform-$Arch-$Tls"
+$Results["cases"] = [ordered]@{}
+$HasRegressions = $false
+
+foreach ($Cc in $MatrixJson.CongestionControl) {
+foreach ($Io in $MatrixJson.Io) {
+foreach ($Emulation in $MatrixJson.Emulation) {
+
+    $Cases = @($MatrixJson.Scenarios | Where-Object { "$Cc-$Io-$($Emulation.Name)-$($_.Name)" -like $Filter })
+    if ($Cases.Length -eq 0) { continue }
+    if ($Emulation.Args -ne "" -and $Io -ne "epoll" -and $Io -ne "iocp" -and $Io -ne "kqueue") {
+        Write-Host "Skipping $Cc-$Io-$($Emulation.Name): emulation requires the socket datapath."
+        continue
+    }
+
+    $CommonArgs = "-io:$Io -cc:$Cc $($Emulation.Args)"
+    Write-Host "Starting server: $CommonArgs"
+    $Server = Start-SecNetPerf $CommonArgs
+    # Drain the server's output so it never blocks on a full pipe.
+    $Server.StandardOutput.ReadToEndAsync() | Out-Null
+    $Server.StandardError.ReadToEndAsync() | Out-Null
+    Start-Sleep -Seconds 1
+    if ($Server.HasExited) {
+        Write-Host "Server failed to start for $Cc-$Io-$($Emulation.Name); skipping."
+        continue
+    }
+
+    try {
+        foreach ($Scenario in $Cases) {
+            $Name = "$Cc-$Io-$($Emulation.Name)-$($Scenario.Name)"
+            $ClientArgs = "-target:localhost $CommonArgs $($Scenario.Args)"
+            $Samples = @()
+            $Cpu = @()
+            $Latency = @()
+            try {
+                for ($i = 0; $i -lt $MatrixJson.Repetitions; $i++) {
+                    $Run = Invoke-TestRun $Server $ClientArgs $Scenario.Metric
+                    $Samples += $Run.Value
+                    $Cpu += $Run.CpuUsPerUnit
+                    if ($null -ne $Run.Latency) { $Latency += $Run.Latency }
+                }
+            } catch {
+                Write-Host "$($Name): failed: $_"
+                $Results.cases[$Name] = [ordered]@{ metric = $Scenario.Metric; error = "$_" }
+                continue
+            }
+
+            $Stats = Get-Statistics $Samples
+            $Case = [ordered]@{
+                metric = $Scenario.Metric
+                samples = $Samples
+                mean = [Math]::Round($Stats.Mean, 2)
+                stddev = [Math]::Round($Stats.StdDev, 2)
+                ci = [Math]::Round($Stats.Ci, 2)
+                cpu_us_per_unit = [Math]::Round(($Cpu | Measure-Object -Average).Average, 2)
+            }
+            if ($Latency.Length -gt 0) {
+                $Case["latency"] = $Latency
+            }
+
+            $Line = "$($Name): $($Case.mean) +/- $($Case.ci) ($($Scenario.Metric)), $($Case.cpu_us_per_unit) cpu us/unit"
+            if ($null -ne $BaselineJson -and
+                $null -ne $BaselineJson.cases.PSObject.Properties[$Name] -and
+                $null -ne $BaselineJson.cases.$Name.PSObject.Properties["samples"]) {
+                # Throughput, HPS and RPS are all higher-is-better.
+                $Comparison = Compare-Samples $BaselineJson.cases.$Name.samples $Samples $true
+                $Case["comparison"] = $Comparison
+                $Line += ", $($Comparison.ChangePercent)% vs baseline"
+                if ($Comparison.Regression) {
+                    $HasRegressions = $true
+                    $Line += " REGRESSION"
+                } elseif ($Comparison.Significant) {
+                    $Line += " (significant)"
+                }
+            }
+            Write-Host $Line
+            $Results.cases[$Name] = $Case
+        }
+    } finally {
+        try { $Server.Kill() } catch { }
+        $Server.WaitForExit() | Out-Null
+    }
+}}}
+
+Write-Host "Writing $OutputFile"
+$Results | ConvertTo-Json -Depth 6 | Set-Content -Path $OutputFile
+if ($UpdateBaseline -and "" -ne $Baseline) {
+    Write-Host "Updating baseline $Baseline"
+    $Results | ConvertTo-Json -Depth 6 | Set-Content -Path $Baseline
+}
+
+if ($HasRegressions) {
+    Write-Host "Regressions detected!"
+    exit 1
+}
@@ -30,6 +30,11 @@ Abstract:
     (Handle) != NULL && (Handle)->Type == QUIC_HANDLE_TYPE_STREAM \
 )
 
+#define IS_CONTENT_HANDLE(Handle) \
+( \
+    (Handle) != NULL && (Handle)->Type == QUIC_HANDLE_TYPE_CONTENT \
+)
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 QUIC_API
@@ -1018,95 +1023,25 @@ Error:
     return Status;
 }
 
+//
+// Queues a fully initialized stream send request to be processed on the
+// connection's worker, or inline if possible.
+//
 _IRQL_requires_max_(DISPATCH_LEVEL)
+static
 QUIC_STATUS
-QUIC_API
-MsQuicStreamSend(
-    _In_ _Pre_defensive_ HQUIC Handle,
-    _In_reads_(BufferCount) _Pre_defensive_
-        const QUIC_BUFFER * const Buffers,
-    _In_ uint32_t BufferCount,
-    _In_ QUIC_SEND_FLAGS Flags,
-    _In_opt_ void* ClientSendContext
+QuicStreamQueueSendRequest(
+    _In_ QUIC_STREAM* Stream,
+    _In_ __drv_aliasesMem QUIC_SEND_REQUEST* SendRequest
     )
 {
     QUIC_STATUS Status;
-    QUIC_STREAM* Stream;
-    QUIC_CONNECTION* Connection;
-    uint64_t TotalLength;
-    QUIC_SEND_REQUEST* SendRequest;
+    QUIC_CONNECTION* Connection = Stream->Connection;
     BOOLEAN QueueOper = TRUE;
-    const BOOLEAN IsPriority = !!(Flags & QUIC_SEND_FLAG_PRIORITY_WORK);
+    const BOOLEAN IsPriority = !!(SendRequest->Flags & QUIC_SEND_FLAG_PRIORITY_WORK);
     BOOLEAN SendInline;
     QUIC_OPERATION* Oper;
 
-    QuicTraceEvent(
-        ApiEnter,
-        "[ api] Enter %u (%p).",
-        QUIC_TRACE_API_STREAM_SEND,
-        Handle);
-
-    if (!IS_STREAM_HANDLE(Handle) ||
-        (Buffers == NULL && BufferCount != 0)) {
-        Status = QUIC_STATUS_INVALID_PARAMETER;
-        goto Exit;
-    }
-
-#pragma prefast(suppress: __WARNING_25024, "Pointer cast already validated.")
-    Stream = (QUIC_STREAM*)Handle;
-
-    CXPLAT_TEL_ASSERT(!Stream->Flags.HandleClosed);
-    CXPLAT_TEL_ASSERT(!Stream->Flags.Freed);
-
-    Connection = Stream->Connection;
-
-    if (Connection->State.ClosedRemotely) {
-        Status = QUIC_STATUS_ABORTED;
-        goto Exit;
-    }
-
-    TotalLength = 0;
-    for (uint32_t i = 0; i < BufferCount; ++i) {
-        TotalLength += Buffers[i].Length;
-    }
-
-    if (TotalLength > UINT32_MAX) {
-        QuicTraceEvent(
-            StreamError,
-            "[strm][%p] ERROR, %s.",
-            Stream,
-            "Send request total length exceeds max");
-        Status = QUIC_STATUS_INVALID_PARAMETER;
-        goto Exit;
-    }
-
-#pragma prefast(suppress: __WARNING_6014, "Memory is correctly freed (QuicStreamCompleteSendRequest).")
-    SendRequest = CxPlatPoolAlloc(&Connection->Partition->SendRequestPool);
-    if (SendRequest == NULL) {
-        Status = QUIC_STATUS_OUT_OF_MEMORY;
-        QuicTraceEvent(
-            AllocFailure,
-            "Allocation of '%s' failed. (%llu bytes)",
-            "Stream Send request",
-            0);
-        goto Exit;
-    }
-
-    QuicTraceEvent(
-        StreamAppSend,
-        "[strm][%p] App queuing send [%llu bytes, %u buffers, 0x%x flags]",
-        Stream,
-        TotalLength,
-        BufferCount,
-        Flags);
-
-    SendRequest->Next = NULL;
-    SendRequest->Buffers = Buffers;
-    SendRequest->BufferCount = BufferCount;
-    SendRequest->Flags = Flags & ~QUIC_SEND_FLAGS_INTERNAL;
-    SendRequest->TotalLength = TotalLength;
-    SendRequest->ClientContext = ClientSendContext;
-
 #pragma warning(push)
 #pragma warning(disable:6240) // CXPLAT_AT_DISPATCH only really does anything for kernel mode
     SendInline =
@@ -1115,19 +1050,14 @@ MsQuicStreamSend(
         Connection->WorkerThreadID == CxPlatCurThreadID();
 #pragma warning(pop)
 
-    CxPlatDispatchLockAcquire(&Stream->ApiSendRequestLock);
-    if (!Stream->Flags.SendEnabled) {
+    BOOLEAN WasEmpty;
+    if (!QuicStreamApiSendPush(Stream, SendRequest, &WasEmpty)) {
         Status =
             (Connection->State.ClosedRemotely || Stream->Flags.ReceivedStopSending) ?
                 QUIC_STATUS_ABORTED :
                 QUIC_STATUS_INVALID_STATE;
     } else {
-        QUIC_SEND_REQUEST** ApiSendRequestsTail = &Stream->ApiSendRequests;
-        while (*ApiSendRequestsTail != NULL) {
-            ApiSendRequestsTail = &((*ApiSendRequestsTail)->Next);
-            QueueOper = FALSE; // Not necessary if the previous send hasn't been flushed yet.
-        }
-        *ApiSendRequestsTail = SendRequest;
+        QueueOper = WasEmpty; // Not necessary if the previous send hasn't been flushed yet.
         Status = QUIC_STATUS_SUCCESS;
 
         if (!SendInline && QueueOper) {
@@ -1139,9 +1069,11 @@ MsQuicStreamSend(
             QuicStreamAddRef(Stream, QUIC_STREAM_REF_OPERATION);
         }
     }
-    CxPlatDispatchLockRelease(&Stream->ApiSendRequestLock);
 
     if (QUIC_FAILED(Status)) {
+        if (SendRequest->Content != NULL) {
+            QuicContentRelease(SendRequest->Content);
+        }
         CxPlatPoolFree(SendRequest);
         goto Exit;
     }
@@ -1216,6 +1148,284 @@ MsQuicStreamSend(
         }
     }
 
+Exit:
+
+    return Status;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QUIC_API
+MsQuicStreamSend(
+    _In_ _Pre_defensive_ HQUIC Handle,
+    _In_reads_(BufferCount) _Pre_defensive_
+        const QUIC_BUFFER * const Buffers,
+    _In_ uint32_t BufferCount,
+    _In_ QUIC_SEND_FLAGS Flags,
+    _In_opt_ void* ClientSendContext
+    )
+{
+    QUIC_STATUS Status;
+    QUIC_STREAM* Stream;
+    QUIC_CONNECTION* Connection;
+    uint64_t TotalLength;
+    QUIC_SEND_REQUEST* SendRequest;
+
+    QuicTraceEvent(
+        ApiEnter,
+        "[ api] Enter %u (%p).",
+        QUIC_TRACE_API_STREAM_SEND,
+        Handle);
+
+    if (!IS_STREAM_HANDLE(Handle) ||
+        (Buffers == NULL && BufferCount != 0)) {
+        Status = QUIC_STATUS_INVALID_PARAMETER;
+        goto Exit;
+    }
+
+#pragma prefast(suppress: __WARNING_25024, "Pointer cast already validated.")
+    Stream = (QUIC_STREAM*)Handle;
+
+    CXPLAT_TEL_ASSERT(!Stream->Flags.HandleClosed);
+    CXPLAT_TEL_ASSERT(!Stream->Flags.Freed);
+
+    Connection = Stream->Connection;
+
+    if (Connection->State.ClosedRemotely) {
+        Status = QUIC_STATUS_ABORTED;
+        goto Exit;
+    }
+
+    TotalLength = 0;
+    for (uint32_t i = 0; i < BufferCount; ++i) {
+        TotalLength += Buffers[i].Length;
+    }
+
+    if (TotalLength > UINT32_MAX) {
+        QuicTraceEvent(
+            StreamError,
+            "[strm][%p] ERROR, %s.",
+            Stream,
+            "Send request total length exceeds max");
+        Status = QUIC_STATUS_INVALID_PARAMETER;
+        goto Exit;
+    }
+
+#pragma prefast(suppress: __WARNING_6014, "Memory is correctly freed (QuicStreamCompleteSendRequest).")
+    SendRequest = CxPlatPoolAlloc(&Connection->Partition->SendRequestPool);
+    if (SendRequest == NULL) {
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "Stream Send request",
+            0);
+        goto Exit;
+    }
+
+    QuicTraceEvent(
+        StreamAppSend,
+        "[strm][%p] App queuing send [%llu bytes, %u buffers, 0x%x flags]",
+        Stream,
+        TotalLength,
+        BufferCount,
+        Flags);
+
+    SendRequest->Next = NULL;
+    SendRequest->Buffers = Buffers;
+    SendRequest->BufferCount = BufferCount;
+    SendRequest->Flags = Flags & ~QUIC_SEND_FLAGS_INTERNAL;
+    SendRequest->TotalLength = TotalLength;
+    SendRequest->ClientContext = ClientSendContext;
+    SendRequest->Content = NULL;
+
+    Status = QuicStreamQueueSendRequest(Stream, SendRequest);
+
+Exit:
+
+    QuicTraceEvent(
+        ApiExitStatus,
+        "[ api] Exit %u",
+        Status);
+
+    return Status;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QUIC_API
+MsQuicContentOpen(
+    _In_ _Pre_defensive_ const QUIC_BUFFER* const Buffer,
+    _In_opt_ QUIC_CONTENT_RELEASE_CALLBACK_HANDLER Handler,
+    _In_opt_ void* Context,
+    _Outptr_ _At_(*NewContent, __drv_allocatesMem(Mem)) _Pre_defensive_
+        HQUIC* NewContent
+    )
+{
+    QUIC_STATUS Status;
+    QUIC_CONTENT* Content;
+
+    QuicTraceEvent(
+        ApiEnter,
+        "[ api] Enter %u (%p).",
+        QUIC_TRACE_API_CONTENT_OPEN,
+        NULL);
+
+    if (Buffer == NULL ||
+        (Buffer->Buffer == NULL && Buffer->Length != 0) ||
+        NewContent == NULL) {
+        Status = QUIC_STATUS_INVALID_PARAMETER;
+        goto Error;
+    }
+
+    Content = CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_CONTENT), QUIC_POOL_CONTENT);
+    if (Content == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "content",
+            sizeof(QUIC_CONTENT));
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        goto Error;
+    }
+
+    Content->Type = QUIC_HANDLE_TYPE_CONTENT;
+    Content->ClientContext = Context;
+    CxPlatRefInitialize(&Content->RefCount);
+    Content->Buffer = *Buffer;
+    Content->ReleaseHandler = Handler;
+    Content->ReleaseContext = Context;
+
+    *NewContent = (HQUIC)Content;
+    Status = QUIC_STATUS_SUCCESS;
+
+Error:
+
+    QuicTraceEvent(
+        ApiExitStatus,
+        "[ api] Exit %u",
+        Status);
+
+    return Status;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QUIC_API
+MsQuicContentClose(
+    _In_ _Pre_defensive_ __drv_freesMem(Mem)
+        HQUIC Handle
+    )
+{
+    QuicTraceEvent(
+        ApiEnter,
+        "[ api] Enter %u (%p).",
+        QUIC_TRACE_API_CONTENT_CLOSE,
+        Handle);
+
+    if (IS_CONTENT_HANDLE(Handle)) {
+#pragma prefast(suppress: __WARNING_25024, "Pointer cast already validated.")
+        QuicContentRelease((QUIC_CONTENT*)Handle);
+    }
+
+    QuicTraceEvent(
+        ApiExit,
+        "[ api] Exit");
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QUIC_API
+MsQuicStreamSendContent(
+    _In_ _Pre_defensive_ HQUIC Handle,
+    _In_ _Pre_defensive_ HQUIC ContentHandle,
+    _In_ uint64_t Offset,
+    _In_ uint32_t Length,
+    _In_ QUIC_SEND_FLAGS Flags,
+    _In_opt_ void* ClientSendContext
+    )
+{
+    QUIC_STATUS Status;
+    QUIC_STREAM* Stream;
+    QUIC_CONTENT* Content;
+    QUIC_CONNECTION* Connection;
+    QUIC_SEND_REQUEST* SendRequest;
+
+    QuicTraceEvent(
+        ApiEnter,
+        "[ api] Enter %u (%p).",
+        QUIC_TRACE_API_STREAM_SEND_CONTENT,
+        Handle);
+
+    if (!IS_STREAM_HANDLE(Handle) ||
+        !IS_CONTENT_HANDLE(ContentHandle)) {
+        Status = QUIC_STATUS_INVALID_PARAMETER;
+        goto Exit;
+    }
+
+#pragma prefast(suppress: __WARNING_25024, "Pointer cast already validated.")
+    Stream = (QUIC_STREAM*)Handle;
+#pragma prefast(suppress: __WARNING_25024, "Pointer cast already validated.")
+    Content = (QUIC_CONTENT*)ContentHandle;
+
+    CXPLAT_TEL_ASSERT(!Stream->Flags.HandleClosed);
+    CXPLAT_TEL_ASSERT(!Stream->Flags.Freed);
+
+    if (Offset > Content->Buffer.Length ||
+        Length > Content->Buffer.Length - Offset) {
+        QuicTraceEvent(
+            StreamError,
+            "[strm][%p] ERROR, %s.",
+            Stream,
+            "Send content range out of bounds");
+        Status = QUIC_STATUS_INVALID_PARAMETER;
+        goto Exit;
+    }
+
+    Connection = Stream->Connection;
+
+    if (Connection->State.ClosedRemotely) {
+        Status = QUIC_STATUS_ABORTED;
+        goto Exit;
+    }
+
+#pragma prefast(suppress: __WARNING_6014, "Memory is correctly freed (QuicStreamCompleteSendRequest).")
+    SendRequest = CxPlatPoolAlloc(&Connection->Partition->SendRequestPool);
+    if (SendRequest == NULL) {
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "Stream Send request",
+            0);
+        goto Exit;
+    }
+
+    QuicTraceEvent(
+        StreamAppSend,
+        "[strm][%p] App queuing send [%llu bytes, %u buffers, 0x%x flags]",
+        Stream,
+        (uint64_t)Length,
+        1,
+        Flags);
+
+    //
+    // The request describes the range in place, so neither this call nor the
+    // send buffer ever copies the content.
+    //
+    CxPlatRefIncrement(&Content->RefCount);
+    SendRequest->Next = NULL;
+    SendRequest->InternalBuffer.Buffer = Content->Buffer.Buffer + Offset;
+    SendRequest->InternalBuffer.Length = Length;
+    SendRequest->Buffers = &SendRequest->InternalBuffer;
+    SendRequest->BufferCount = 1;
+    SendRequest->Flags = Flags & ~QUIC_SEND_FLAGS_INTERNAL;
+    SendRequest->TotalLength = Length;
+    SendRequest->ClientContext = ClientSendContext;
+    SendRequest->Content = Content;
+
+    Status = QuicStreamQueueSendRequest(Stream, SendRequest);
+
 Exit:
 
     QuicTraceEvent(
@@ -1861,6 +2071,9 @@ MsQuicDatagramSend(
     SendRequest->Flags = Flags;
     SendRequest->TotalLength = TotalLength;
     SendRequest->ClientContext = ClientSendContext;
+    SendRequest->DatagramDeadline = 0;
+    SendRequest->DatagramBatch = NULL;
+    SendRequest->DatagramPriority = QUIC_DATAGRAM_PRIORITY_DEFAULT;
 
     Status = QuicDatagramQueueSend(&Connection->Datagram, SendRequest);
 
@@ -1874,6 +2087,112 @@ Error:
     return Status;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QUIC_API
+MsQuicDatagramSendBatch(
+    _In_ _Pre_defensive_ HQUIC Handle,
+    _In_reads_(ItemCount) _Pre_defensive_
+        const QUIC_DATAGRAM_SEND_ITEM* const Items,
+    _In_ uint32_t ItemCount,
+    _In_ QUIC_SEND_FLAGS Flags
+    )
+{
+    QUIC_STATUS Status;
+    QUIC_CONNECTION* Connection;
+    QUIC_DATAGRAM_SEND_BATCH* Batch;
+    QUIC_SEND_REQUEST* Requests;
+    QUIC_BUFFER* Buffers;
+    uint64_t TimeNow;
+
+    QuicTraceEvent(
+        ApiEnter,
+        "[ api] Enter %u (%p).",
+        QUIC_TRACE_API_DATAGRAM_SEND_BATCH,
+        Handle);
+
+    if (!IS_CONN_HANDLE(Handle) ||
+        Items == NULL ||
+        ItemCount == 0 ||
+        ItemCount > UINT16_MAX) {
+        Status = QUIC_STATUS_INVALID_PARAMETER;
+        goto Error;
+    }
+
+#pragma prefast(suppress: __WARNING_25024, "Pointer cast already validated.")
+    Connection = (QUIC_CONNECTION*)Handle;
+
+    CXPLAT_TEL_ASSERT(!Connection->State.Freed);
+
+    //
+    // Items that are too long aren't rejected here. They are canceled on their
+    // own when the batch is flushed, so the rest of the batch is still sent.
+    //
+    for (uint32_t i = 0; i < ItemCount; ++i) {
+        if (Items[i].Buffer.Length != 0 && Items[i].Buffer.Buffer == NULL) {
+            QuicTraceEvent(
+                ConnError,
+                "[conn][%p] ERROR, %s.",
+                Connection,
+                "Datagram send item has a NULL buffer");
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            goto Error;
+        }
+    }
+
+    //
+    // All the send requests (and the buffer descriptors they point to) for the
+    // batch come from a single allocation, which is freed when the last of them
+    // has been completed or canceled.
+    //
+    Batch =
+        CXPLAT_ALLOC_NONPAGED(
+            sizeof(QUIC_DATAGRAM_SEND_BATCH) +
+            ItemCount * (sizeof(QUIC_SEND_REQUEST) + sizeof(QUIC_BUFFER)),
+            QUIC_POOL_DATAGRAM_BATCH);
+    if (Batch == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "Datagram send batch",
+            sizeof(QUIC_DATAGRAM_SEND_BATCH) +
+                ItemCount * (sizeof(QUIC_SEND_REQUEST) + sizeof(QUIC_BUFFER)));
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        goto Error;
+    }
+
+    CxPlatRefInitializeEx(&Batch->RefCount, ItemCount);
+    Requests = (QUIC_SEND_REQUEST*)(Batch + 1);
+    Buffers = (QUIC_BUFFER*)(Requests + ItemCount);
+    TimeNow = CxPlatTimeUs64();
+
+    for (uint32_t i = 0; i < ItemCount; ++i) {
+        QUIC_SEND_REQUEST* SendRequest = &Requests[i];
+        Buffers[i] = Items[i].Buffer;
+        SendRequest->Next = (i + 1 < ItemCount) ? &Requests[i + 1] : NULL;
+        SendRequest->Buffers = &Buffers[i];
+        SendRequest->BufferCount = 1;
+        SendRequest->Flags = Flags;
+        SendRequest->TotalLength = Items[i].Buffer.Length;
+        SendRequest->ClientContext = Items[i].ClientContext;
+        SendRequest->DatagramDeadline =
+            Items[i].DeadlineUs == 0 ? 0 : TimeNow + Items[i].DeadlineUs;
+        SendRequest->DatagramBatch = Batch;
+        SendRequest->DatagramPriority = Items[i].Priority;
+    }
+
+    Status = QuicDatagramQueueSend(&Connection->Datagram, Requests);
+
+Error:
+
+    QuicTraceEvent(
+        ApiExitStatus,
+        "[ api] Exit %u",
+        Status);
+
+    return Status;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 QUIC_API
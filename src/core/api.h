@@ -270,6 +270,37 @@ MsQuicStreamProvideReceiveBuffers(
     _In_reads_(BufferCount) const QUIC_BUFFER *Buffers
     );
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QUIC_API
+MsQuicContentOpen(
+    _In_ _Pre_defensive_ const QUIC_BUFFER* const Buffer,
+    _In_opt_ QUIC_CONTENT_RELEASE_CALLBACK_HANDLER Handler,
+    _In_opt_ void* Context,
+    _Outptr_ _At_(*NewContent, __drv_allocatesMem(Mem)) _Pre_defensive_
+        HQUIC* NewContent
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QUIC_API
+MsQuicContentClose(
+    _In_ _Pre_defensive_ __drv_freesMem(Mem)
+        HQUIC Handle
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QUIC_API
+MsQuicStreamSendContent(
+    _In_ _Pre_defensive_ HQUIC Handle,
+    _In_ _Pre_defensive_ HQUIC ContentHandle,
+    _In_ uint64_t Offset,
+    _In_ uint32_t Length,
+    _In_ QUIC_SEND_FLAGS Flags,
+    _In_opt_ void* ClientSendContext
+    );
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 QUIC_API
@@ -316,6 +347,17 @@ MsQuicDatagramSend(
     _In_opt_ void* ClientSendContext
     );
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QUIC_API
+MsQuicDatagramSendBatch(
+    _In_ _Pre_defensive_ HQUIC Handle,
+    _In_reads_(ItemCount) _Pre_defensive_
+        const QUIC_DATAGRAM_SEND_ITEM* const Items,
+    _In_ uint32_t ItemCount,
+    _In_ QUIC_SEND_FLAGS Flags
+    );
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 QUIC_API
@@ -599,6 +599,29 @@ QuicBindingMoveSourceConnectionIDs(
         &BindingSrc->Lookup, &BindingDest->Lookup, Connection);
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicBindingAttachPathConnection(
+    _In_ QUIC_BINDING* Binding,
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    if (!Binding->Exclusive) {
+        return FALSE;
+    }
+    return QuicLookupAttachConnection(&Binding->Lookup, Connection);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicBindingDetachPathConnection(
+    _In_ QUIC_BINDING* Binding,
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    QuicLookupDetachConnection(&Binding->Lookup, Connection);
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 QuicBindingOnConnectionHandshakeConfirmed(
@@ -1560,6 +1583,11 @@ QuicBindingDeliverPackets(
 
         CXPLAT_DBG_ASSERT(Binding->ServerOwned);
 
+        if (QuicLibraryGetMemoryPressure() >= QUIC_MEMORY_PRESSURE_REJECT_HANDSHAKES) {
+            QuicPacketLogDrop(Binding, Packets, "Buffer memory limit reached");
+            return FALSE;
+        }
+
         BOOLEAN DropPacket = FALSE;
         if (QuicBindingShouldRetryConnection(
                 Binding, Packets, TokenLength, Token, &DropPacket)) {
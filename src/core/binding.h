@@ -409,6 +409,28 @@ QuicBindingMoveSourceConnectionIDs(
     _In_ QUIC_CONNECTION* Connection
     );
 
+//
+// Attaches the connection to an exclusive binding used for one of its
+// additional paths, so that all the connection's source CIDs are delivered
+// to it. Fails if the binding is shared or already in use.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicBindingAttachPathConnection(
+    _In_ QUIC_BINDING* Binding,
+    _In_ QUIC_CONNECTION* Connection
+    );
+
+//
+// Detaches the connection from an additional path's binding.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicBindingDetachPathConnection(
+    _In_ QUIC_BINDING* Binding,
+    _In_ QUIC_CONNECTION* Connection
+    );
+
 //
 // Indicates to the binding that the connection is no longer accepting
 // handshake/long header packets.
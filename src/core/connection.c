@@ -83,6 +83,7 @@ QuicConnAlloc(
 
     CxPlatZeroMemory(Connection, sizeof(QUIC_CONNECTION));
     Connection->Partition = Partition;
+    QuicConnUpdateMemoryUsage(Connection, sizeof(QUIC_CONNECTION));
 
 #if DEBUG
     InterlockedIncrement(&MsQuicLib.ConnectionCount);
@@ -362,6 +363,7 @@ QuicConnFree(
         CxPlatRecvDataReturn((CXPLAT_RECV_DATA*)Connection->ReceiveQueue);
         Connection->ReceiveQueue = NULL;
     }
+    QuicConnReleasePathBindings(Connection, FALSE);
     QUIC_PATH* Path = &Connection->Paths[0];
     if (Path->Binding != NULL) {
         QuicLibraryReleaseBinding(Path->Binding);
@@ -411,6 +413,7 @@ QuicConnFree(
     if (Connection->CloseReasonPhrase != NULL) {
         CXPLAT_FREE(Connection->CloseReasonPhrase, QUIC_POOL_CLOSE_REASON);
     }
+    QuicConnUpdateMemoryUsage(Connection, -(int64_t)sizeof(QUIC_CONNECTION));
     Connection->State.Freed = TRUE;
     QuicTraceEvent(
         ConnDestroyed,
@@ -494,6 +497,9 @@ QuicConnUnregister(
         CxPlatDispatchLockAcquire(&Connection->Registration->ConnectionLock);
         CxPlatListEntryRemove(&Connection->RegistrationLink);
         CxPlatDispatchLockRelease(&Connection->Registration->ConnectionLock);
+        InterlockedExchangeAdd64(
+            &Connection->Registration->MemoryUsage[Connection->Partition->Index].Bytes,
+            -Connection->MemoryUsage);
         CxPlatRundownRelease(&Connection->Registration->Rundown);
 
         QuicTraceEvent(
@@ -521,6 +527,9 @@ QuicConnRegister(
     }
     Connection->State.Registered = TRUE;
     Connection->Registration = Registration;
+    InterlockedExchangeAdd64(
+        &Registration->MemoryUsage[Connection->Partition->Index].Bytes,
+        Connection->MemoryUsage);
 #ifdef CxPlatVerifierEnabledByAddr
     Connection->State.IsVerifying = Registration->IsVerifying;
 #endif
@@ -537,6 +546,9 @@ QuicConnRegister(
     CxPlatDispatchLockRelease(&Registration->ConnectionLock);
 
     if (RegistrationShuttingDown) {
+        InterlockedExchangeAdd64(
+            &Registration->MemoryUsage[Connection->Partition->Index].Bytes,
+            -Connection->MemoryUsage);
         Connection->State.Registered = FALSE;
         Connection->Registration = NULL;
         CxPlatRundownRelease(&Registration->Rundown);
@@ -1395,6 +1407,7 @@ QuicConnOnShutdownComplete(
         // more packets queued.
         //
         QuicBindingRemoveConnection(Connection->Paths[0].Binding, Connection);
+        QuicConnReleasePathBindings(Connection, TRUE);
     }
 
     //
@@ -1405,6 +1418,13 @@ QuicConnOnShutdownComplete(
     QuicSendUninitialize(&Connection->Send);
     QuicDatagramSendShutdown(&Connection->Datagram);
 
+    if (Connection->PoolTracker != NULL) {
+        //
+        // The connection shut down before its handshake completed.
+        //
+        QuicConnPoolOnHandshakeComplete(Connection);
+    }
+
     if (Connection->State.ExternalOwner) {
 
         QUIC_CONNECTION_EVENT Event;
@@ -4140,123 +4160,177 @@ QuicConnRecvPrepareDecrypt(
 }
 
 //
-// Decrypts the packet's payload and authenticates the whole packet. On
-// successful authentication of the packet, does some final processing of the
-// packet header (key and CID updates). Returns TRUE if the packet should
-// continue to be processed further.
+// Per-packet state carried from the payload decryption stage to the
+// authentication stage of the receive path.
+//
+typedef struct QUIC_RX_DECRYPT_STATE {
+
+    //
+    // Indicates decryption of the payload has already been attempted and
+    // Status holds the result.
+    //
+    BOOLEAN Decrypted : 1;
+    BOOLEAN CanCheckForStatelessReset : 1;
+    QUIC_STATUS Status;
+
+    //
+    // Copy of the end of the packet, taken before decryption, as a failed
+    // decryption trashes the stateless reset token.
+    //
+    uint8_t ResetToken[QUIC_STATELESS_RESET_TOKEN_LENGTH];
+
+} QUIC_RX_DECRYPT_STATE;
+
+//
+// Decrypts the payloads of a batch of packets that have all already been
+// prepared for decryption (header protection removed and packet number
+// decoded) and that all use the same key. The results are stored in the
+// per-packet decrypt states, to be consumed by
+// QuicConnRecvDecryptAndAuthenticate.
 //
 _IRQL_requires_max_(PASSIVE_LEVEL)
-BOOLEAN
-QuicConnRecvDecryptAndAuthenticate(
+void
+QuicConnRecvDecryptPayloads(
     _In_ QUIC_CONNECTION* Connection,
-    _In_ QUIC_PATH* Path,
-    _In_ QUIC_RX_PACKET* Packet
+    _In_ uint8_t BatchCount,
+    _In_reads_(BatchCount) QUIC_RX_PACKET** Packets,
+    _Out_writes_(BatchCount) QUIC_RX_DECRYPT_STATE* DecryptStates
     )
 {
-    CXPLAT_DBG_ASSERT(Packet->AvailBufferLength >= Packet->HeaderLength + Packet->PayloadLength);
+    CXPLAT_DBG_ASSERT(BatchCount > 0 && BatchCount <= QUIC_MAX_CRYPTO_BATCH_COUNT);
+    const QUIC_PACKET_KEY* ReadKey =
+        Connection->Crypto.TlsState.ReadKeys[Packets[0]->KeyType];
 
-    const uint8_t* Payload = Packet->AvailBuffer + Packet->HeaderLength;
+    for (uint8_t i = 0; i < BatchCount; ++i) {
+        QUIC_RX_PACKET* Packet = Packets[i];
+        QUIC_RX_DECRYPT_STATE* DecryptState = &DecryptStates[i];
+        uint8_t* Payload = (uint8_t*)Packet->AvailBuffer + Packet->HeaderLength;
 
-    //
-    // We need to copy the end of the packet before trying decryption, as a
-    // failed decryption trashes the stateless reset token.
-    //
-    BOOLEAN CanCheckForStatelessReset = FALSE;
-    uint8_t PacketResetToken[QUIC_STATELESS_RESET_TOKEN_LENGTH];
-    if (QuicConnIsClient(Connection) &&
-        Packet->IsShortHeader &&
-        Packet->HeaderLength + Packet->PayloadLength >= QUIC_MIN_STATELESS_RESET_PACKET_LENGTH) {
-        CanCheckForStatelessReset = TRUE;
-        CxPlatCopyMemory(
-            PacketResetToken,
-            Payload + Packet->PayloadLength - QUIC_STATELESS_RESET_TOKEN_LENGTH,
-            QUIC_STATELESS_RESET_TOKEN_LENGTH);
-    }
+        CXPLAT_DBG_ASSERT(Packet->KeyType == Packets[0]->KeyType);
+        CXPLAT_DBG_ASSERT(Packet->AvailBufferLength >= Packet->HeaderLength + Packet->PayloadLength);
+        CXPLAT_DBG_ASSERT(Packet->PacketId != 0);
 
-    CXPLAT_DBG_ASSERT(Packet->PacketId != 0);
+        DecryptState->Decrypted = TRUE;
+        DecryptState->CanCheckForStatelessReset = FALSE;
+        DecryptState->Status = QUIC_STATUS_SUCCESS;
 
-    uint8_t Iv[CXPLAT_MAX_IV_LENGTH];
-    QuicCryptoCombineIvAndPacketNumber(
-        Connection->Crypto.TlsState.ReadKeys[Packet->KeyType]->Iv,
-        (uint8_t*)&Packet->PacketNumber,
-        Iv);
+        if (QuicConnIsClient(Connection) &&
+            Packet->IsShortHeader &&
+            Packet->HeaderLength + Packet->PayloadLength >= QUIC_MIN_STATELESS_RESET_PACKET_LENGTH) {
+            DecryptState->CanCheckForStatelessReset = TRUE;
+            CxPlatCopyMemory(
+                DecryptState->ResetToken,
+                Payload + Packet->PayloadLength - QUIC_STATELESS_RESET_TOKEN_LENGTH,
+                QUIC_STATELESS_RESET_TOKEN_LENGTH);
+        }
+
+        if (!Packet->Encrypted) {
+            continue;
+        }
 
-    //
-    // Decrypt the payload with the appropriate key.
-    //
-    if (Packet->Encrypted) {
         QuicTraceEvent(
             PacketDecrypt,
             "[pack][%llu] Decrypting",
             Packet->PacketId);
-        if (QUIC_FAILED(
+
+        uint8_t Iv[CXPLAT_MAX_IV_LENGTH];
+        QuicCryptoCombineIvAndPacketNumber(
+            ReadKey->Iv,
+            (uint8_t*)&Packet->PacketNumber,
+            Iv);
+
+        DecryptState->Status =
             CxPlatDecrypt(
-                Connection->Crypto.TlsState.ReadKeys[Packet->KeyType]->PacketKey,
+                ReadKey->PacketKey,
                 Iv,
                 Packet->HeaderLength,   // HeaderLength
                 Packet->AvailBuffer,    // Header
                 Packet->PayloadLength,  // BufferLength
-                (uint8_t*)Payload))) {  // Buffer
+                Payload);               // Buffer
+    }
+}
 
-            //
-            // Check for a stateless reset packet.
-            //
-            if (CanCheckForStatelessReset) {
-                for (CXPLAT_LIST_ENTRY* Entry = Connection->DestCids.Flink;
-                        Entry != &Connection->DestCids;
-                        Entry = Entry->Flink) {
-                    //
-                    // Loop through all our stored stateless reset tokens to see if
-                    // we have a match.
-                    //
-                    QUIC_CID_LIST_ENTRY* DestCid =
-                        CXPLAT_CONTAINING_RECORD(
-                            Entry,
-                            QUIC_CID_LIST_ENTRY,
-                            Link);
-                    if (DestCid->CID.HasResetToken &&
-                        !DestCid->CID.Retired &&
-                        memcmp(
-                            DestCid->ResetToken,
-                            PacketResetToken,
-                            QUIC_STATELESS_RESET_TOKEN_LENGTH) == 0) {
-                        QuicTraceLogVerbose(
-                            PacketRxStatelessReset,
-                            "[S][RX][-] SR %s",
-                            QuicCidBufToStr(PacketResetToken, QUIC_STATELESS_RESET_TOKEN_LENGTH).Buffer);
-                        QuicTraceLogConnInfo(
-                            RecvStatelessReset,
-                            Connection,
-                            "Received stateless reset");
-                        QuicConnCloseLocally(
-                            Connection,
-                            QUIC_CLOSE_INTERNAL_SILENT | QUIC_CLOSE_QUIC_STATUS,
-                            (uint64_t)QUIC_STATUS_ABORTED,
-                            NULL);
-                        return FALSE;
-                    }
-                }
-            }
+//
+// Decrypts the packet's payload (if not already done as part of a batch) and
+// authenticates the whole packet. On successful authentication of the packet,
+// does some final processing of the packet header (key and CID updates).
+// Returns TRUE if the packet should continue to be processed further.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicConnRecvDecryptAndAuthenticate(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ QUIC_PATH* Path,
+    _In_ QUIC_RX_PACKET* Packet,
+    _Inout_ QUIC_RX_DECRYPT_STATE* DecryptState
+    )
+{
+    CXPLAT_DBG_ASSERT(Packet->AvailBufferLength >= Packet->HeaderLength + Packet->PayloadLength);
 
-            if (QuicTraceLogVerboseEnabled()) {
-                QuicPacketLogHeader(
-                    Connection,
-                    TRUE,
-                    Connection->State.ShareBinding ? MsQuicLib.CidTotalLength : 0,
-                    Packet->PacketNumber,
-                    Packet->HeaderLength,
-                    Packet->AvailBuffer,
-                    Connection->Stats.QuicVersion);
-            }
-            Connection->Stats.Recv.DecryptionFailures++;
-            QuicPacketLogDrop(Connection, Packet, "Decryption failure");
-            QuicPerfCounterIncrement(Connection->Partition, QUIC_PERF_COUNTER_PKTS_DECRYPTION_FAIL);
-            if (Connection->Stats.Recv.DecryptionFailures >= CXPLAT_AEAD_INTEGRITY_LIMIT) {
-                QuicConnTransportError(Connection, QUIC_ERROR_AEAD_LIMIT_REACHED);
+    if (!DecryptState->Decrypted) {
+        QuicConnRecvDecryptPayloads(Connection, 1, &Packet, DecryptState);
+    }
+
+    if (QUIC_FAILED(DecryptState->Status)) {
+
+        //
+        // Check for a stateless reset packet.
+        //
+        if (DecryptState->CanCheckForStatelessReset) {
+            for (CXPLAT_LIST_ENTRY* Entry = Connection->DestCids.Flink;
+                    Entry != &Connection->DestCids;
+                    Entry = Entry->Flink) {
+                //
+                // Loop through all our stored stateless reset tokens to see if
+                // we have a match.
+                //
+                QUIC_CID_LIST_ENTRY* DestCid =
+                    CXPLAT_CONTAINING_RECORD(
+                        Entry,
+                        QUIC_CID_LIST_ENTRY,
+                        Link);
+                if (DestCid->CID.HasResetToken &&
+                    !DestCid->CID.Retired &&
+                    memcmp(
+                        DestCid->ResetToken,
+                        DecryptState->ResetToken,
+                        QUIC_STATELESS_RESET_TOKEN_LENGTH) == 0) {
+                    QuicTraceLogVerbose(
+                        PacketRxStatelessReset,
+                        "[S][RX][-] SR %s",
+                        QuicCidBufToStr(DecryptState->ResetToken, QUIC_STATELESS_RESET_TOKEN_LENGTH).Buffer);
+                    QuicTraceLogConnInfo(
+                        RecvStatelessReset,
+                        Connection,
+                        "Received stateless reset");
+                    QuicConnCloseLocally(
+                        Connection,
+                        QUIC_CLOSE_INTERNAL_SILENT | QUIC_CLOSE_QUIC_STATUS,
+                        (uint64_t)QUIC_STATUS_ABORTED,
+                        NULL);
+                    return FALSE;
+                }
             }
+        }
 
-            return FALSE;
+        if (QuicTraceLogVerboseEnabled()) {
+            QuicPacketLogHeader(
+                Connection,
+                TRUE,
+                Connection->State.ShareBinding ? MsQuicLib.CidTotalLength : 0,
+                Packet->PacketNumber,
+                Packet->HeaderLength,
+                Packet->AvailBuffer,
+                Connection->Stats.QuicVersion);
+        }
+        Connection->Stats.Recv.DecryptionFailures++;
+        QuicPacketLogDrop(Connection, Packet, "Decryption failure");
+        QuicPerfCounterIncrement(Connection->Partition, QUIC_PERF_COUNTER_PKTS_DECRYPTION_FAIL);
+        if (Connection->Stats.Recv.DecryptionFailures >= CXPLAT_AEAD_INTEGRITY_LIMIT) {
+            QuicConnTransportError(Connection, QUIC_ERROR_AEAD_LIMIT_REACHED);
         }
+
+        return FALSE;
     }
 
     Connection->Stats.Recv.ValidPackets++;
@@ -4563,7 +4637,9 @@ QuicConnRecvFrames(
         case QUIC_FRAME_ACK:
         case QUIC_FRAME_ACK_1: {
             BOOLEAN InvalidAckFrame;
-            if (!QuicLossDetectionProcessAckFrame(
+            QUIC_PROFILE_BEGIN(QUIC_PROFILE_PROCESS_ACK);
+            BOOLEAN AckProcessed =
+                QuicLossDetectionProcessAckFrame(
                     &Connection->LossDetection,
                     Path,
                     Packet,
@@ -4572,7 +4648,9 @@ QuicConnRecvFrames(
                     PayloadLength,
                     Payload,
                     &Offset,
-                    &InvalidAckFrame)) {
+                    &InvalidAckFrame);
+            QUIC_PROFILE_END(Connection->Partition, QUIC_PROFILE_PROCESS_ACK);
+            if (!AckProcessed) {
                 if (InvalidAckFrame) {
                     QuicTraceEvent(
                         ConnError,
@@ -5503,10 +5581,15 @@ QuicConnRecvPostProcessing(
 
     if (Packet->HasNonProbingFrame &&
         Packet->NewLargestPacketNumber &&
-        !(*Path)->IsActive) {
+        !(*Path)->IsActive &&
+        !(*Path)->OwnsBinding &&
+        (Connection->PathSchedulingScheme == QUIC_PATH_SCHEDULING_SCHEME_ACTIVE ||
+         !Connection->Paths[0].IsPeerValidated)) {
         //
         // The peer has sent a non-probing frame on a path other than the active
-        // one. This signals their intent to switch active paths.
+        // one. This signals their intent to switch active paths. When sending
+        // across several paths, the peer is expected to do the same, so only
+        // switch once the active path has stopped validating.
         //
         QuicPathSetActive(Connection, *Path);
         *Path = &Connection->Paths[0];
@@ -5571,14 +5654,70 @@ QuicConnRecvDatagramBatch(
         CxPlatZeroMemory(HpMask, BatchCount * CXPLAT_HP_SAMPLE_LENGTH);
     }
 
+    //
+    // Pipeline the batch: first remove header protection from as many packets
+    // as possible and decrypt all their payloads together, and only then
+    // authenticate and process the frames of each packet in order. Pipelining
+    // stops at the first packet that needs a different key (i.e. a key phase
+    // change), as the new key state only takes effect once that packet has
+    // been authenticated; that packet and all the ones after it are then
+    // decrypted individually as they are processed.
+    //
+    QUIC_RX_DECRYPT_STATE DecryptStates[QUIC_MAX_CRYPTO_BATCH_COUNT];
+    BOOLEAN Prepared[QUIC_MAX_CRYPTO_BATCH_COUNT];
+    uint8_t PipelineCount = 0;
+    uint8_t PreparedCount = 0;
+
+    if (BatchCount > 1) {
+        const QUIC_PACKET_KEY_TYPE KeyType = Packets[0]->KeyType;
+        while (PreparedCount < BatchCount) {
+            Packet = Packets[PreparedCount];
+            CXPLAT_DBG_ASSERT(Packet->Allocated);
+            CXPLAT_DBG_ASSERT(Packet->PacketId != 0);
+            DecryptStates[PreparedCount].Decrypted = FALSE;
+            Prepared[PreparedCount] =
+                QuicConnRecvPrepareDecrypt(
+                    Connection, Packet, HpMask + PreparedCount * CXPLAT_HP_SAMPLE_LENGTH);
+            PreparedCount++;
+            if (Prepared[PreparedCount - 1] && Packet->KeyType != KeyType) {
+                break;
+            }
+        }
+
+        //
+        // Gather the prepared packets still on the batch's key and decrypt
+        // them in one go.
+        //
+        QUIC_RX_PACKET* Pipeline[QUIC_MAX_CRYPTO_BATCH_COUNT];
+        QUIC_RX_DECRYPT_STATE PipelineStates[QUIC_MAX_CRYPTO_BATCH_COUNT];
+        for (uint8_t i = 0; i < PreparedCount; ++i) {
+            if (Prepared[i] && Packets[i]->KeyType == KeyType) {
+                Pipeline[PipelineCount++] = Packets[i];
+            }
+        }
+        if (PipelineCount != 0) {
+            QuicConnRecvDecryptPayloads(Connection, PipelineCount, Pipeline, PipelineStates);
+            for (uint8_t i = 0, j = 0; i < PreparedCount; ++i) {
+                if (Prepared[i] && Packets[i]->KeyType == KeyType) {
+                    DecryptStates[i] = PipelineStates[j++];
+                }
+            }
+        }
+    }
+
     for (uint8_t i = 0; i < BatchCount; ++i) {
         CXPLAT_DBG_ASSERT(Packets[i]->Allocated);
         CXPLAT_ECN_TYPE ECN = CXPLAT_ECN_FROM_TOS(Packets[i]->TypeOfService);
         Packet = Packets[i];
         CXPLAT_DBG_ASSERT(Packet->PacketId != 0);
-        if (!QuicConnRecvPrepareDecrypt(
-                Connection, Packet, HpMask + i * CXPLAT_HP_SAMPLE_LENGTH) ||
-            !QuicConnRecvDecryptAndAuthenticate(Connection, Path, Packet)) {
+        if (i >= PreparedCount) {
+            DecryptStates[i].Decrypted = FALSE;
+            Prepared[i] =
+                QuicConnRecvPrepareDecrypt(
+                    Connection, Packet, HpMask + i * CXPLAT_HP_SAMPLE_LENGTH);
+        }
+        if (!Prepared[i] ||
+            !QuicConnRecvDecryptAndAuthenticate(Connection, Path, Packet, &DecryptStates[i])) {
             if (Connection->State.CompatibleVerNegotiationAttempted &&
                 !Connection->State.CompatibleVerNegotiationCompleted) {
                 //
@@ -5634,6 +5773,8 @@ QuicConnRecvDatagrams(
 
     CXPLAT_PASSIVE_CODE();
 
+    QUIC_PROFILE_BEGIN(QUIC_PROFILE_RECV_DATAGRAMS);
+
     if (IsDeferred) {
         QuicTraceLogConnVerbose(
             UdpRecvDeferred,
@@ -5903,6 +6044,8 @@ QuicConnRecvDatagrams(
         QuicConnGenerateNewSourceCids(Connection, TRUE);
         Connection->State.UpdateWorker = TRUE;
     }
+
+    QUIC_PROFILE_END(Connection->Partition, QUIC_PROFILE_RECV_DATAGRAMS);
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -6494,8 +6637,7 @@ QuicConnParamSet(
             break;
         }
 
-        Connection->State.UseRoundRobinStreamScheduling =
-            Scheme == QUIC_STREAM_SCHEDULING_SCHEME_ROUND_ROBIN;
+        QuicSendSetStreamSchedulingScheme(&Connection->Send, Scheme);
 
         QuicTraceLogConnInfo(
             UpdateStreamSchedulingScheme,
@@ -6695,6 +6837,74 @@ QuicConnParamSet(
         return QUIC_STATUS_SUCCESS;
     }
 
+    case QUIC_PARAM_CONN_PATH_SCHEDULING_SCHEME: {
+
+        if (BufferLength != sizeof(QUIC_PATH_SCHEDULING_SCHEME)) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        QUIC_PATH_SCHEDULING_SCHEME Scheme =
+            *(QUIC_PATH_SCHEDULING_SCHEME*)Buffer;
+
+        if (Scheme >= QUIC_PATH_SCHEDULING_SCHEME_COUNT) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        if (Connection->State.ShutdownComplete) {
+            Status = QUIC_STATUS_INVALID_STATE;
+            break;
+        }
+
+        for (uint8_t i = 0; i < Connection->PathsCount; ++i) {
+            Connection->Paths[i].SchedulerWeight = 0;
+        }
+        Connection->PathSchedulingScheme = (uint8_t)Scheme;
+        QuicConnUpdatePathTimer(Connection);
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+    }
+
+    case QUIC_PARAM_CONN_ADD_LOCAL_ADDRESS: {
+
+        if (BufferLength != sizeof(QUIC_ADDR)) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        if (Connection->State.ClosedLocally ||
+            QuicConnIsServer(Connection) ||
+            !Connection->State.HandshakeConfirmed) {
+            Status = QUIC_STATUS_INVALID_STATE;
+            break;
+        }
+
+        //
+        // Additional paths get an exclusive binding of their own, which
+        // isn't possible with shared or raw (XDP/QTIP) sockets.
+        //
+        if (Connection->State.ShareBinding ||
+            Connection->Settings.XdpEnabled ||
+            Connection->Settings.QTIPEnabled) {
+            Status = QUIC_STATUS_NOT_SUPPORTED;
+            break;
+        }
+
+        const QUIC_ADDR* LocalAddress = (const QUIC_ADDR*)Buffer;
+
+        if (!QuicAddrIsValid(LocalAddress) ||
+            QuicAddrGetFamily(LocalAddress) !=
+                QuicAddrGetFamily(&Connection->Paths[0].Route.RemoteAddress)) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        Status = QuicConnAddLocalPath(Connection, LocalAddress);
+        break;
+    }
+
     case QUIC_PARAM_CONN_SEND_DSCP: {
         if (BufferLength != sizeof(uint8_t) || Buffer == NULL) {
             Status = QUIC_STATUS_INVALID_PARAMETER;
@@ -6934,6 +7144,30 @@ QuicConnGetV2Statistics(
     if (STATISTICS_HAS_FIELD(*StatsLength, RttVariance)) {
         Stats->RttVariance = (uint32_t)Path->RttVariance;
     }
+    if (STATISTICS_HAS_FIELD(*StatsLength, SendConnFlowControlBlockedTimeUs)) {
+        Stats->SendConnFlowControlBlockedTimeUs =
+            Connection->BlockedTimings.FlowControl.CumulativeTimeUs;
+        if (Connection->OutFlowBlockedReasons & QUIC_FLOW_BLOCKED_CONN_FLOW_CONTROL) {
+            Stats->SendConnFlowControlBlockedTimeUs +=
+                CxPlatTimeDiff64(
+                    Connection->BlockedTimings.FlowControl.LastStartTimeUs,
+                    CxPlatTimeUs64());
+        }
+    }
+    if (STATISTICS_HAS_FIELD(*StatsLength, RecvConnFlowControlWindow)) {
+        Stats->RecvConnFlowControlWindow =
+            Connection->Settings.ConnFlowControlWindow +
+            Connection->Send.RecvWindowAutoTuneBytes;
+    }
+    if (STATISTICS_HAS_FIELD(*StatsLength, SendDatagramsDroppedExpired)) {
+        Stats->SendDatagramsDroppedExpired = Connection->Stats.Send.DatagramsDroppedExpired;
+    }
+    if (STATISTICS_HAS_FIELD(*StatsLength, SendDatagramsDroppedBlocked)) {
+        Stats->SendDatagramsDroppedBlocked = Connection->Stats.Send.DatagramsDroppedBlocked;
+    }
+    if (STATISTICS_HAS_FIELD(*StatsLength, SendDatagramsDroppedTooLarge)) {
+        Stats->SendDatagramsDroppedTooLarge = Connection->Stats.Send.DatagramsDroppedTooLarge;
+    }
 
     *StatsLength = CXPLAT_MIN(*StatsLength, sizeof(QUIC_STATISTICS_V2));
 
@@ -7257,6 +7491,8 @@ QuicConnParamGet(
 
         *BufferLength = sizeof(QUIC_STREAM_SCHEDULING_SCHEME);
         *(QUIC_STREAM_SCHEDULING_SCHEME*)Buffer =
+            Connection->State.UseWeightedFairStreamScheduling ?
+                QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR :
             Connection->State.UseRoundRobinStreamScheduling ?
                 QUIC_STREAM_SCHEDULING_SCHEME_ROUND_ROBIN : QUIC_STREAM_SCHEDULING_SCHEME_FIFO;
 
@@ -7390,6 +7626,26 @@ QuicConnParamGet(
             QuicConnGetNetworkStatistics(Connection, BufferLength, (QUIC_NETWORK_STATISTICS *)Buffer);
         break;
 
+    case QUIC_PARAM_CONN_PATH_SCHEDULING_SCHEME:
+
+        if (*BufferLength < sizeof(QUIC_PATH_SCHEDULING_SCHEME)) {
+            *BufferLength = sizeof(QUIC_PATH_SCHEDULING_SCHEME);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(QUIC_PATH_SCHEDULING_SCHEME);
+        *(QUIC_PATH_SCHEDULING_SCHEME*)Buffer =
+            (QUIC_PATH_SCHEDULING_SCHEME)Connection->PathSchedulingScheme;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
     default:
         Status = QUIC_STATUS_INVALID_PARAMETER;
         break;
@@ -7740,6 +7996,9 @@ QuicConnProcessExpiredTimer(
     case QUIC_CONN_TIMER_KEEP_ALIVE:
         QuicConnProcessKeepAliveOperation(Connection);
         break;
+    case QUIC_CONN_TIMER_PATH:
+        QuicConnProcessPathTimerOperation(Connection);
+        break;
     case QUIC_CONN_TIMER_SHUTDOWN:
         QuicConnProcessShutdownTimerOperation(Connection);
         break;
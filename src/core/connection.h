@@ -9,6 +9,7 @@
 #endif
 
 typedef struct QUIC_LISTENER QUIC_LISTENER;
+typedef struct QUIC_CONN_POOL_TRACKER QUIC_CONN_POOL_TRACKER;
 
 //
 // Connection close flags
@@ -139,6 +140,12 @@ typedef union QUIC_CONNECTION_STATE {
         //
         BOOLEAN UseRoundRobinStreamScheduling : 1;
 
+        //
+        // Indicates the connection is using the weighted fair queueing stream
+        // scheduling scheme.
+        //
+        BOOLEAN UseWeightedFairStreamScheduling : 1;
+
         //
         // Indicates that this connection has resumption enabled and needs to
         // keep the TLS state and transport parameters until it is done sending
@@ -284,6 +291,10 @@ typedef struct QUIC_CONN_STATS {
         uint32_t CongestionCount;
         uint32_t EcnCongestionCount;
         uint32_t PersistentCongestionCount;
+
+        uint64_t DatagramsDroppedExpired;
+        uint64_t DatagramsDroppedBlocked;
+        uint64_t DatagramsDroppedTooLarge;
     } Send;
 
     struct {
@@ -475,6 +486,12 @@ typedef struct QUIC_CONNECTION {
     //
     uint8_t DSCP;
 
+    //
+    // How sends are spread across the validated paths. One of the
+    // QUIC_PATH_SCHEDULING_SCHEME values.
+    //
+    uint8_t PathSchedulingScheme;
+
     //
     // The ACK frequency sequence number we are currently using to send.
     //
@@ -639,6 +656,18 @@ typedef struct QUIC_CONNECTION {
     //
     QUIC_CONNECTION_CALLBACK_HANDLER ClientCallbackHandler;
 
+    //
+    // The connection pool waiting on this connection's handshake, if any.
+    //
+    QUIC_CONN_POOL_TRACKER* PoolTracker;
+
+    //
+    // Estimated memory charged to the global buffer memory budget on behalf of
+    // this connection. Moved to and from the registration's usage as the
+    // connection registers and unregisters.
+    //
+    int64_t MemoryUsage;
+
     //
     // (Server-only) Transport parameters used during handshake.
     // Only non-null when resumption is enabled.
@@ -1048,6 +1077,40 @@ QuicConnOnShutdownComplete(
     _In_ QUIC_CONNECTION* Connection
     );
 
+//
+// Charges (or, if negative, releases) memory used on behalf of the connection
+// against the global buffer memory budget and the connection's registration.
+// N.B. This is only called by the thread that owns the connection (its worker,
+// or the creating or freeing thread while no other can reference it), which
+// is also the only one to register and unregister it.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_INLINE
+void
+QuicConnUpdateMemoryUsage(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ int64_t Delta
+    )
+{
+    QUIC_PARTITION* Partition = Connection->Partition;
+    QuicLibraryUpdateMemoryUsage(Partition, Delta);
+    Connection->MemoryUsage += Delta;
+    if (Connection->State.Registered) {
+        InterlockedExchangeAdd64(
+            &Connection->Registration->MemoryUsage[Partition->Index].Bytes, Delta);
+    }
+}
+
+//
+// Reports the handshake outcome of a connection created by a connection pool.
+// Defined in connection_pool.c.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnPoolOnHandshakeComplete(
+    _In_ QUIC_CONNECTION* Connection
+    );
+
 #if DEBUG
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_INLINE
@@ -1245,6 +1308,15 @@ QuicConnGenerateNewSourceCids(
     _In_ BOOLEAN ReplaceExistingCids
     );
 
+//
+// Returns a destination connection ID not yet used locally or retired.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_CID_LIST_ENTRY*
+QuicConnGetUnusedDestCid(
+    _In_ const QUIC_CONNECTION* Connection
+    );
+
 //
 // Retires the currently used destination connection ID.
 //
@@ -8,11 +8,14 @@ Abstract:
     Connection pools allow client application to create a pool of connections
     spread across RSS cores.
 
-    To create connection spread over RSS cores, the connection pool tries multiple
-    port numbers, until the connection lands on a new RSS core. To know where a
+    To create connection spread over RSS cores, the connection pool picks local
+    port numbers that land the connection on the desired RSS core. To know where a
     connection will land, the connection pool compute the RSS core based on the
     connection parameters. To do so, it needs to query the driver RSS configuration,
-    and use the exact same RSS hash algorithm.
+    and use the exact same RSS hash algorithm. Since the Toeplitz hash is linear,
+    the hash of the fixed part of the tuple is computed once, and a single pass
+    over the ephemeral port range builds an inverse lookup of candidate ports for
+    each RSS core.
 
     There is also a chance that a port number found by the connection pool is not
     available, preventing the connection from starting successfully. To work around
@@ -22,6 +25,11 @@ Abstract:
     for other reasons and be kept in the pool (no guarantee that all connection in the
     pool are successful).
 
+    Connections are started without waiting on their handshakes, so all the
+    handshakes of a pool proceed in parallel. If the app provides a completion
+    handler, it is invoked once every connection in the pool has either connected
+    or shut down.
+
     Connection pools are currently only supported on Windows XDP datapath,
     since this is the only datapath that supports querying the RSS configuration parameters.
 
@@ -43,11 +51,67 @@ typedef struct QUIC_CONN_POOL_RSS_PROC_INFO {
     uint32_t ProcIndex;
 
     //
-    // The number of connections assigned to this CPU.
+    // Local ports whose tuple hashes onto this CPU, and the next one to use.
     //
-    uint32_t ConnectionCount;
+    uint16_t* Ports;
+    uint32_t PortCount;
+    uint32_t NextPort;
 } QUIC_CONN_POOL_RSS_PROC_INFO;
 
+typedef struct QUIC_CONN_POOL_TRACKER {
+
+    //
+    // One reference per connection whose handshake is outstanding, plus one
+    // held by MsQuicConnectionPoolCreate until it returns.
+    //
+    CXPLAT_REF_COUNT RefCount;
+
+    long ConnectedCount;
+    long FailedCount;
+
+    //
+    // The app's completion handler. Cleared if the pool creation fails.
+    //
+    QUIC_CONNECTION_POOL_COMPLETE_CALLBACK_HANDLER Handler;
+    void* Context;
+} QUIC_CONN_POOL_TRACKER;
+
+static
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnPoolTrackerRelease(
+    _In_ __drv_freesMem(Mem) QUIC_CONN_POOL_TRACKER* Tracker
+    )
+{
+    if (CxPlatRefDecrement(&Tracker->RefCount)) {
+        if (Tracker->Handler != NULL) {
+            Tracker->Handler(
+                Tracker->Context,
+                (uint16_t)Tracker->ConnectedCount,
+                (uint16_t)Tracker->FailedCount);
+        }
+        CXPLAT_FREE(Tracker, QUIC_POOL_CONN_POOL_TRACKER);
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnPoolOnHandshakeComplete(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    QUIC_CONN_POOL_TRACKER* Tracker = Connection->PoolTracker;
+    CXPLAT_DBG_ASSERT(Tracker != NULL);
+    Connection->PoolTracker = NULL;
+
+    if (Connection->State.Connected) {
+        InterlockedIncrement(&Tracker->ConnectedCount);
+    } else {
+        InterlockedIncrement(&Tracker->FailedCount);
+    }
+    QuicConnPoolTrackerRelease(Tracker);
+}
+
 static
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
@@ -92,7 +156,9 @@ QuicConnPoolAllocUniqueRssProcInfo(
         //
         if (j == RssProcessorCount) {
             CXPLAT_DBG_ASSERT(RssProcessorCount < RssConfig->RssIndirectionTableCount);
-            RssProcessors[RssProcessorCount].ConnectionCount = 0;
+            RssProcessors[RssProcessorCount].Ports = NULL;
+            RssProcessors[RssProcessorCount].PortCount = 0;
+            RssProcessors[RssProcessorCount].NextPort = 0;
             RssProcessors[RssProcessorCount++].ProcIndex = RssConfig->RssIndirectionTable[i];
         }
     }
@@ -105,45 +171,135 @@ QuicConnPoolAllocUniqueRssProcInfo(
     return Status;
 }
 
+//
+// Builds the inverse RSS lookup: up to PortsPerProc local ports for each RSS
+// processor, such that traffic from RemoteAddress to LocalAddress with that
+// port is steered to the processor.
+//
 static
-_IRQL_requires_max_(DISPATCH_LEVEL)
-QUIC_CONN_POOL_RSS_PROC_INFO*
-QuicConnPoolGetRssProcForTuple(
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicConnPoolBuildRssPortTable(
     _In_ const CXPLAT_TOEPLITZ_HASH* ToeplitzHash,
+    _In_ const CXPLAT_RSS_CONFIG* RssConfig,
     _In_ const QUIC_ADDR* RemoteAddress,
     _In_ const QUIC_ADDR* LocalAddress,
-    _In_ QUIC_CONN_POOL_RSS_PROC_INFO* RssProcessors,
+    _Inout_updates_(RssProcessorCount)
+        QUIC_CONN_POOL_RSS_PROC_INFO* RssProcessors,
     _In_ uint32_t RssProcessorCount,
-    _In_reads_(RssIndirectionTableCount)
-        uint32_t* RssIndirectionTable,
-    _In_ uint32_t RssIndirectionTableCount
+    _In_ uint32_t PortsPerProc,
+    _Outptr_result_maybenull_ _At_(*Ports, __drv_allocatesMem(Mem))
+        uint16_t** Ports
     )
 {
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    uint32_t* ProcForEntry = NULL;
+
+    *Ports =
+        (uint16_t*)CXPLAT_ALLOC_PAGED(
+            RssProcessorCount * PortsPerProc * sizeof(uint16_t),
+            QUIC_POOL_TMP_ALLOC);
+    if (*Ports == NULL) {
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "RSS Port Table",
+            RssProcessorCount * PortsPerProc * sizeof(uint16_t));
+        goto Exit;
+    }
+
+    ProcForEntry =
+        (uint32_t*)CXPLAT_ALLOC_PAGED(
+            RssConfig->RssIndirectionTableCount * sizeof(uint32_t),
+            QUIC_POOL_TMP_ALLOC);
+    if (ProcForEntry == NULL) {
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "RSS Indirection Map",
+            RssConfig->RssIndirectionTableCount * sizeof(uint32_t));
+        goto Exit;
+    }
+
     //
-    // Calculate the RSS Hash in the same way a NIC/miniport would when receiving packets from
-    // RemoteAddress to find the RSS processor.
+    // Map each indirection table entry directly to its RSS processor, so the
+    // port scan below doesn't have to search the processor list.
     //
-    uint32_t RssHash = 0, Offset;
+    for (uint32_t i = 0; i < RssConfig->RssIndirectionTableCount; i++) {
+        uint32_t j = 0;
+        for (; j < RssProcessorCount; j++) {
+            if (RssProcessors[j].ProcIndex == RssConfig->RssIndirectionTable[i]) {
+                break;
+            }
+        }
+        CXPLAT_DBG_ASSERT(j < RssProcessorCount);
+        ProcForEntry[i] = j;
+    }
+
+    for (uint32_t i = 0; i < RssProcessorCount; i++) {
+        RssProcessors[i].Ports = *Ports + i * PortsPerProc;
+        RssProcessors[i].PortCount = 0;
+        RssProcessors[i].NextPort = 0;
+    }
+
+    //
+    // Calculate the RSS Hash in the same way a NIC/miniport would when
+    // receiving packets from RemoteAddress, but with a zero local port. The
+    // local port is the last field of the hash input, and a zero input
+    // contributes nothing to a Toeplitz hash, so the full hash for any port is
+    // this base hash XOR the hash of the port bytes alone.
+    //
+    QUIC_ADDR ZeroPortAddress = *LocalAddress;
+    QuicAddrSetPort(&ZeroPortAddress, 0);
+    uint32_t BaseHash = 0, Offset;
     CxPlatToeplitzHashComputeRss(
         ToeplitzHash,
         RemoteAddress,
-        LocalAddress,
-        &RssHash,
+        &ZeroPortAddress,
+        &BaseHash,
         &Offset);
+    const uint32_t PortOffset = Offset - sizeof(uint16_t);
+    const uint32_t Mask = RssConfig->RssIndirectionTableCount - 1;
+
+    const uint32_t PortRange =
+        QUIC_ADDR_EPHEMERAL_PORT_MAX - QUIC_ADDR_EPHEMERAL_PORT_MIN + 1;
+    uint32_t Port = QuicAddrGetPort(LocalAddress);
+    uint32_t FullProcessors = 0;
+    for (uint32_t i = 0; i < PortRange && FullProcessors < RssProcessorCount; i++) {
+        if (++Port > QUIC_ADDR_EPHEMERAL_PORT_MAX) {
+            Port = QUIC_ADDR_EPHEMERAL_PORT_MIN;
+        }
 
-    const uint32_t Mask = RssIndirectionTableCount - 1;
-
-    CXPLAT_DBG_ASSERT((RssHash & Mask) < RssIndirectionTableCount);
-
-    uint32_t Index = 0;
-    for (; Index < RssProcessorCount; Index++) {
-        if (RssProcessors[Index].ProcIndex == RssIndirectionTable[RssHash & Mask]) {
-            break;
+        const uint8_t PortBytes[2] = { (uint8_t)(Port >> 8), (uint8_t)Port };
+        const uint32_t RssHash =
+            BaseHash ^
+            CxPlatToeplitzHashCompute(
+                ToeplitzHash,
+                PortBytes,
+                sizeof(PortBytes),
+                PortOffset);
+
+        QUIC_CONN_POOL_RSS_PROC_INFO* Proc = &RssProcessors[ProcForEntry[RssHash & Mask]];
+        if (Proc->PortCount < PortsPerProc) {
+            Proc->Ports[Proc->PortCount++] = (uint16_t)Port;
+            if (Proc->PortCount == PortsPerProc) {
+                FullProcessors++;
+            }
         }
     }
 
-    CXPLAT_DBG_ASSERT(Index < RssProcessorCount);
-    return &RssProcessors[Index];
+Exit:
+    if (ProcForEntry != NULL) {
+        CXPLAT_FREE(ProcForEntry, QUIC_POOL_TMP_ALLOC);
+    }
+    if (QUIC_FAILED(Status) && *Ports != NULL) {
+        CXPLAT_FREE(*Ports, QUIC_POOL_TMP_ALLOC);
+        *Ports = NULL;
+    }
+
+    return Status;
 }
 
 static
@@ -253,6 +409,7 @@ QuicConnPoolTryCreateConnection(
     _In_ uint16_t CibirIdLength,
     _In_reads_bytes_opt_(CibirIdLength)
         const uint8_t* CibirId,
+    _In_opt_ QUIC_CONN_POOL_TRACKER* Tracker,
     _Outptr_ _At_(*Connection, __drv_allocatesMem(Mem))
         QUIC_CONNECTION** Connection
     )
@@ -338,6 +495,11 @@ QuicConnPoolTryCreateConnection(
         }
     }
 
+    if (Tracker != NULL) {
+        CxPlatRefIncrement(&Tracker->RefCount);
+        (*Connection)->PoolTracker = Tracker;
+    }
+
     Status = QuicConnStart(
         *Connection,
         Configuration,
@@ -358,6 +520,15 @@ Error:
     }
 
     if (QUIC_FAILED(Status) && *Connection != NULL) {
+        //
+        // This connection will not be part of the pool, so it must not be
+        // counted towards the pool's handshakes.
+        //
+        if ((*Connection)->PoolTracker != NULL) {
+            (*Connection)->PoolTracker = NULL;
+            QuicConnPoolTrackerRelease(Tracker);
+        }
+
         //
         // This connection has never left MsQuic back to the application,
         // so don't send any notifications to the application on close.
@@ -383,6 +554,8 @@ MsQuicConnectionPoolCreate(
     QUIC_CONNECTION** Connections = (QUIC_CONNECTION**)ConnectionPool;
     CXPLAT_RSS_CONFIG* RssConfig = NULL;
     QUIC_CONN_POOL_RSS_PROC_INFO* RssProcessors = NULL;
+    uint16_t* RssPorts = NULL;
+    QUIC_CONN_POOL_TRACKER* Tracker = NULL;
     const char* ServerNameCopy = NULL;
     CXPLAT_TOEPLITZ_HASH ToeplitzHash;
     QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
@@ -580,13 +753,64 @@ MsQuicConnectionPoolCreate(
             (Config->NumberOfConnections / RssProcessorCount);
 
     //
-    // Begin creating and starting connections.
+    // Precompute the local ports for each RSS processor, with some spares in
+    // case a port turns out to be in use.
+    //
+    Status =
+        QuicConnPoolBuildRssPortTable(
+            &ToeplitzHash,
+            RssConfig,
+            &ResolvedRemoteAddress,
+            &LocalAddress,
+            RssProcessors,
+            RssProcessorCount,
+            ConnectionsPerProc + MAX_CONNECTION_POOL_RETRY_MULTIPLIER,
+            &RssPorts);
+    if (QUIC_FAILED(Status)) {
+        goto Error;
+    }
+
+    if (Config->CompleteHandler != NULL) {
+        Tracker =
+            (QUIC_CONN_POOL_TRACKER*)CXPLAT_ALLOC_NONPAGED(
+                sizeof(QUIC_CONN_POOL_TRACKER),
+                QUIC_POOL_CONN_POOL_TRACKER);
+        if (Tracker == NULL) {
+            Status = QUIC_STATUS_OUT_OF_MEMORY;
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "Connection Pool Tracker",
+                sizeof(QUIC_CONN_POOL_TRACKER));
+            goto Error;
+        }
+        CxPlatRefInitialize(&Tracker->RefCount);
+        Tracker->ConnectedCount = 0;
+        Tracker->FailedCount = 0;
+        Tracker->Handler = Config->CompleteHandler;
+        Tracker->Context = Config->CompleteContext;
+    }
+
+    //
+    // Begin creating and starting connections, assigning them round-robin to
+    // the RSS processors. The handshakes all proceed in parallel.
     //
+    uint32_t ProcCursor = 0;
     for (uint32_t i = 0; i < Config->NumberOfConnections; i++) {
-        const uint32_t MaxCreationRetries = RssProcessorCount * MAX_CONNECTION_POOL_RETRY_MULTIPLIER;
-        uint32_t RetryCount = 0;
+        BOOLEAN Created = FALSE;
+        uint32_t ExhaustedProcs = 0;
 
-        for (; RetryCount < MaxCreationRetries; RetryCount++) {
+        while (!Created && ExhaustedProcs < RssProcessorCount) {
+            QUIC_CONN_POOL_RSS_PROC_INFO* CurrentProc = &RssProcessors[ProcCursor];
+            if (CurrentProc->NextPort == CurrentProc->PortCount) {
+                //
+                // This processor has no usable ports left, so spill over onto
+                // the next one.
+                //
+                ProcCursor = (ProcCursor + 1) % RssProcessorCount;
+                ExhaustedProcs++;
+                continue;
+            }
 
             //
             // The connection takes ownership of the ServerName parameter, so we must
@@ -603,28 +827,7 @@ MsQuicConnectionPoolCreate(
                 }
             }
 
-            uint32_t NewPort = QuicAddrGetPort(&LocalAddress) + 1;
-            if (NewPort > QUIC_ADDR_EPHEMERAL_PORT_MAX) {
-                NewPort = QUIC_ADDR_EPHEMERAL_PORT_MIN;
-            }
-            QuicAddrSetPort(&LocalAddress, (uint16_t)NewPort);
-
-            QUIC_CONN_POOL_RSS_PROC_INFO* CurrentProc =
-                QuicConnPoolGetRssProcForTuple(
-                    &ToeplitzHash,
-                    &ResolvedRemoteAddress,
-                    &LocalAddress,
-                    RssProcessors,
-                    RssProcessorCount,
-                    RssConfig->RssIndirectionTable,
-                    RssConfig->RssIndirectionTableCount);
-
-            if (CurrentProc->ConnectionCount >= ConnectionsPerProc) {
-                //
-                // This processor already has enough connections on it, so try another port number.
-                //
-                continue;
-            }
+            QuicAddrSetPort(&LocalAddress, CurrentProc->Ports[CurrentProc->NextPort++]);
 
             QUIC_PARTITION* Partition =
                 QuicLibraryGetPartitionFromProcessorIndex(CurrentProc->ProcIndex);
@@ -643,31 +846,27 @@ MsQuicConnectionPoolCreate(
                     Config->Family,
                     Config->CibirIdLength,
                     Config->CibirIds ? Config->CibirIds[i] : NULL,
+                    Tracker,
                     &Connections[i]);
 
             //
             // The connection either owns the ServerNameCopy, or it was freed.
             //
             ServerNameCopy = NULL;
-            if (QUIC_FAILED(Status)) {
-                continue;
+            if (QUIC_SUCCEEDED(Status)) {
+                Created = TRUE;
+                CreatedConnections++;
+                ProcCursor = (ProcCursor + 1) % RssProcessorCount;
             }
-
-            //
-            // The connection was created successfully, add it to the count for this processor.
-            //
-            CurrentProc->ConnectionCount++;
-            CreatedConnections++;
-            break;
         }
 
-        if (RetryCount == MaxCreationRetries) {
+        if (!Created) {
             Status = QUIC_STATUS_ADDRESS_IN_USE;
             QuicTraceEvent(
                 LibraryErrorStatus,
                 "[ lib] ERROR, %u, %s.",
-                RetryCount,
-                "Connection Pool out of retries");
+                i,
+                "Connection Pool out of ports");
             goto CleanUpConnections;
         }
     }
@@ -685,9 +884,22 @@ Error:
     if (ServerNameCopy != NULL) {
         CXPLAT_FREE(ServerNameCopy, QUIC_POOL_SERVERNAME);
     }
+    if (RssPorts != NULL) {
+        CXPLAT_FREE(RssPorts, QUIC_POOL_TMP_ALLOC);
+    }
     if (RssProcessors != NULL) {
         CXPLAT_FREE(RssProcessors, QUIC_POOL_TMP_ALLOC);
     }
+    if (Tracker != NULL) {
+        if (QUIC_FAILED(Status)) {
+            //
+            // The app is only told about the handshakes of a pool that was
+            // successfully created.
+            //
+            Tracker->Handler = NULL;
+        }
+        QuicConnPoolTrackerRelease(Tracker);
+    }
     if (RssConfig != NULL) {
         CxPlatDataPathRssConfigFree(RssConfig);
     }
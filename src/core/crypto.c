@@ -1677,6 +1677,9 @@ QuicCryptoProcessTlsCompletion(
             "Indicating QUIC_CONNECTION_EVENT_CONNECTED (Resume=%hhu)",
             Event.CONNECTED.SessionResumed);
         (void)QuicConnIndicateEvent(Connection, &Event);
+        if (Connection->PoolTracker != NULL) {
+            QuicConnPoolOnHandshakeComplete(Connection);
+        }
         if (Crypto->TlsState.SessionResumed) {
             QuicPerfCounterIncrement(Connection->Partition, QUIC_PERF_COUNTER_CONN_RESUMED);
         }
@@ -56,6 +56,10 @@ static void CubicProbeResetPhysicsState(_In_ QUIC_CONGESTION_CONTROL_CUBICPROBE*
     CubicProbe->CurrentElasticity = 0.0;
     CubicProbe->IsQueueBuilding = FALSE;
     CubicProbe->AckCountForGrowth = 0;
+
+    CubicProbe->AppLimited = FALSE;
+    CubicProbe->RoundAppLimited = FALSE;
+    CubicProbe->AppLimitedExitTarget = 0;
 }
 
 // =========================================================================
@@ -97,6 +101,9 @@ CubicProbeCheckSafety(
     }
 
     CubicProbe->RoundInFlightBytes += AckEvent->NumRetransmittableBytes;
+    if (AckEvent->IsLargestAckedPacketAppLimited) {
+        CubicProbe->RoundAppLimited = TRUE;
+    }
 }
 
 // =========================================================================
@@ -125,6 +132,13 @@ CubicProbeCheckElasticity(
         }
         uint32_t CurrentCwnd = Cubic->CongestionWindow;
 
+        // [App-Limited Round]
+        // The app didn't keep the window full for this round, so the measured
+        // bandwidth reflects the app, not the path. Skip the sample.
+        if (CubicProbe->RoundAppLimited) {
+            goto NextRound;
+        }
+
         // [Epoch Initialization]
         // If we don't have a baseline yet (start of connection or after congestion), set it.
         if (CubicProbe->EpochStartBandwidth == 0 || CubicProbe->EpochStartCwnd == 0) {
@@ -167,7 +181,9 @@ CubicProbeCheckElasticity(
                 CubicProbe->CurrentElasticity, CurrentBW, CubicProbe->EpochStartBandwidth);
         }
 
+NextRound:
         // Reset for Next Round
+        CubicProbe->RoundAppLimited = FALSE;
         CubicProbe->RoundInFlightBytes = 0;
         CubicProbe->RoundStartTime = TimeNow;
         CubicProbe->ProbeTargetPacketNumber = Connection->Send.NextPacketNumber; 
@@ -389,6 +405,10 @@ BOOLEAN CubicProbeCongestionControlOnDataAcknowledged(_In_ QUIC_CONGESTION_CONTR
 
     Cubic->BytesInFlight -= AckEvent->NumRetransmittableBytes;
 
+    if (CubicProbe->AppLimited && AckEvent->LargestAck > CubicProbe->AppLimitedExitTarget) {
+        CubicProbe->AppLimited = FALSE;
+    }
+
     if (Cubic->IsInRecovery) {
         if (AckEvent->LargestAck > Cubic->RecoverySentPacketNumber) {
             Cubic->IsInRecovery = FALSE;
@@ -553,8 +573,18 @@ void CubicProbeCongestionControlLogOutFlowStatus(_In_ const QUIC_CONGESTION_CONT
 uint32_t CubicProbeCongestionControlGetBytesInFlightMax(_In_ const QUIC_CONGESTION_CONTROL* Cc) { return Cc->CubicProbe.Cubic.BytesInFlightMax; }
 uint8_t CubicProbeCongestionControlGetExemptions(_In_ const QUIC_CONGESTION_CONTROL* Cc) { return Cc->CubicProbe.Cubic.Exemptions; }
 uint32_t CubicProbeCongestionControlGetCongestionWindow(_In_ const QUIC_CONGESTION_CONTROL* Cc) { return Cc->CubicProbe.Cubic.CongestionWindow; }
-BOOLEAN CubicProbeCongestionControlIsAppLimited(_In_ const QUIC_CONGESTION_CONTROL* Cc) { UNREFERENCED_PARAMETER(Cc); return FALSE; }
-void CubicProbeCongestionControlSetAppLimited(_In_ struct QUIC_CONGESTION_CONTROL* Cc) { UNREFERENCED_PARAMETER(Cc); }
+BOOLEAN CubicProbeCongestionControlIsAppLimited(_In_ const QUIC_CONGESTION_CONTROL* Cc) { return Cc->CubicProbe.AppLimited; }
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void CubicProbeCongestionControlSetAppLimited(_In_ struct QUIC_CONGESTION_CONTROL* Cc) {
+    QUIC_CONGESTION_CONTROL_CUBICPROBE* CubicProbe = &Cc->CubicProbe;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    if (CubicProbe->Cubic.BytesInFlight > CubicProbe->Cubic.CongestionWindow) {
+        return;
+    }
+    CubicProbe->AppLimited = TRUE;
+    CubicProbe->AppLimitedExitTarget = Connection->LossDetection.LargestSentPacketNumber;
+}
 
 void CubicProbeCongestionControlGetNetworkStatistics(_In_ const QUIC_CONNECTION* const Connection, _In_ const QUIC_CONGESTION_CONTROL* const Cc, _Out_ QUIC_NETWORK_STATISTICS* NetworkStatistics) {
     const QUIC_CONGESTION_CONTROL_CUBIC* Cubic = &Cc->CubicProbe.Cubic;
@@ -43,6 +43,13 @@ typedef struct QUIC_CONGESTION_CONTROL_CUBICPROBE {
     // Veto Counter (Optional if used)
     uint8_t VetoCounter;
 
+    // 6. App-Limited Tracking
+    // Rounds where the sender ran out of data don't measure the path,
+    // so they are excluded from the elasticity samples.
+    BOOLEAN  AppLimited;
+    BOOLEAN  RoundAppLimited;
+    uint64_t AppLimitedExitTarget;
+
 } QUIC_CONGESTION_CONTROL_CUBICPROBE;
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
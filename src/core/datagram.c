@@ -108,6 +108,21 @@ QuicDatagramIndicateSendStateChange(
     *ClientContext = Event.DATAGRAM_SEND_STATE_CHANGED.ClientContext;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+static
+void
+QuicDatagramFreeSendRequest(
+    _In_ QUIC_SEND_REQUEST* SendRequest
+    )
+{
+    QUIC_DATAGRAM_SEND_BATCH* Batch = SendRequest->DatagramBatch;
+    if (Batch == NULL) {
+        CxPlatPoolFree(SendRequest);
+    } else if (CxPlatRefDecrement(&Batch->RefCount)) {
+        CXPLAT_FREE(Batch, QUIC_POOL_DATAGRAM_BATCH);
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicDatagramCancelSend(
@@ -119,7 +134,7 @@ QuicDatagramCancelSend(
         Connection,
         &SendRequest->ClientContext,
         QUIC_DATAGRAM_SEND_CANCELED);
-    CxPlatPoolFree(SendRequest);
+    QuicDatagramFreeSendRequest(SendRequest);
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -135,7 +150,133 @@ QuicDatagramCompleteSend(
         Connection,
         ClientContext,
         QUIC_DATAGRAM_SEND_SENT);
-    CxPlatPoolFree(SendRequest);
+    QuicDatagramFreeSendRequest(SendRequest);
+}
+
+//
+// Returns the tail of the lowest priority level at or above Level that has
+// requests queued, or the end of the priority flagged requests if none do.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+QUIC_SEND_REQUEST**
+QuicDatagramFindInsertPoint(
+    _In_ const QUIC_DATAGRAM* Datagram,
+    _In_ uint32_t Level
+    )
+{
+    const QUIC_DATAGRAM_PRIORITY_TAILS* Tails = Datagram->PriorityTails;
+    while (Level <= UINT8_MAX) {
+        uint64_t Bits = Tails->Levels[Level / 64] >> (Level % 64);
+        if (Bits == 0) {
+            Level = (Level | 63) + 1; // Skip to the next word.
+            continue;
+        }
+        while (!(Bits & 1)) {
+            Bits >>= 1;
+            Level++;
+        }
+        return Tails->Tails[Level];
+    }
+    return Datagram->PrioritySendQueueTail;
+}
+
+//
+// Inserts a request without QUIC_SEND_FLAG_DGRAM_PRIORITY behind all the queued
+// requests of the same or higher priority.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+BOOLEAN
+QuicDatagramInsertByPriority(
+    _In_ QUIC_DATAGRAM* Datagram,
+    _In_ QUIC_SEND_REQUEST* SendRequest
+    )
+{
+    QUIC_DATAGRAM_PRIORITY_TAILS* Tails = Datagram->PriorityTails;
+    const uint8_t Level = SendRequest->DatagramPriority;
+
+    if (Tails == NULL) {
+        if (Level == QUIC_DATAGRAM_PRIORITY_DEFAULT) {
+            *Datagram->SendQueueTail = SendRequest;
+            Datagram->SendQueueTail = &SendRequest->Next;
+            return TRUE;
+        }
+
+        Tails =
+            CXPLAT_ALLOC_NONPAGED(
+                sizeof(QUIC_DATAGRAM_PRIORITY_TAILS),
+                QUIC_POOL_DATAGRAM_TAILS);
+        if (Tails == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "Datagram priority tails",
+                sizeof(QUIC_DATAGRAM_PRIORITY_TAILS));
+            return FALSE;
+        }
+        CxPlatZeroMemory(Tails->Levels, sizeof(Tails->Levels));
+        Datagram->PriorityTails = Tails;
+
+        if (Datagram->SendQueueTail != Datagram->PrioritySendQueueTail) {
+            //
+            // Everything queued so far has the default priority.
+            //
+            Tails->Tails[QUIC_DATAGRAM_PRIORITY_DEFAULT] = Datagram->SendQueueTail;
+            Tails->Levels[QUIC_DATAGRAM_PRIORITY_DEFAULT / 64] |=
+                1ull << (QUIC_DATAGRAM_PRIORITY_DEFAULT % 64);
+        }
+    }
+
+    QUIC_SEND_REQUEST** Prev = QuicDatagramFindInsertPoint(Datagram, Level);
+    SendRequest->Next = *Prev;
+    *Prev = SendRequest;
+    if (Datagram->SendQueueTail == Prev) {
+        Datagram->SendQueueTail = &SendRequest->Next;
+    }
+    Tails->Tails[Level] = &SendRequest->Next;
+    Tails->Levels[Level / 64] |= 1ull << (Level % 64);
+    return TRUE;
+}
+
+//
+// Removes the request that Prev points to from the send queue.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+void
+QuicDatagramUnlink(
+    _In_ QUIC_DATAGRAM* Datagram,
+    _In_ QUIC_SEND_REQUEST** Prev
+    )
+{
+    QUIC_SEND_REQUEST* SendRequest = *Prev;
+    QUIC_DATAGRAM_PRIORITY_TAILS* Tails = Datagram->PriorityTails;
+
+    if (Tails != NULL && !(SendRequest->Flags & QUIC_SEND_FLAG_DGRAM_PRIORITY)) {
+        const uint8_t Level = SendRequest->DatagramPriority;
+        if (Tails->Tails[Level] == &SendRequest->Next) {
+            //
+            // The previous request is the new tail if it is of the same level.
+            // Otherwise this was the last request of its level.
+            //
+            if (Prev != Datagram->PrioritySendQueueTail &&
+                CXPLAT_CONTAINING_RECORD(Prev, QUIC_SEND_REQUEST, Next)->
+                    DatagramPriority == Level) {
+                Tails->Tails[Level] = Prev;
+            } else {
+                Tails->Levels[Level / 64] &= ~(1ull << (Level % 64));
+            }
+        }
+    }
+
+    if (Datagram->PrioritySendQueueTail == &SendRequest->Next) {
+        Datagram->PrioritySendQueueTail = Prev;
+    }
+    if (Datagram->SendQueueTail == &SendRequest->Next) {
+        Datagram->SendQueueTail = Prev;
+    }
+    *Prev = SendRequest->Next;
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -146,6 +287,9 @@ QuicDatagramUninitialize(
 {
     CXPLAT_DBG_ASSERT(Datagram->SendQueue == NULL);
     CXPLAT_DBG_ASSERT(Datagram->ApiQueue == NULL);
+    if (Datagram->PriorityTails != NULL) {
+        CXPLAT_FREE(Datagram->PriorityTails, QUIC_POOL_DATAGRAM_TAILS);
+    }
     CxPlatDispatchLockUninitialize(&Datagram->ApiQueueLock);
 }
 
@@ -185,6 +329,11 @@ QuicDatagramSendShutdown(
     }
     Datagram->PrioritySendQueueTail = &Datagram->SendQueue;
     Datagram->SendQueueTail = &Datagram->SendQueue;
+    if (Datagram->PriorityTails != NULL) {
+        CxPlatZeroMemory(
+            Datagram->PriorityTails->Levels,
+            sizeof(Datagram->PriorityTails->Levels));
+    }
 
     while (ApiQueue != NULL) {
         QUIC_SEND_REQUEST* SendRequest = ApiQueue;
@@ -210,16 +359,13 @@ QuicDatagramOnMaxSendLengthChanged(
     while (*SendQueue != NULL) {
         if ((*SendQueue)->TotalLength > (uint64_t)Datagram->MaxSendLength) {
             QUIC_SEND_REQUEST* SendRequest = *SendQueue;
-            if (Datagram->PrioritySendQueueTail == &SendRequest->Next) {
-                Datagram->PrioritySendQueueTail = SendQueue;
-            }
-            *SendQueue = SendRequest->Next;
+            QuicDatagramUnlink(Datagram, SendQueue);
+            Connection->Stats.Send.DatagramsDroppedTooLarge++;
             QuicDatagramCancelSend(Connection, SendRequest);
         } else {
             SendQueue = &((*SendQueue)->Next);
         }
     }
-    Datagram->SendQueueTail = SendQueue;
 
     if (Datagram->SendQueue != NULL) {
         QuicSendSetSendFlag(&Connection->Send, QUIC_CONN_SEND_FLAG_DATAGRAM);
@@ -339,7 +485,13 @@ QuicDatagramQueueSend(
             "Datagram send while disabled");
         Status = QUIC_STATUS_INVALID_STATE;
     } else {
-        if (SendRequest->TotalLength > (uint64_t)Datagram->MaxSendLength) {
+        //
+        // SendRequest may be the head of a chain of requests from a batch send.
+        // Any of those that are too long are canceled individually when the
+        // queue is flushed, instead of failing the whole batch.
+        //
+        if (SendRequest->DatagramBatch == NULL &&
+            SendRequest->TotalLength > (uint64_t)Datagram->MaxSendLength) {
             QuicTraceEvent(
                 ConnError,
                 "[conn][%p] ERROR, %s.",
@@ -359,7 +511,11 @@ QuicDatagramQueueSend(
     CxPlatDispatchLockRelease(&Datagram->ApiQueueLock);
 
     if (QUIC_FAILED(Status)) {
-        CxPlatPoolFree(SendRequest);
+        while (SendRequest != NULL) {
+            QUIC_SEND_REQUEST* Next = SendRequest->Next;
+            QuicDatagramFreeSendRequest(SendRequest);
+            SendRequest = Next;
+        }
         goto Exit;
     }
 
@@ -426,11 +582,15 @@ QuicDatagramSendFlush(
         CXPLAT_DBG_ASSERT(!(SendRequest->Flags & QUIC_SEND_FLAG_BUFFERED));
         CXPLAT_TEL_ASSERT(Datagram->SendEnabled);
 
-        if (SendRequest->TotalLength > (uint64_t)Datagram->MaxSendLength || QuicConnIsClosed(Connection)) {
+        if (QuicConnIsClosed(Connection)) {
+            QuicDatagramCancelSend(Connection, SendRequest);
+            continue;
+        }
+        if (SendRequest->TotalLength > (uint64_t)Datagram->MaxSendLength) {
+            Connection->Stats.Send.DatagramsDroppedTooLarge++;
             QuicDatagramCancelSend(Connection, SendRequest);
             continue;
         }
-        TotalBytesSent += SendRequest->TotalLength;
 
         if (SendRequest->Flags & QUIC_SEND_FLAG_DGRAM_PRIORITY) {
             SendRequest->Next = *Datagram->PrioritySendQueueTail;
@@ -439,10 +599,11 @@ QuicDatagramSendFlush(
                 Datagram->SendQueueTail = &SendRequest->Next;
             }
             Datagram->PrioritySendQueueTail = &SendRequest->Next;
-        } else {
-            *Datagram->SendQueueTail = SendRequest;
-            Datagram->SendQueueTail = &SendRequest->Next;
+        } else if (!QuicDatagramInsertByPriority(Datagram, SendRequest)) {
+            QuicDatagramCancelSend(Connection, SendRequest);
+            continue;
         }
+        TotalBytesSent += SendRequest->TotalLength;
 
         QuicTraceLogConnVerbose(
             DatagramSendQueued,
@@ -465,6 +626,16 @@ QuicDatagramSendFlush(
         TotalBytesSent);
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+void
+QuicDatagramRemoveHead(
+    _In_ QUIC_DATAGRAM* Datagram
+    )
+{
+    QuicDatagramUnlink(Datagram, &Datagram->SendQueue);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 BOOLEAN
 QuicDatagramWriteFrame(
@@ -478,9 +649,26 @@ QuicDatagramWriteFrame(
 
     QuicDatagramValidate(Datagram);
 
+    uint64_t TimeNow = 0;
     while (Datagram->SendQueue != NULL) {
         QUIC_SEND_REQUEST* SendRequest = Datagram->SendQueue;
 
+        if (SendRequest->DatagramDeadline != 0) {
+            if (TimeNow == 0) {
+                TimeNow = CxPlatTimeUs64();
+            }
+            if (CxPlatTimeAtOrBefore64(SendRequest->DatagramDeadline, TimeNow)) {
+                //
+                // Too late to be useful. Drop it before it takes up any room in
+                // the packet or congestion window.
+                //
+                QuicDatagramRemoveHead(Datagram);
+                Connection->Stats.Send.DatagramsDroppedExpired++;
+                QuicDatagramCancelSend(Connection, SendRequest);
+                continue;
+            }
+        }
+
         if (Builder->Metadata->Flags.KeyType == QUIC_PACKET_KEY_0_RTT &&
             !(SendRequest->Flags & QUIC_SEND_FLAG_ALLOW_0_RTT)) {
             CXPLAT_DBG_ASSERT(FALSE);
@@ -516,13 +704,7 @@ QuicDatagramWriteFrame(
             goto Exit;
         }
 
-        if (Datagram->PrioritySendQueueTail == &SendRequest->Next) {
-            Datagram->PrioritySendQueueTail = &Datagram->SendQueue;
-        }
-        if (Datagram->SendQueueTail == &SendRequest->Next) {
-            Datagram->SendQueueTail = &Datagram->SendQueue;
-        }
-        Datagram->SendQueue = SendRequest->Next;
+        QuicDatagramRemoveHead(Datagram);
 
         Builder->Metadata->Flags.IsAckEliciting = TRUE;
         Builder->Metadata->Frames[Builder->Metadata->FrameCount].Type = QUIC_FRAME_DATAGRAM;
@@ -608,21 +790,29 @@ QuicDatagramCancelBlocked(
         return;
     }
 
+    uint64_t TimeNow = 0;
     do {
-        if ((*SendQueue)->Flags & QUIC_SEND_FLAG_CANCEL_ON_BLOCKED) {
-            QUIC_SEND_REQUEST* SendRequest = *SendQueue;
-            if (Datagram->PrioritySendQueueTail == &SendRequest->Next) {
-                Datagram->PrioritySendQueueTail = SendQueue;
+        QUIC_SEND_REQUEST* SendRequest = *SendQueue;
+        BOOLEAN Expired = FALSE;
+        if (SendRequest->DatagramDeadline != 0) {
+            if (TimeNow == 0) {
+                TimeNow = CxPlatTimeUs64();
+            }
+            Expired = CxPlatTimeAtOrBefore64(SendRequest->DatagramDeadline, TimeNow);
+        }
+        if (Expired || (SendRequest->Flags & QUIC_SEND_FLAG_CANCEL_ON_BLOCKED)) {
+            QuicDatagramUnlink(Datagram, SendQueue);
+            if (Expired) {
+                Connection->Stats.Send.DatagramsDroppedExpired++;
+            } else {
+                Connection->Stats.Send.DatagramsDroppedBlocked++;
             }
-            *SendQueue = SendRequest->Next;
             QuicDatagramCancelSend(Connection, SendRequest);
         } else {
             SendQueue = &((*SendQueue)->Next);
         }
     } while (*SendQueue != NULL);
 
-    Datagram->SendQueueTail = SendQueue;
-
     if (Datagram->SendQueue != NULL) {
         QuicSendSetSendFlag(&Connection->Send, QUIC_CONN_SEND_FLAG_DATAGRAM);
     } else {
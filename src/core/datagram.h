@@ -5,6 +5,38 @@
 
 --*/
 
+//
+// A single allocation backing all the send requests of one DatagramSendBatch
+// call. The QUIC_SEND_REQUEST array, then the QUIC_BUFFER array, follow the
+// header. The batch is freed when its last request completes.
+//
+typedef struct QUIC_DATAGRAM_SEND_BATCH {
+
+    CXPLAT_REF_COUNT RefCount;
+
+} QUIC_DATAGRAM_SEND_BATCH;
+
+//
+// Tails of each priority level in the part of the send queue behind the
+// QUIC_SEND_FLAG_DGRAM_PRIORITY requests, so that a request can be inserted
+// after the last one of the same (or next higher) priority without walking
+// the queue.
+//
+typedef struct QUIC_DATAGRAM_PRIORITY_TAILS {
+
+    //
+    // Bit set of the priority levels that have requests queued.
+    //
+    uint64_t Levels[(UINT8_MAX + 1) / 64];
+
+    //
+    // Next field of the last queued request of each level. Only valid when the
+    // level's bit is set.
+    //
+    QUIC_SEND_REQUEST** Tails[UINT8_MAX + 1];
+
+} QUIC_DATAGRAM_PRIORITY_TAILS;
+
 typedef struct QUIC_DATAGRAM {
 
     //
@@ -14,6 +46,13 @@ typedef struct QUIC_DATAGRAM {
     QUIC_SEND_REQUEST** PrioritySendQueueTail;
     QUIC_SEND_REQUEST** SendQueueTail;
 
+    //
+    // Allocated on the first send with a non-default priority. Until then all
+    // the requests behind the priority flagged ones have the same priority and
+    // are simply appended at SendQueueTail.
+    //
+    QUIC_DATAGRAM_PRIORITY_TAILS* PriorityTails;
+
     //
     // API calls to DatagramSend queue the send request here and then queue the
     // send operation. That operation moves the send request onto the
@@ -273,6 +273,20 @@ QuicLibrarySumPerfCounters(
         }
     }
 
+#ifndef _KERNEL_MODE
+    //
+    // Worker execution time is tracked by the platform worker pool instead of
+    // per partition.
+    //
+    if (MsQuicLib.WorkerPool != NULL &&
+        CountersPerBuffer > QUIC_PERF_COUNTER_WORK_POLL_US) {
+        uint64_t ActiveTimeUs, PollTimeUs;
+        CxPlatWorkerPoolGetExecutionTime(MsQuicLib.WorkerPool, &ActiveTimeUs, &PollTimeUs);
+        Counters[QUIC_PERF_COUNTER_WORK_ACTIVE_US] = (int64_t)ActiveTimeUs;
+        Counters[QUIC_PERF_COUNTER_WORK_POLL_US] = (int64_t)PollTimeUs;
+    }
+#endif
+
     //
     // Zero any counters that are still negative after summation.
     //
@@ -438,6 +452,8 @@ MsQuicLibraryOnSettingsChanged(
     MsQuicLib.HandshakeMemoryLimit =
         (MsQuicLib.Settings.RetryMemoryLimit * CxPlatTotalMemory) / UINT16_MAX;
     QuicLibraryEvaluateSendRetryState();
+    MsQuicLib.RecvWindowAutoTuneLimit =
+        CxPlatTotalMemory / QUIC_RECV_WINDOW_AUTO_TUNE_MEMORY_DIVISOR;
 
     if (UpdateRegistrations) {
         CxPlatLockAcquire(&MsQuicLib.Lock);
@@ -697,6 +713,11 @@ MsQuicLibraryUninitialize(
         MsQuicLib.ExecutionConfig = NULL;
     }
 
+    if (MsQuicLib.NetworkEmulation != NULL) {
+        CXPLAT_FREE(MsQuicLib.NetworkEmulation, QUIC_POOL_NETWORK_EMULATION);
+        MsQuicLib.NetworkEmulation = NULL;
+    }
+
     MsQuicLib.LazyInitComplete = FALSE;
 
     QuicTraceEvent(
@@ -837,6 +858,10 @@ QuicLibraryLazyInitialize(
                 MsQuicLib.Datapath,
                 MsQuicLib.ExecutionConfig->PollingIdleTimeoutUs);
         }
+        if (MsQuicLib.NetworkEmulation != NULL) {
+            (void)CxPlatDataPathSetNetworkEmulation(
+                MsQuicLib.Datapath, MsQuicLib.NetworkEmulation);
+        }
     } else {
         MsQuicLibraryFreePartitions();
 #ifndef _KERNEL_MODE
@@ -1209,6 +1234,62 @@ QuicLibrarySetGlobalParam(
         Status = QUIC_STATUS_SUCCESS;
         break;
     }
+    case QUIC_PARAM_GLOBAL_NETWORK_EMULATION: {
+        if (BufferLength != 0 &&
+            (Buffer == NULL || BufferLength != sizeof(QUIC_NETWORK_EMULATION_CONFIG))) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        const QUIC_NETWORK_EMULATION_CONFIG* Config =
+            BufferLength == 0 ? NULL : (const QUIC_NETWORK_EMULATION_CONFIG*)Buffer;
+        if (Config != NULL &&
+            Config->RateScheduleCount > QUIC_NETWORK_EMULATION_MAX_RATE_SCHEDULE) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        CxPlatLockAcquire(&MsQuicLib.Lock);
+        if (MsQuicLib.LazyInitComplete) {
+            Status = CxPlatDataPathSetNetworkEmulation(MsQuicLib.Datapath, Config);
+            CxPlatLockRelease(&MsQuicLib.Lock);
+            break;
+        }
+
+        //
+        // Save the config to be applied once the datapath is initialized.
+        //
+        if (Config == NULL) {
+            if (MsQuicLib.NetworkEmulation != NULL) {
+                CXPLAT_FREE(MsQuicLib.NetworkEmulation, QUIC_POOL_NETWORK_EMULATION);
+                MsQuicLib.NetworkEmulation = NULL;
+            }
+            Status = QUIC_STATUS_SUCCESS;
+            CxPlatLockRelease(&MsQuicLib.Lock);
+            break;
+        }
+
+        if (MsQuicLib.NetworkEmulation == NULL) {
+            MsQuicLib.NetworkEmulation =
+                CXPLAT_ALLOC_NONPAGED(
+                    sizeof(QUIC_NETWORK_EMULATION_CONFIG), QUIC_POOL_NETWORK_EMULATION);
+            if (MsQuicLib.NetworkEmulation == NULL) {
+                QuicTraceEvent(
+                    AllocFailure,
+                    "Allocation of '%s' failed. (%llu bytes)",
+                    "Network emulation config",
+                    sizeof(QUIC_NETWORK_EMULATION_CONFIG));
+                Status = QUIC_STATUS_OUT_OF_MEMORY;
+                CxPlatLockRelease(&MsQuicLib.Lock);
+                break;
+            }
+        }
+        CxPlatCopyMemory(MsQuicLib.NetworkEmulation, Config, sizeof(*Config));
+        Status = QUIC_STATUS_SUCCESS;
+        CxPlatLockRelease(&MsQuicLib.Lock);
+        break;
+    }
+
 #if QUIC_TEST_DATAPATH_HOOKS_ENABLED
     case QUIC_PARAM_GLOBAL_TEST_DATAPATH_HOOKS:
 
@@ -1308,6 +1389,20 @@ QuicLibrarySetGlobalParam(
         break;
     }
 
+    case QUIC_PARAM_GLOBAL_BUFFER_MEMORY_LIMIT:
+
+        if (BufferLength != sizeof(MsQuicLib.BufferMemoryLimit)) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        //
+        // Zero disables the buffer memory budget.
+        //
+        MsQuicLib.BufferMemoryLimit = *(uint64_t*)Buffer;
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
     default:
         Status = QUIC_STATUS_INVALID_PARAMETER;
         break;
@@ -1564,6 +1659,42 @@ QuicLibraryGetGlobalParam(
         Status = QUIC_STATUS_SUCCESS;
         break;
 
+    case QUIC_PARAM_GLOBAL_PROFILE_COUNTERS: {
+#ifdef QUIC_PROFILING_ENABLED
+        const uint32_t ProfileLength =
+            sizeof(QUIC_PROFILE_COUNTER) * QUIC_PROFILE_STAGE_MAX;
+        if (*BufferLength < ProfileLength) {
+            *BufferLength = ProfileLength;
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = ProfileLength;
+        QUIC_PROFILE_COUNTER* Counters = (QUIC_PROFILE_COUNTER*)Buffer;
+        CxPlatZeroMemory(Counters, ProfileLength);
+        if (MsQuicLib.Partitions != NULL) {
+            for (uint32_t i = 0; i < MsQuicLib.PartitionCount; ++i) {
+                for (uint32_t Stage = 0; Stage < QUIC_PROFILE_STAGE_MAX; ++Stage) {
+                    Counters[Stage].Cycles +=
+                        MsQuicLib.Partitions[i].ProfileCounters[Stage].Cycles;
+                    Counters[Stage].Calls +=
+                        MsQuicLib.Partitions[i].ProfileCounters[Stage].Calls;
+                }
+            }
+        }
+
+        Status = QUIC_STATUS_SUCCESS;
+#else
+        Status = QUIC_STATUS_NOT_SUPPORTED;
+#endif
+        break;
+    }
+
     case QUIC_PARAM_GLOBAL_IN_USE:
 
         if (*BufferLength < sizeof(BOOLEAN)) {
@@ -1663,6 +1794,25 @@ QuicLibraryGetGlobalParam(
 #endif // DEBUG
     }
 
+    case QUIC_PARAM_GLOBAL_BUFFER_MEMORY_LIMIT:
+
+        if (*BufferLength < sizeof(MsQuicLib.BufferMemoryLimit)) {
+            *BufferLength = sizeof(MsQuicLib.BufferMemoryLimit);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(MsQuicLib.BufferMemoryLimit);
+        *(uint64_t*)Buffer = MsQuicLib.BufferMemoryLimit;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
     default:
         Status = QUIC_STATUS_INVALID_PARAMETER;
         break;
@@ -2034,6 +2184,12 @@ MsQuicOpenVersion(
 
     Api->ConnectionPoolCreate = MsQuicConnectionPoolCreate;
 
+    Api->DatagramSendBatch = MsQuicDatagramSendBatch;
+
+    Api->ContentOpen = MsQuicContentOpen;
+    Api->ContentClose = MsQuicContentClose;
+    Api->StreamSendContent = MsQuicStreamSendContent;
+
     *QuicApi = Api;
 
 Exit:
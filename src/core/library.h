@@ -19,7 +19,8 @@ typedef enum QUIC_HANDLE_TYPE {
     QUIC_HANDLE_TYPE_LISTENER,
     QUIC_HANDLE_TYPE_CONNECTION_CLIENT,
     QUIC_HANDLE_TYPE_CONNECTION_SERVER,
-    QUIC_HANDLE_TYPE_STREAM
+    QUIC_HANDLE_TYPE_STREAM,
+    QUIC_HANDLE_TYPE_CONTENT
 
 } QUIC_HANDLE_TYPE;
 
@@ -167,6 +168,21 @@ typedef struct QUIC_LIBRARY {
     //
     uint64_t CurrentHandshakeMemoryUsage;
 
+    //
+    // The maximum and current total receive window growth granted by receive
+    // window auto-tuning, across all connections.
+    //
+    uint64_t RecvWindowAutoTuneLimit;
+    uint64_t RecvWindowAutoTuneBytes;
+
+    //
+    // The memory budget for connection state and stream send/receive buffers,
+    // across all connections, or zero if there is none. Usage approaching the
+    // budget applies graduated back-pressure (see QUIC_MEMORY_PRESSURE). The
+    // usage itself is tracked per partition.
+    //
+    uint64_t BufferMemoryLimit;
+
     //
     // Handle to global persistent storage (registry).
     //
@@ -177,6 +193,12 @@ typedef struct QUIC_LIBRARY {
     //
     QUIC_GLOBAL_EXECUTION_CONFIG* ExecutionConfig;
 
+    //
+    // Network emulation to apply once the datapath is initialized (optionally
+    // set by the app).
+    //
+    QUIC_NETWORK_EMULATION_CONFIG* NetworkEmulation;
+
     //
     // Datapath instance for the library.
     //
@@ -307,6 +329,77 @@ QuicLibraryGetPartitionFromProcessorIndex(
     return &MsQuicLib.Partitions[ProcessorIndex % MsQuicLib.PartitionCount];
 }
 
+//
+// Graduated levels of back-pressure applied as buffer memory usage approaches
+// MsQuicLib.BufferMemoryLimit. Each level includes the ones below it.
+//
+typedef enum QUIC_MEMORY_PRESSURE {
+    QUIC_MEMORY_PRESSURE_NONE,
+    QUIC_MEMORY_PRESSURE_SHRINK_RECV_WINDOW,    // Over 1/2 of the limit.
+    QUIC_MEMORY_PRESSURE_SHRINK_SEND_BUFFER,    // Over 3/4 of the limit.
+    QUIC_MEMORY_PRESSURE_REJECT_HANDSHAKES,     // Over 7/8 of the limit.
+} QUIC_MEMORY_PRESSURE;
+
+//
+// Returns the estimated buffer memory usage, summed across all partitions.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_INLINE
+uint64_t
+QuicLibraryGetBufferMemoryUsage(
+    void
+    )
+{
+    int64_t Usage = 0;
+    for (uint16_t i = 0; i < MsQuicLib.PartitionCount; ++i) {
+        Usage += MsQuicLib.Partitions[i].BufferMemoryUsage;
+    }
+    //
+    // The partitions are read without synchronization, so a release may be
+    // seen without the matching charge.
+    //
+    return Usage > 0 ? (uint64_t)Usage : 0;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_INLINE
+QUIC_MEMORY_PRESSURE
+QuicLibraryGetMemoryPressure(
+    void
+    )
+{
+    const uint64_t Limit = MsQuicLib.BufferMemoryLimit;
+    if (Limit == 0) {
+        return QUIC_MEMORY_PRESSURE_NONE;
+    }
+    const uint64_t Usage = QuicLibraryGetBufferMemoryUsage();
+    if (Usage < Limit / 2) {
+        return QUIC_MEMORY_PRESSURE_NONE;
+    }
+    if (Usage < Limit - Limit / 4) {
+        return QUIC_MEMORY_PRESSURE_SHRINK_RECV_WINDOW;
+    }
+    if (Usage < Limit - Limit / 8) {
+        return QUIC_MEMORY_PRESSURE_SHRINK_SEND_BUFFER;
+    }
+    return QUIC_MEMORY_PRESSURE_REJECT_HANDSHAKES;
+}
+
+//
+// Charges (or, if negative, releases) memory against the global buffer memory
+// budget, on the given partition.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_INLINE
+void
+QuicLibraryUpdateMemoryUsage(
+    _In_ QUIC_PARTITION* Partition,
+    _In_ int64_t Delta
+    )
+{
+    InterlockedExchangeAdd64(&Partition->BufferMemoryUsage, Delta);
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_INLINE
 QUIC_PARTITION*
@@ -330,6 +330,14 @@ MsQuicListenerStart(
             UdpConfig.CibirIdLength);
     }
 
+    //
+    // Short header packets carry one of our CIDs, which encodes the partition
+    // that owns the connection right after the server ID.
+    //
+    UdpConfig.PartitionIdOffset = 1 + MsQuicLib.CidServerIdLength;
+    UdpConfig.PartitionIdMask = MsQuicLib.PartitionMask;
+    UdpConfig.PartitionCount = MsQuicLib.PartitionCount;
+
     if (MsQuicLib.Settings.XdpEnabled) {
         UdpConfig.Flags |= CXPLAT_SOCKET_FLAG_XDP;
     }
@@ -21,6 +21,13 @@ typedef struct QUIC_CACHEALIGN QUIC_PARTITIONED_HASHTABLE {
 
 } QUIC_PARTITIONED_HASHTABLE;
 
+//
+// Memory charged to the global buffer memory budget for each local CID in a
+// lookup table.
+//
+#define QUIC_LOOKUP_CID_MEMORY(SourceCid) \
+    (int64_t)(sizeof(QUIC_CID_HASH_ENTRY) + (SourceCid)->CID.Length)
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 QuicLookupInsertLocalCid(
@@ -62,6 +69,9 @@ QuicLookupUninitialize(
             CxPlatDispatchRwLockUninitialize(&Table->RwLock);
         }
         CXPLAT_FREE(Lookup->HASH.Tables, QUIC_POOL_LOOKUP_HASHTABLE);
+        QuicLibraryUpdateMemoryUsage(
+            QuicLibraryGetCurrentPartition(),
+            -(int64_t)(sizeof(QUIC_PARTITIONED_HASHTABLE) * Lookup->PartitionCount));
     }
 
     if (Lookup->MaximizePartitioning) {
@@ -110,6 +120,9 @@ QuicLookupCreateHashTable(
             Lookup->HASH.Tables = NULL;
         } else {
             Lookup->PartitionCount = PartitionCount;
+            QuicLibraryUpdateMemoryUsage(
+                QuicLibraryGetCurrentPartition(),
+                (int64_t)(sizeof(QUIC_PARTITIONED_HASHTABLE) * PartitionCount));
         }
     }
 
@@ -233,6 +246,9 @@ QuicLookupRebalance(
 #pragma warning(pop)
             }
             CXPLAT_FREE(PreviousTable, QUIC_POOL_LOOKUP_HASHTABLE);
+            QuicLibraryUpdateMemoryUsage(
+                QuicLibraryGetCurrentPartition(),
+                -(int64_t)(sizeof(QUIC_PARTITIONED_HASHTABLE) * PreviousPartitionCount));
         }
     }
 
@@ -498,6 +514,9 @@ QuicLookupInsertLocalCid(
 
     if (UpdateRefCount) {
         Lookup->CidCount++;
+        QuicLibraryUpdateMemoryUsage(
+            QuicLibraryGetCurrentPartition(),
+            QUIC_LOOKUP_CID_MEMORY(SourceCid));
         QuicConnAddRef(SourceCid->Connection, QUIC_CONN_REF_LOOKUP_TABLE);
     }
 
@@ -556,6 +575,9 @@ QuicLookupInsertRemoteHash(
     Connection->RemoteHashEntry = Entry;
 
     QuicLibraryOnHandshakeConnectionAdded();
+    QuicLibraryUpdateMemoryUsage(
+        QuicLibraryGetCurrentPartition(),
+        (int64_t)(sizeof(QUIC_REMOTE_HASH_ENTRY) + RemoteCidLength));
 
     if (UpdateRefCount) {
         QuicConnAddRef(Connection, QUIC_CONN_REF_LOOKUP_TABLE);
@@ -587,6 +609,9 @@ QuicLookupRemoveLocalCidInt(
     CXPLAT_DBG_ASSERT(SourceCid->CID.IsInLookupTable);
     CXPLAT_DBG_ASSERT(Lookup->CidCount != 0);
     Lookup->CidCount--;
+    QuicLibraryUpdateMemoryUsage(
+        QuicLibraryGetCurrentPartition(),
+        -QUIC_LOOKUP_CID_MEMORY(SourceCid));
 
 #if QUIC_DEBUG_HASHTABLE_LOOKUP
     QuicTraceLogVerbose(
@@ -855,6 +880,9 @@ QuicLookupRemoveRemoteHash(
     Connection->RemoteHashEntry = NULL;
     CxPlatDispatchRwLockReleaseExclusive(&Lookup->RwLock, PrevIrql);
 
+    QuicLibraryUpdateMemoryUsage(
+        QuicLibraryGetCurrentPartition(),
+        -(int64_t)(sizeof(QUIC_REMOTE_HASH_ENTRY) + RemoteHashEntry->RemoteCidLength));
     CXPLAT_FREE(RemoteHashEntry, QUIC_POOL_REMOTE_HASH);
     QuicConnRelease(Connection, QUIC_CONN_REF_LOOKUP_TABLE);
 }
@@ -938,3 +966,49 @@ QuicLookupMoveLocalConnectionIDs(
     }
     CxPlatDispatchRwLockReleaseExclusive(&LookupDest->RwLock, PrevIrql2);
 }
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicLookupAttachConnection(
+    _In_ QUIC_LOOKUP* Lookup,
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    BOOLEAN Result = FALSE;
+
+    CxPlatDispatchRwLockAcquireExclusive(&Lookup->RwLock, PrevIrql);
+    if (Lookup->PartitionCount == 0 && Lookup->SINGLE.Connection == NULL) {
+        CXPLAT_DBG_ASSERT(Lookup->CidCount == 0);
+        Lookup->SINGLE.Connection = Connection;
+        Lookup->CidCount++;
+        QuicConnAddRef(Connection, QUIC_CONN_REF_LOOKUP_TABLE);
+        Result = TRUE;
+    }
+    CxPlatDispatchRwLockReleaseExclusive(&Lookup->RwLock, PrevIrql);
+
+    return Result;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicLookupDetachConnection(
+    _In_ QUIC_LOOKUP* Lookup,
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    BOOLEAN Detached = FALSE;
+
+    CxPlatDispatchRwLockAcquireExclusive(&Lookup->RwLock, PrevIrql);
+    if (Lookup->PartitionCount == 0 && Lookup->SINGLE.Connection == Connection) {
+        CXPLAT_DBG_ASSERT(Lookup->CidCount == 1);
+        Lookup->CidCount--;
+        Lookup->SINGLE.Connection = NULL;
+        Detached = TRUE;
+    }
+    CxPlatDispatchRwLockReleaseExclusive(&Lookup->RwLock, PrevIrql);
+
+    if (Detached) {
+#pragma prefast(suppress:6001, "SAL doesn't understand ref counts")
+        QuicConnRelease(Connection, QUIC_CONN_REF_LOOKUP_TABLE);
+    }
+}
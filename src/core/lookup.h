@@ -200,3 +200,25 @@ QuicLookupMoveLocalConnectionIDs(
     _In_ QUIC_LOOKUP* LookupDest,
     _In_ QUIC_CONNECTION* Connection
     );
+
+//
+// Attaches the connection to an unpartitioned lookup without inserting any of
+// its local CIDs. All the connection's CIDs then match in the lookup. Used for
+// the exclusive bindings of additional client paths.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicLookupAttachConnection(
+    _In_ QUIC_LOOKUP* Lookup,
+    _In_ QUIC_CONNECTION* Connection
+    );
+
+//
+// Detaches a connection previously attached with QuicLookupAttachConnection.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicLookupDetachConnection(
+    _In_ QUIC_LOOKUP* Lookup,
+    _In_ QUIC_CONNECTION* Connection
+    );
@@ -85,6 +85,8 @@ QuicLossDetectionInitializeInternalState(
     LossDetection->TimeOfLastAckedPacketSent = 0;
     LossDetection->AdjustedLastAckedTime = 0;
     LossDetection->ProbeCount = 0;
+    LossDetection->BlackHoleLossCount = 0;
+    LossDetection->LargestAckFullSizePacket = 0;
 }
 
 #if DEBUG
@@ -397,7 +399,8 @@ QuicLossDetectionOnPacketSent(
     QUIC_SENT_PACKET_METADATA* SentPacket =
         QuicSentPacketPoolGetPacketMetadata(
             &Connection->Partition->SentPacketPool,
-            TempSentPacket->FrameCount);
+            TempSentPacket->FrameCount,
+            Connection);
     if (SentPacket == NULL) {
         //
         // We can't allocate the memory to permanently track this packet so just
@@ -634,6 +637,10 @@ QuicLossDetectionOnPacketAcknowledged(
     }
 
     if (Path != NULL) {
+        Path->LastAckTime = AckTime;
+        if (Path->LargestAckedPacketNumber < Packet->PacketNumber) {
+            Path->LargestAckedPacketNumber = Packet->PacketNumber;
+        }
         uint16_t PacketMtu =
             PacketSizeFromUdpPayloadSize(
                 QuicAddrGetFamily(&Path->Route.RemoteAddress),
@@ -650,6 +657,18 @@ QuicLossDetectionOnPacketAcknowledged(
                 Path->ID);
         }
 
+        if (Path == &Connection->Paths[0] &&
+            !Packet->Flags.IsMtuProbe &&
+            PacketMtu >= Path->Mtu) {
+            //
+            // A full-size packet made it through, so the current MTU works.
+            //
+            LossDetection->BlackHoleLossCount = 0;
+            if (Packet->PacketNumber > LossDetection->LargestAckFullSizePacket) {
+                LossDetection->LargestAckFullSizePacket = Packet->PacketNumber;
+            }
+        }
+
         if (Packet->Flags.IsMtuProbe) {
             CXPLAT_DBG_ASSERT(Path->IsMinMtuValidated);
             if (QuicMtuDiscoveryOnAckedPacket(
@@ -835,7 +854,13 @@ QuicLossDetectionRetransmitFrames(
                 uint64_t ValidationTimeout =
                     CXPLAT_MAX(QuicLossDetectionComputeProbeTimeout(LossDetection, Path, 3),
                         6 * MS_TO_US(Connection->Settings.InitialRttMs));
-                if (CxPlatTimeDiff64(Path->PathValidationStartTime, TimeNow) > ValidationTimeout) {
+                //
+                // The active path is never removed here; it keeps being
+                // challenged until validation succeeds or the connection
+                // idles out.
+                //
+                if (PathIndex != 0 &&
+                    CxPlatTimeDiff64(Path->PathValidationStartTime, TimeNow) > ValidationTimeout) {
                     QuicTraceLogConnInfo(
                         PathValidationTimeout,
                         Connection,
@@ -917,6 +942,60 @@ QuicLossDetectionOnPacketDiscarded(
     QuicSentPacketPoolReturnPacketMetadata(Packet, Connection);
 }
 
+//
+// Returns TRUE if the packet was sent at the active path's full MTU, as opposed
+// to an MTU probe or a short packet that fits any MTU.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+BOOLEAN
+QuicLossDetectionIsFullSizePacket(
+    _In_ QUIC_LOSS_DETECTION* LossDetection,
+    _In_ const QUIC_SENT_PACKET_METADATA* Packet
+    )
+{
+    QUIC_CONNECTION* Connection = QuicLossDetectionGetConnection(LossDetection);
+    const QUIC_PATH* Path = &Connection->Paths[0];
+    if (Packet->Flags.IsMtuProbe ||
+        Packet->PathId != Path->ID ||
+        Path->Mtu <= Connection->Settings.MinimumMtu) {
+        return FALSE;
+    }
+
+    uint16_t PacketMtu =
+        PacketSizeFromUdpPayloadSize(
+            QuicAddrGetFamily(&Path->Route.RemoteAddress),
+            Packet->PacketLength);
+    return PacketMtu >= Path->Mtu;
+}
+
+//
+// Counts a lost packet towards DPLPMTUD black hole detection if it was sent at
+// the active path's full MTU and no full-size packet sent after it has been
+// acknowledged. Loss from congestion is expected to still let later full-size
+// packets through.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+void
+QuicLossDetectionCheckBlackHoleLoss(
+    _In_ QUIC_LOSS_DETECTION* LossDetection,
+    _In_ const QUIC_SENT_PACKET_METADATA* Packet
+    )
+{
+    if (!QuicLossDetectionIsFullSizePacket(LossDetection, Packet)) {
+        return;
+    }
+
+    if (Packet->PacketNumber > LossDetection->LargestAckFullSizePacket) {
+        if (LossDetection->BlackHoleLossCount < UINT8_MAX) {
+            LossDetection->BlackHoleLossCount++;
+        }
+    } else {
+        LossDetection->BlackHoleLossCount = 0;
+    }
+}
+
 //
 // Returns TRUE if any lost retransmittable bytes were detected.
 //
@@ -972,6 +1051,9 @@ QuicLossDetectionDetectAndHandleLostPackets(
         uint64_t Rtt = CXPLAT_MAX(Path->SmoothedRtt, Path->LatestRttSample);
         uint64_t TimeReorderThreshold = QUIC_TIME_REORDER_THRESHOLD(Rtt);
         uint64_t LargestLostPacketNumber = 0;
+        const BOOLEAN MultiplePathsInUse =
+            Connection->PathSchedulingScheme != QUIC_PATH_SCHEDULING_SCHEME_ACTIVE &&
+            Connection->PathsCount > 1;
         QUIC_SENT_PACKET_METADATA* PrevPacket = NULL;
         Packet = LossDetection->SentPackets;
         while (Packet != NULL) {
@@ -988,7 +1070,33 @@ QuicLossDetectionDetectAndHandleLostPackets(
                 continue;
             }
 
-            if (Packet->PacketNumber + QUIC_PACKET_REORDER_THRESHOLD < LossDetection->LargestAck) {
+            uint64_t LargestAck = LossDetection->LargestAck;
+            uint64_t PacketTimeReorderThreshold = TimeReorderThreshold;
+            if (MultiplePathsInUse) {
+                if (Packet->PacketNumber >= LossDetection->LargestAck) {
+                    break;
+                }
+
+                //
+                // All paths share one packet number space, so gaps left by
+                // packets still in flight on another path say nothing about
+                // loss on this one. Only use time threshold loss, relative to
+                // the largest acknowledged packet and RTT of the packet's own
+                // path.
+                //
+                uint8_t PathIndex;
+                const QUIC_PATH* PacketPath =
+                    QuicConnGetPathByID(Connection, Packet->PathId, &PathIndex);
+                if (PacketPath != NULL) {
+                    LargestAck = PacketPath->LargestAckedPacketNumber;
+                    PacketTimeReorderThreshold =
+                        QUIC_TIME_REORDER_THRESHOLD(
+                            CXPLAT_MAX(PacketPath->SmoothedRtt, PacketPath->LatestRttSample));
+                }
+            }
+
+            if (!MultiplePathsInUse &&
+                Packet->PacketNumber + QUIC_PACKET_REORDER_THRESHOLD < LargestAck) {
                 if (!NonretransmittableHandshakePacket) {
                     QuicTraceLogVerbose(
                         PacketTxLostFack,
@@ -1004,8 +1112,8 @@ QuicLossDetectionDetectAndHandleLostPackets(
                         QuicPacketTraceType(Packet),
                         QUIC_TRACE_PACKET_LOSS_FACK);
                 }
-            } else if (Packet->PacketNumber < LossDetection->LargestAck &&
-                        CxPlatTimeAtOrBefore64(Packet->SentTime + TimeReorderThreshold, TimeNow)) {
+            } else if (Packet->PacketNumber < LargestAck &&
+                        CxPlatTimeAtOrBefore64(Packet->SentTime + PacketTimeReorderThreshold, TimeNow)) {
                 if (!NonretransmittableHandshakePacket) {
                     QuicTraceLogVerbose(
                         PacketTxLostRack,
@@ -1021,6 +1129,10 @@ QuicLossDetectionDetectAndHandleLostPackets(
                         QuicPacketTraceType(Packet),
                         QUIC_TRACE_PACKET_LOSS_RACK);
                 }
+            } else if (MultiplePathsInUse) {
+                PrevPacket = Packet;
+                Packet = Packet->Next;
+                continue;
             } else {
                 break;
             }
@@ -1032,6 +1144,7 @@ QuicLossDetectionDetectAndHandleLostPackets(
                 LossDetection->PacketsInFlight--;
                 LostRetransmittableBytes += Packet->PacketLength;
                 QuicLossDetectionRetransmitFrames(LossDetection, Packet, FALSE);
+                QuicLossDetectionCheckBlackHoleLoss(LossDetection, Packet);
             }
 
             LargestLostPacketNumber = Packet->PacketNumber;
@@ -1055,6 +1168,12 @@ QuicLossDetectionDetectAndHandleLostPackets(
 
         QuicLossValidate(LossDetection);
 
+        if (LossDetection->BlackHoleLossCount >= QUIC_DPLPMTUD_BLACKHOLE_LOSS_COUNT) {
+            LossDetection->BlackHoleLossCount = 0;
+            QuicMtuDiscoveryOnBlackHoleDetected(
+                &Connection->Paths[0].MtuDiscovery, Connection);
+        }
+
         if (LostRetransmittableBytes > 0) {
             if (LossDetection->ProbeCount > QUIC_PERSISTENT_CONGESTION_THRESHOLD) {
                 //
@@ -1218,7 +1337,11 @@ QuicLossDetectionDiscardPackets(
             .MinRttValid = FALSE
         };
 
-        if (QuicCongestionControlOnDataAcknowledged(&Connection->CongestionControl, &AckEvent)) {
+        QUIC_PROFILE_BEGIN(QUIC_PROFILE_CC_DATA_ACKED);
+        const BOOLEAN Unblocked =
+            QuicCongestionControlOnDataAcknowledged(&Connection->CongestionControl, &AckEvent);
+        QUIC_PROFILE_END(Connection->Partition, QUIC_PROFILE_CC_DATA_ACKED);
+        if (Unblocked) {
             //
             // We were previously blocked and are now unblocked.
             //
@@ -1318,6 +1441,7 @@ QuicLossDetectionProcessAckBlocks(
     BOOLEAN NewLargestAck = FALSE;
     BOOLEAN NewLargestAckRetransmittable = FALSE;
     BOOLEAN NewLargestAckDifferentPath = FALSE;
+    uint8_t NewLargestAckPathId = 0;
     uint64_t NewLargestAckTimestamp = 0;
 
     *InvalidAckBlock = FALSE;
@@ -1452,6 +1576,7 @@ CheckSentPackets:
             NewLargestAck = TRUE;
             NewLargestAckRetransmittable = LargestAckedPacket->Flags.IsAckEliciting;
             NewLargestAckDifferentPath = Path->ID != LargestAckedPacket->PathId;
+            NewLargestAckPathId = LargestAckedPacket->PathId;
             NewLargestAckTimestamp = LargestAckedPacket->SentTime;
         }
     }
@@ -1514,6 +1639,23 @@ CheckSentPackets:
 
     QuicLossValidate(LossDetection);
 
+    QUIC_PATH* RttPath = Path;
+    if (NewLargestAckRetransmittable &&
+        Connection->PathSchedulingScheme != QUIC_PATH_SCHEDULING_SCHEME_ACTIVE) {
+        //
+        // When sending across several paths, ACKs routinely come back on a
+        // different path than the packet went out on, and a single ACK covers
+        // packets from several paths. Take the sample from the largest
+        // acknowledged packet and attribute it to the path it was sent on.
+        //
+        MinRtt = CxPlatTimeDiff64(NewLargestAckTimestamp, TimeNow);
+        if (NewLargestAckDifferentPath) {
+            uint8_t PathIndex;
+            RttPath = QuicConnGetPathByID(Connection, NewLargestAckPathId, &PathIndex);
+            NewLargestAckDifferentPath = RttPath == NULL;
+        }
+    }
+
     if (NewLargestAckRetransmittable && !NewLargestAckDifferentPath) {
         //
         // Update the current RTT with the smallest RTT calculated, which
@@ -1530,7 +1672,7 @@ CheckSentPackets:
         CXPLAT_DBG_ASSERT(NewLargestAckTimestamp != 0);
         QuicConnUpdateRtt(
             Connection,
-            Path,
+            RttPath,
             MinRtt,
             NewLargestAckTimestamp - Connection->Stats.Timing.Start,
             Packet->SendTimestamp);
@@ -1631,12 +1773,28 @@ CheckSentPackets:
             .MinRttValid = TRUE,
         };
 
-        if (QuicCongestionControlOnDataAcknowledged(&Connection->CongestionControl, &AckEvent)) {
+        QUIC_PROFILE_BEGIN(QUIC_PROFILE_CC_DATA_ACKED);
+        const BOOLEAN Unblocked =
+            QuicCongestionControlOnDataAcknowledged(&Connection->CongestionControl, &AckEvent);
+        QUIC_PROFILE_END(Connection->Partition, QUIC_PROFILE_CC_DATA_ACKED);
+        if (Unblocked) {
             //
             // We were previously blocked and are now unblocked.
             //
             QuicSendQueueFlush(&Connection->Send, REASON_CONGESTION_CONTROL);
         }
+
+        //
+        // The pacing rate estimate only moves meaningfully over a round trip,
+        // so re-evaluate the ideal send buffer against it at most once per RTT.
+        // Growth of BytesInFlightMax still triggers an adjustment from the
+        // congestion controller directly.
+        //
+        if (CxPlatTimeDiff64(Connection->SendBuffer.PacedAdjustTime, TimeNow) >=
+                Path->SmoothedRtt) {
+            Connection->SendBuffer.PacedAdjustTime = TimeNow;
+            QuicSendBufferConnectionAdjust(Connection);
+        }
     }
 
     LossDetection->ProbeCount = 0;
@@ -1743,6 +1901,31 @@ QuicLossDetectionScheduleProbe(
         "probe round %hu",
         LossDetection->ProbeCount);
 
+    if (LossDetection->ProbeCount == QUIC_DPLPMTUD_BLACKHOLE_PROBE_COUNT &&
+        Connection->State.HandshakeConfirmed) {
+        //
+        // Nothing has been acknowledged for several probe timeouts, which on
+        // its own could just as well be an outage. Only fall back to the
+        // minimum MTU, before sending the probes below, if enough full-size
+        // packets went unacknowledged too: either already declared lost or
+        // still outstanding all this time.
+        //
+        uint32_t FullSizeLossCount = LossDetection->BlackHoleLossCount;
+        for (QUIC_SENT_PACKET_METADATA* Packet = LossDetection->SentPackets;
+             Packet != NULL && FullSizeLossCount < QUIC_DPLPMTUD_BLACKHOLE_LOSS_COUNT;
+             Packet = Packet->Next) {
+            if (Packet->PacketNumber > LossDetection->LargestAckFullSizePacket &&
+                QuicLossDetectionIsFullSizePacket(LossDetection, Packet)) {
+                FullSizeLossCount++;
+            }
+        }
+        if (FullSizeLossCount >= QUIC_DPLPMTUD_BLACKHOLE_LOSS_COUNT) {
+            LossDetection->BlackHoleLossCount = 0;
+            QuicMtuDiscoveryOnBlackHoleDetected(
+                &Connection->Paths[0].MtuDiscovery, Connection);
+        }
+    }
+
     //
     // Below, we will schedule a fixed number packets to be retransmitted. What
     // we'd like to do here send only that number of packets' worth of fresh
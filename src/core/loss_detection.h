@@ -87,6 +87,19 @@ typedef struct QUIC_LOSS_DETECTION {
     //
     uint16_t ProbeCount;
 
+    //
+    // Number of full-size packets on the active path lost in a row, with no
+    // full-size packet sent after them acknowledged. Used for DPLPMTUD black
+    // hole detection.
+    //
+    uint8_t BlackHoleLossCount;
+
+    //
+    // The largest acknowledged packet number of a full-size packet on the
+    // active path.
+    //
+    uint64_t LargestAckFullSizePacket;
+
 } QUIC_LOSS_DETECTION;
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -8,24 +8,30 @@ Abstract:
     This module handles the MTU discovery logic.
 
     Upon a new path being validated, MTU discovery is started on that path.
-    This is done by sending a probe packet larger than the current MTU.
+    This is done by sending a padded PING probe packet larger than the current
+    MTU.
 
-    If the probe packet is acknowledged, that is set as the current MTU and a
-    new probe packet is sent. This is repeated until the maximum allowed MTU is
-    reached.
+    The search is a binary search between the current (acknowledged) MTU and
+    the largest MTU not yet known to fail. The first probe optimistically
+    tries the top of the range, as that is the common case. A special case is
+    added so 1500 is always a checked value, as 1500 is often the max allowed
+    over the internet. If a probe packet is acknowledged, that is set as the
+    current MTU and the next probe bisects the remaining range.
 
     If a probe packet is not ACKed, the probe at the same size will be retried.
-    If this fails QUIC_DPLPMTUD_MAX_PROBES times, max MTU is considered found
-    and searching stops.
+    If this fails QUIC_DPLPMTUD_MAX_PROBES times, that size is considered too
+    large and the upper bound of the search drops below it. Searching stops
+    once the range is narrower than QUIC_DPLPMTUD_SEARCH_PRECISION.
 
     Once searching has stopped, discovery will stay idle until
     QUIC_DPLPMTUD_RAISE_TIMER_TIMEOUT has passed. The next send will then
-    trigger a new MTU discovery period, unless maximum allowed MTU is already
-    reached.
+    re-probe the smallest size that previously failed, and if that succeeds
+    the full range up to the maximum allowed MTU is searched again.
 
-    The current algorithm is very simplistic, increasing by 80 bytes each
-    probe. A special case is added so 1500 is always a checked value, as 1500
-    is often the max allowed over the internet.
+    Loss detection reports black holes: repeated loss of full-size packets
+    while nothing full-size sent after them is acknowledged, or repeated probe
+    timeouts. On a black hole, the MTU falls back to the minimum MTU and the
+    search restarts below the size that stopped working.
 
 --*/
 
@@ -78,32 +84,39 @@ QuicGetNextProbeSize(
         CXPLAT_CONTAINING_RECORD(MtuDiscovery, QUIC_PATH, MtuDiscovery);
     //
     // N.B. This algorithm must always be increasing. Other logic in the module
-    // depends on that behavior.
+    // depends on that behavior. Returning the current MTU means the search is
+    // complete.
     //
+    const uint16_t Low = Path->Mtu;
+    const uint16_t High = MtuDiscovery->SearchHigh;
+    if (High <= Low || High - Low < QUIC_DPLPMTUD_SEARCH_PRECISION) {
+        return Low;
+    }
 
     //
     // Jump automatically to 1280 to return algorithm to ideal case. 1280 should
-    // be supported in most scenarios. With minimum being 1248, this will always
-    // be less then a full increment.
+    // be supported in most scenarios.
     //
-    if (Path->Mtu < 1280) {
-        return CXPLAT_MIN(1280, MtuDiscovery->MaxMtu);
+    if (Low < 1280 && High >= 1280) {
+        return 1280;
     }
 
-    uint16_t Mtu = Path->Mtu + QUIC_DPLPMTUD_INCREMENT;
-    if (Mtu > MtuDiscovery->MaxMtu) {
-        Mtu = MtuDiscovery->MaxMtu;
+    //
+    // Most paths support the full allowed MTU, so try that first.
+    //
+    if (!MtuDiscovery->HasProbedMax) {
+        MtuDiscovery->HasProbedMax = TRUE;
+        return High;
     }
 
     //
-    // Our increasing algorithm might not hit 1500 by default. Ensure that
-    // happens.
+    // Bisecting might not hit 1500. Ensure that happens.
     //
-    if (!MtuDiscovery->HasProbed1500 && Mtu >= 1500) {
-        MtuDiscovery->HasProbed1500 = TRUE;
-        Mtu = 1500;
+    if (!MtuDiscovery->HasProbed1500 && Low < 1500 && High > 1500) {
+        return 1500;
     }
-    return Mtu;
+
+    return Low + (uint16_t)((High - Low + 1) / 2);
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -115,24 +128,49 @@ QuicMtuDiscoveryMoveToSearching(
 {
     QUIC_PATH* Path =
         CXPLAT_CONTAINING_RECORD(MtuDiscovery, QUIC_PATH, MtuDiscovery);
+    BOOLEAN IsRaising = MtuDiscovery->IsSearchComplete;
     MtuDiscovery->IsSearchComplete = FALSE;
+    MtuDiscovery->IsRaising = FALSE;
     MtuDiscovery->ProbeCount = 0;
-    //
-    // If the path has not had min MTU validated, send probe for min MTU.
-    //
-    MtuDiscovery->ProbeSize =
-        Path->IsMinMtuValidated ?
-            QuicGetNextProbeSize(MtuDiscovery) :
-            Path->Mtu;
 
-    //
-    // If we're attempting to probe the current MTU, and min MTU is validated
-    // then we've hit max allowed MTU. Enter search complete.
-    //
-    if (MtuDiscovery->ProbeSize == Path->Mtu && Path->IsMinMtuValidated) {
-        QuicMtuDiscoveryMoveToSearchComplete(MtuDiscovery, Connection);
-        return;
+    if (!Path->IsMinMtuValidated) {
+        //
+        // If the path has not had min MTU validated, send probe for min MTU.
+        //
+        MtuDiscovery->ProbeSize = Path->Mtu;
+
+    } else if (IsRaising) {
+        //
+        // Coming out of Search Complete. Only re-probe the smallest size that
+        // failed last time; if the path got better the full range is searched
+        // again once that is acknowledged.
+        //
+        if (Path->Mtu >= MtuDiscovery->MaxMtu) {
+            QuicMtuDiscoveryMoveToSearchComplete(MtuDiscovery, Connection);
+            return;
+        }
+        MtuDiscovery->IsRaising = TRUE;
+        MtuDiscovery->ProbeSize =
+            CXPLAT_MIN(MtuDiscovery->SearchHigh + 1, MtuDiscovery->MaxMtu);
+
+    } else {
+        MtuDiscovery->ProbeSize = QuicGetNextProbeSize(MtuDiscovery);
+
+        //
+        // If we're attempting to probe the current MTU, and min MTU is
+        // validated then we've narrowed down the max allowed MTU. Enter search
+        // complete.
+        //
+        if (MtuDiscovery->ProbeSize == Path->Mtu) {
+            QuicMtuDiscoveryMoveToSearchComplete(MtuDiscovery, Connection);
+            return;
+        }
+    }
+
+    if (MtuDiscovery->ProbeSize >= 1500) {
+        MtuDiscovery->HasProbed1500 = TRUE;
     }
+
     QuicTraceLogConnInfo(
         MtuSearching,
         Connection,
@@ -161,7 +199,10 @@ QuicMtuDiscoveryPeerValidated(
     // default
     //
     MtuDiscovery->MaxMtu = QuicConnGetMaxMtuForPath(Connection, Path);
+    MtuDiscovery->SearchHigh = MtuDiscovery->MaxMtu;
     MtuDiscovery->HasProbed1500 = Path->Mtu >= 1500;
+    MtuDiscovery->HasProbedMax = FALSE;
+    MtuDiscovery->IsSearchComplete = FALSE;
     CXPLAT_DBG_ASSERT(Path->Mtu <= MtuDiscovery->MaxMtu);
 
     QuicTraceLogConnInfo(
@@ -204,6 +245,15 @@ QuicMtuDiscoveryOnAckedPacket(
     // higher, otherwise attept next MTU size.
     //
     Path->Mtu = MtuDiscovery->ProbeSize;
+    if (MtuDiscovery->IsRaising) {
+        //
+        // The path now allows more than it did before. Search the whole range
+        // again.
+        //
+        MtuDiscovery->IsRaising = FALSE;
+        MtuDiscovery->SearchHigh = MtuDiscovery->MaxMtu;
+        MtuDiscovery->HasProbedMax = FALSE;
+    }
     QuicTraceLogConnInfo(
         PathMtuUpdated,
         Connection,
@@ -253,14 +303,55 @@ QuicMtuDiscoveryProbePacketDiscarded(
         MtuDiscovery->ProbeCount);
 
     //
-    // If we've done max probes, we've found our max, enter search complete
-    // waiting phase. Otherwise send out another probe of the same size.
+    // If we've done max probes, this size is too large. Narrow the search to
+    // below it, or enter search complete waiting phase if this was the min MTU
+    // or a re-raise attempt. Otherwise send out another probe of the same size.
     //
     if (MtuDiscovery->ProbeCount >=
             (int16_t)Connection->Settings.MtuDiscoveryMissingProbeCount - 1) {
-        QuicMtuDiscoveryMoveToSearchComplete(MtuDiscovery, Connection);
+        if (!Path->IsMinMtuValidated || MtuDiscovery->IsRaising) {
+            MtuDiscovery->IsRaising = FALSE;
+            QuicMtuDiscoveryMoveToSearchComplete(MtuDiscovery, Connection);
+            return;
+        }
+        CXPLAT_DBG_ASSERT(MtuDiscovery->ProbeSize > Path->Mtu);
+        MtuDiscovery->SearchHigh = MtuDiscovery->ProbeSize - 1;
+        QuicMtuDiscoveryMoveToSearching(MtuDiscovery, Connection);
         return;
     }
     MtuDiscovery->ProbeCount++;
     QuicMtuDiscoverySendProbePacket(Connection);
 }
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicMtuDiscoveryOnBlackHoleDetected(
+    _In_ QUIC_MTU_DISCOVERY* MtuDiscovery,
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    QUIC_PATH* Path =
+        CXPLAT_CONTAINING_RECORD(MtuDiscovery, QUIC_PATH, MtuDiscovery);
+    if (!Path->IsMinMtuValidated ||
+        Path->Mtu <= Connection->Settings.MinimumMtu) {
+        return;
+    }
+
+    //
+    // The current MTU stopped working. Drop back to the minimum MTU, which
+    // is assumed to always work, and search again below the failed size.
+    //
+    MtuDiscovery->SearchHigh = Path->Mtu - 1;
+    MtuDiscovery->HasProbedMax = TRUE;
+    MtuDiscovery->IsSearchComplete = FALSE;
+    Path->Mtu = Connection->Settings.MinimumMtu;
+    QuicTraceLogConnInfo(
+        PathMtuUpdated,
+        Connection,
+        "Path[%hhu] MTU updated to %hu bytes",
+        Path->ID,
+        Path->Mtu);
+
+    QuicDatagramOnSendStateChanged(&Connection->Datagram);
+    QuicMtuDiscoveryMoveToSearching(MtuDiscovery, Connection);
+}
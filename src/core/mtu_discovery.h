@@ -22,6 +22,11 @@ typedef struct QUIC_MTU_DISCOVERY {
     //
     uint16_t ProbeSize;
 
+    //
+    // The largest MTU not yet known to fail; the upper bound of the search.
+    //
+    uint16_t SearchHigh;
+
     //
     // The amount of probes that have occured at the current size.
     //
@@ -37,6 +42,16 @@ typedef struct QUIC_MTU_DISCOVERY {
     //
     BOOLEAN HasProbed1500       : 1;
 
+    //
+    // Check for has the top of the search range been probed yet.
+    //
+    BOOLEAN HasProbedMax        : 1;
+
+    //
+    // Is the current probe a re-raise attempt out of Search Complete.
+    //
+    BOOLEAN IsRaising           : 1;
+
 } QUIC_MTU_DISCOVERY;
 
 //
@@ -80,3 +95,13 @@ QuicMtuDiscoveryProbePacketDiscarded(
     _In_ QUIC_CONNECTION* Connection,
     _In_ uint16_t PacketMtu
     );
+
+//
+// Fall back to the minimum MTU after full-size packets were black holed.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicMtuDiscoveryOnBlackHoleDetected(
+    _In_ QUIC_MTU_DISCOVERY* MtuDiscovery,
+    _In_ QUIC_CONNECTION* Connection
+    );
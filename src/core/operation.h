@@ -183,6 +183,7 @@ typedef enum QUIC_CONN_TIMER_TYPE {
     QUIC_CONN_TIMER_LOSS_DETECTION,
     QUIC_CONN_TIMER_KEEP_ALIVE,
     QUIC_CONN_TIMER_IDLE,
+    QUIC_CONN_TIMER_PATH,
     QUIC_CONN_TIMER_SHUTDOWN,
 
     QUIC_CONN_TIMER_COUNT
@@ -676,15 +676,65 @@ QuicPacketBuilderPrepareForStreamFrames(
     return QuicPacketBuilderPrepare(Builder, PacketKeyType, IsTailLossProbe, FALSE);
 }
 
+//
+// Encrypts and then applies header protection to all the batched short header
+// packets. Returns FALSE if there was a fatal error.
+//
 _IRQL_requires_max_(PASSIVE_LEVEL)
-void
-QuicPacketBuilderFinalizeHeaderProtection(
+BOOLEAN
+QuicPacketBuilderFinalizeBatch(
     _Inout_ QUIC_PACKET_BUILDER* Builder
     )
 {
     CXPLAT_DBG_ASSERT(Builder->Key != NULL);
+    CXPLAT_DBG_ASSERT(Builder->BatchCount != 0);
+
+    //
+    // Short headers all have the same length: the destination CID and a
+    // fixed length packet number follow the first byte.
+    //
+    const uint16_t PnOffset = 1 + Builder->Path->DestCid->CID.Length;
+    const uint16_t HeaderLength = PnOffset + Builder->PacketNumberLength;
 
     QUIC_STATUS Status;
+    for (uint8_t i = 0; i < Builder->BatchCount; ++i) {
+        uint8_t Iv[CXPLAT_MAX_IV_LENGTH];
+        QuicCryptoCombineIvAndPacketNumber(
+            Builder->Key->Iv,
+            (uint8_t*)&Builder->PacketNumberBatch[i],
+            Iv);
+
+        if (QUIC_FAILED(
+            Status =
+            CxPlatEncrypt(
+                Builder->Key->PacketKey,
+                Iv,
+                HeaderLength,
+                Builder->HeaderBatch[i],
+                Builder->PayloadLengthBatch[i],
+                Builder->HeaderBatch[i] + HeaderLength))) {
+            Builder->BatchCount = 0;
+            QuicConnFatalError(Builder->Connection, Status, "Encryption failure");
+            return FALSE;
+        }
+    }
+
+    if (!Builder->Connection->State.HeaderProtectionEnabled) {
+        Builder->BatchCount = 0;
+        return TRUE;
+    }
+
+    //
+    // The header protection sample starts 4 bytes after the start of the
+    // packet number.
+    //
+    for (uint8_t i = 0; i < Builder->BatchCount; ++i) {
+        CxPlatCopyMemory(
+            Builder->CipherBatch + i * CXPLAT_HP_SAMPLE_LENGTH,
+            Builder->HeaderBatch[i] + PnOffset + 4,
+            CXPLAT_HP_SAMPLE_LENGTH);
+    }
+
     if (QUIC_FAILED(
         Status =
         CxPlatHpComputeMask(
@@ -693,21 +743,23 @@ QuicPacketBuilderFinalizeHeaderProtection(
             Builder->CipherBatch,
             Builder->HpMask))) {
         CXPLAT_TEL_ASSERT(FALSE);
+        Builder->BatchCount = 0;
         QuicConnFatalError(Builder->Connection, Status, "HP failure");
-        return;
+        return FALSE;
     }
 
     for (uint8_t i = 0; i < Builder->BatchCount; ++i) {
         uint16_t Offset = i * CXPLAT_HP_SAMPLE_LENGTH;
         uint8_t* Header = Builder->HeaderBatch[i];
         Header[0] ^= (Builder->HpMask[Offset] & 0x1f); // Bottom 5 bits for SH
-        Header += 1 + Builder->Path->DestCid->CID.Length;
+        Header += PnOffset;
         for (uint8_t j = 0; j < Builder->PacketNumberLength; ++j) {
             Header[j] ^= Builder->HpMask[Offset + 1 + j];
         }
     }
 
     Builder->BatchCount = 0;
+    return TRUE;
 }
 
 //
@@ -728,6 +780,7 @@ QuicPacketBuilderFinalize(
     QUIC_CONNECTION* Connection = Builder->Connection;
     BOOLEAN FinalQuicPacket = FALSE;
     BOOLEAN CanKeepSending = TRUE;
+    BOOLEAN EncryptionFailed = FALSE;
 
     QuicPacketBuilderValidate(Builder, FALSE);
 
@@ -859,56 +912,67 @@ QuicPacketBuilderFinalize(
 
         uint8_t* Payload = Header + Builder->HeaderLength;
 
-        uint8_t Iv[CXPLAT_MAX_IV_LENGTH];
-        QuicCryptoCombineIvAndPacketNumber(Builder->Key->Iv, (uint8_t*) &Builder->Metadata->PacketNumber, Iv);
-
         QUIC_STATUS Status;
-        if (QUIC_FAILED(
-            Status =
-            CxPlatEncrypt(
-                Builder->Key->PacketKey,
-                Iv,
-                Builder->HeaderLength,
-                Header,
-                PayloadLength,
-                Payload))) {
-            QuicConnFatalError(Connection, Status, "Encryption failure");
-            goto Exit;
-        }
+        if (Builder->PacketType == SEND_PACKET_SHORT_HEADER_TYPE) {
+            CXPLAT_DBG_ASSERT(Builder->BatchCount < QUIC_MAX_CRYPTO_BATCH_COUNT);
 
-        QuicTraceEvent(
-            PacketFinalize,
-            "[pack][%llu] Finalizing",
-            Builder->Metadata->PacketId);
+            //
+            // Batch the encryption and header protection for short header
+            // packets. They all use the same key, and the datagrams stay
+            // owned by the send data until the batch is sent.
+            //
 
-        if (Connection->State.HeaderProtectionEnabled) {
+            CXPLAT_DBG_ASSERT(
+                Builder->HeaderLength ==
+                1 + Builder->Path->DestCid->CID.Length + Builder->PacketNumberLength);
+            Builder->PacketNumberBatch[Builder->BatchCount] = Builder->Metadata->PacketNumber;
+            Builder->PayloadLengthBatch[Builder->BatchCount] = PayloadLength;
+            Builder->HeaderBatch[Builder->BatchCount] = Header;
 
-            uint8_t* PnStart = Payload - Builder->PacketNumberLength;
+            QuicTraceEvent(
+                PacketFinalize,
+                "[pack][%llu] Finalizing",
+                Builder->Metadata->PacketId);
 
-            if (Builder->PacketType == SEND_PACKET_SHORT_HEADER_TYPE) {
-                CXPLAT_DBG_ASSERT(Builder->BatchCount < QUIC_MAX_CRYPTO_BATCH_COUNT);
+            if (++Builder->BatchCount == QUIC_MAX_CRYPTO_BATCH_COUNT &&
+                !QuicPacketBuilderFinalizeBatch(Builder)) {
+                EncryptionFailed = TRUE;
+                goto Exit;
+            }
 
-                //
-                // Batch the header protection for short header packets.
-                //
+        } else {
+            CXPLAT_DBG_ASSERT(Builder->BatchCount == 0);
 
-                CxPlatCopyMemory(
-                    Builder->CipherBatch + Builder->BatchCount * CXPLAT_HP_SAMPLE_LENGTH,
-                    PnStart + 4,
-                    CXPLAT_HP_SAMPLE_LENGTH);
-                Builder->HeaderBatch[Builder->BatchCount] = Header;
+            //
+            // Individually encrypt and do header protection for long header
+            // packets as they generally use different keys.
+            //
 
-                if (++Builder->BatchCount == QUIC_MAX_CRYPTO_BATCH_COUNT) {
-                    QuicPacketBuilderFinalizeHeaderProtection(Builder);
-                }
+            uint8_t Iv[CXPLAT_MAX_IV_LENGTH];
+            QuicCryptoCombineIvAndPacketNumber(Builder->Key->Iv, (uint8_t*) &Builder->Metadata->PacketNumber, Iv);
+
+            if (QUIC_FAILED(
+                Status =
+                CxPlatEncrypt(
+                    Builder->Key->PacketKey,
+                    Iv,
+                    Builder->HeaderLength,
+                    Header,
+                    PayloadLength,
+                    Payload))) {
+                QuicConnFatalError(Connection, Status, "Encryption failure");
+                EncryptionFailed = TRUE;
+                goto Exit;
+            }
 
-            } else {
-                CXPLAT_DBG_ASSERT(Builder->BatchCount == 0);
+            QuicTraceEvent(
+                PacketFinalize,
+                "[pack][%llu] Finalizing",
+                Builder->Metadata->PacketId);
 
-                //
-                // Individually do header protection for long header packets as
-                // they generally use different keys.
-                //
+            if (Connection->State.HeaderProtectionEnabled) {
+
+                uint8_t* PnStart = Payload - Builder->PacketNumberLength;
 
                 if (QUIC_FAILED(
                     Status =
@@ -919,6 +983,7 @@ QuicPacketBuilderFinalize(
                         Builder->HpMask))) {
                     CXPLAT_TEL_ASSERT(FALSE);
                     QuicConnFatalError(Connection, Status, "HP failure");
+                    EncryptionFailed = TRUE;
                     goto Exit;
                 }
 
@@ -945,6 +1010,15 @@ QuicPacketBuilderFinalize(
             !PacketSpace->AwaitingKeyPhaseConfirmation &&
             Connection->State.HandshakeConfirmed) {
 
+            //
+            // Packets already batched must be encrypted with the current key.
+            //
+            if (Builder->BatchCount != 0 &&
+                !QuicPacketBuilderFinalizeBatch(Builder)) {
+                EncryptionFailed = TRUE;
+                goto Exit;
+            }
+
             Status = QuicCryptoGenerateNewKeys(Connection);
             if (QUIC_FAILED(Status)) {
                 QuicTraceEvent(
@@ -1018,7 +1092,24 @@ Exit:
     // Send the packet out if necessary.
     //
 
-    if (FinalQuicPacket) {
+    if (EncryptionFailed) {
+        //
+        // The send data may hold datagrams that never got (fully) encrypted,
+        // so none of it can go out. The connection has already been failed.
+        //
+        if (Builder->Datagram != NULL) {
+            CxPlatSendDataFreeBuffer(Builder->SendData, Builder->Datagram);
+            Builder->Datagram = NULL;
+            Builder->DatagramLength = 0;
+        }
+        if (Builder->SendData != NULL) {
+            CxPlatSendDataFree(Builder->SendData);
+            Builder->SendData = NULL;
+        }
+        Builder->BatchCount = 0;
+        CanKeepSending = FALSE;
+
+    } else if (FinalQuicPacket) {
         if (Builder->Datagram != NULL) {
             if (Builder->Metadata->Flags.EcnEctSet) {
                 ++Connection->Send.NumPacketsSentWithEct;
@@ -1031,16 +1122,24 @@ Exit:
         }
 
         if (FlushBatchedDatagrams || CxPlatSendDataIsFull(Builder->SendData)) {
-            if (Builder->BatchCount != 0) {
-                QuicPacketBuilderFinalizeHeaderProtection(Builder);
+            if (Builder->BatchCount != 0 &&
+                !QuicPacketBuilderFinalizeBatch(Builder)) {
+                //
+                // Don't send out a partially encrypted batch. The connection
+                // has already been failed.
+                //
+                CxPlatSendDataFree(Builder->SendData);
+                Builder->SendData = NULL;
+                CanKeepSending = FALSE;
+            } else {
+                CXPLAT_DBG_ASSERT(Builder->TotalCountDatagrams > 0);
+                QuicPacketBuilderSendBatch(Builder);
+                CXPLAT_DBG_ASSERT(Builder->Metadata->FrameCount == 0);
+                QuicTraceEvent(
+                    PacketBatchSent,
+                    "[pack][%llu] Batch sent",
+                    Builder->BatchId);
             }
-            CXPLAT_DBG_ASSERT(Builder->TotalCountDatagrams > 0);
-            QuicPacketBuilderSendBatch(Builder);
-            CXPLAT_DBG_ASSERT(Builder->Metadata->FrameCount == 0);
-            QuicTraceEvent(
-                PacketBatchSent,
-                "[pack][%llu] Batch sent",
-                Builder->BatchId);
         }
 
         if ((Connection->Stats.QuicVersion != QUIC_VERSION_2 && Builder->PacketType == QUIC_RETRY_V1) ||
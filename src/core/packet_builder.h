@@ -41,6 +41,13 @@ typedef struct QUIC_PACKET_BUILDER {
     //
     QUIC_PACKET_KEY* Key;
 
+    //
+    // Packet numbers and payload lengths (including the AEAD tag) of the
+    // batched short header packets, still to be encrypted.
+    //
+    uint64_t PacketNumberBatch[QUIC_MAX_CRYPTO_BATCH_COUNT];
+    uint16_t PayloadLengthBatch[QUIC_MAX_CRYPTO_BATCH_COUNT];
+
     //
     // Cipher text across multiple packets to batch header protection.
     //
@@ -69,7 +76,7 @@ typedef struct QUIC_PACKET_BUILDER {
     uint8_t PacketBatchRetransmittable : 1;
 
     //
-    // The number of batched packets to do header protection on.
+    // The number of batched packets to do encryption and header protection on.
     //
     uint8_t BatchCount : 4;
 
@@ -38,6 +38,7 @@ QuicPacketSpaceInitialize(
     Packets->Connection = Connection;
     Packets->EncryptLevel = EncryptLevel;
     QuicAckTrackerInitialize(&Packets->AckTracker);
+    QuicConnUpdateMemoryUsage(Connection, sizeof(QUIC_PACKET_SPACE));
 
     *NewPackets = Packets;
 
@@ -62,6 +63,7 @@ QuicPacketSpaceUninitialize(
     }
 
     QuicAckTrackerUninitialize(&Packets->AckTracker);
+    QuicConnUpdateMemoryUsage(Packets->Connection, -(int64_t)sizeof(QUIC_PACKET_SPACE));
     CxPlatPoolFree(Packets);
 }
 
@@ -99,6 +99,21 @@ typedef struct QUIC_CACHEALIGN QUIC_PARTITION {
     //
     int64_t PerfCounters[QUIC_PERF_COUNTER_MAX];
 
+    //
+    // Per-processor share of the estimated buffer memory usage, summed when
+    // checked against MsQuicLib.BufferMemoryLimit. Memory may be released on a
+    // different partition than it was charged on, so only the sum is
+    // meaningful; a single partition's value may be negative.
+    //
+    int64_t BufferMemoryUsage;
+
+#ifdef QUIC_PROFILING_ENABLED
+    //
+    // Per-processor hot path cycle counters.
+    //
+    QUIC_PROFILE_COUNTER ProfileCounters[QUIC_PROFILE_STAGE_MAX];
+#endif
+
 } QUIC_PARTITION;
 
 //
@@ -189,6 +204,68 @@ QuicPerfCounterAdd(
 #define QuicPerfCounterIncrement(Partition, Type) QuicPerfCounterAdd(Partition, Type, 1)
 #define QuicPerfCounterDecrement(Partition, Type) QuicPerfCounterAdd(Partition, Type, -1)
 
+#ifdef QUIC_PROFILING_ENABLED
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define QuicProfileTimestamp() __rdtsc()
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+#include <intrin.h>
+#define QuicProfileTimestamp() ((uint64_t)_ReadStatusReg(ARM64_CNTVCT))
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define QuicProfileTimestamp() __rdtsc()
+#elif defined(__aarch64__)
+QUIC_INLINE
+uint64_t
+QuicProfileTimestamp(
+    void
+    )
+{
+    uint64_t Value;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(Value));
+    return Value;
+}
+#else
+#define QuicProfileTimestamp() CxPlatTimeUs64()
+#endif
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_INLINE
+void
+QuicProfileCounterAdd(
+    _In_ QUIC_PARTITION* Partition,
+    _In_ QUIC_PROFILE_STAGE Stage,
+    _In_ uint64_t Cycles
+    )
+{
+    CXPLAT_DBG_ASSERT(Stage >= 0 && Stage < QUIC_PROFILE_STAGE_MAX);
+    //
+    // Only ever updated from the partition's own processor, so contention is
+    // rare; the interlocked ops just keep concurrent readers consistent.
+    //
+    InterlockedExchangeAdd64(
+        (int64_t*)&Partition->ProfileCounters[Stage].Cycles, (int64_t)Cycles);
+    InterlockedIncrement64((int64_t*)&Partition->ProfileCounters[Stage].Calls);
+}
+
+//
+// Scoped cycle counting of a hot path. BEGIN and END must be used in the same
+// scope with the same Stage.
+//
+#define QUIC_PROFILE_BEGIN(Stage) \
+    const uint64_t QuicProfileStart_##Stage = QuicProfileTimestamp()
+#define QUIC_PROFILE_END(Partition, Stage) \
+    QuicProfileCounterAdd( \
+        Partition, Stage, QuicProfileTimestamp() - QuicProfileStart_##Stage)
+
+#else
+
+#define QUIC_PROFILE_BEGIN(Stage)
+#define QUIC_PROFILE_END(Partition, Stage)
+
+#endif // QUIC_PROFILING_ENABLED
+
 #if defined(__cplusplus)
 }
 #endif
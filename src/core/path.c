@@ -74,6 +74,11 @@ QuicPathRemove(
     }
 #endif
 
+    if (Path->OwnsBinding) {
+        QuicBindingDetachPathConnection(Path->Binding, Connection);
+        QuicLibraryReleaseBinding(Path->Binding);
+    }
+
     if (Index + 1 < Connection->PathsCount) {
         CxPlatMoveMemory(
             Connection->Paths + Index,
@@ -151,7 +156,9 @@ QuicPathSetValid(
         ReasonStrings[Reason]);
 
     Path->IsPeerValidated = TRUE;
+    Path->LastAckTime = CxPlatTimeUs64();
     QuicPathSetAllowance(Connection, Path, UINT32_MAX);
+    QuicConnUpdatePathTimer(Connection);
 
     if (Reason == QUIC_PATH_VALID_PATH_RESPONSE) {
         //
@@ -266,6 +273,7 @@ QuicPathSetActive(
     )
 {
     BOOLEAN UdpPortChangeOnly = FALSE;
+    CXPLAT_DBG_ASSERT(!Path->OwnsBinding);
     if (Path == &Connection->Paths[0]) {
         CXPLAT_DBG_ASSERT(!Path->IsActive);
         Path->IsActive = TRUE;
@@ -288,6 +296,13 @@ QuicPathSetActive(
 
         Connection->Paths[0] = *Path;
         *Path = PrevActivePath;
+
+        //
+        // Black hole evidence gathered on the previous path says nothing about
+        // the new one.
+        //
+        Connection->LossDetection.BlackHoleLossCount = 0;
+        Connection->LossDetection.LargestAckFullSizePacket = 0;
     }
 
     QuicTraceLogConnInfo(
@@ -368,3 +383,323 @@ QuicPathUpdateQeo(
             Path->ID);
     }
 }
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicConnAddLocalPath(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ const QUIC_ADDR* LocalAddress
+    )
+{
+    CXPLAT_DBG_ASSERT(QuicConnIsClient(Connection));
+    CXPLAT_DBG_ASSERT(Connection->State.HandshakeConfirmed);
+
+    if (Connection->PathsCount == QUIC_MAX_PATH_COUNT ||
+        Connection->PeerTransportParams.Flags & QUIC_TP_FLAG_DISABLE_ACTIVE_MIGRATION) {
+        return QUIC_STATUS_INVALID_STATE;
+    }
+
+    //
+    // Each path needs its own CID so the peer can't link them together.
+    //
+    QUIC_CID_LIST_ENTRY* DestCid = QuicConnGetUnusedDestCid(Connection);
+    if (DestCid == NULL) {
+        return QUIC_STATUS_INVALID_STATE;
+    }
+
+    CXPLAT_UDP_CONFIG UdpConfig = {0};
+    UdpConfig.LocalAddress = LocalAddress;
+    UdpConfig.RemoteAddress = &Connection->Paths[0].Route.RemoteAddress;
+    UdpConfig.Flags = CXPLAT_SOCKET_FLAG_NONE;
+    UdpConfig.InterfaceIndex = 0;
+    UdpConfig.PartitionIndex = QuicPartitionIdGetIndex(Connection->PartitionID);
+#ifdef QUIC_COMPARTMENT_ID
+    UdpConfig.CompartmentId = Connection->Configuration->CompartmentId;
+#endif
+#ifdef QUIC_OWNING_PROCESS
+    UdpConfig.OwningProcess = Connection->Configuration->OwningProcess;
+#endif
+
+    QUIC_BINDING* Binding;
+    QUIC_STATUS Status = QuicLibraryGetBinding(&UdpConfig, &Binding);
+    if (QUIC_FAILED(Status)) {
+        return Status;
+    }
+
+    if (!QuicBindingAttachPathConnection(Binding, Connection)) {
+        QuicLibraryReleaseBinding(Binding);
+        return QUIC_STATUS_ADDRESS_IN_USE;
+    }
+
+    if (Connection->PathsCount > 1) {
+        //
+        // Make room for the new path (at index 1).
+        //
+        CxPlatMoveMemory(
+            &Connection->Paths[2],
+            &Connection->Paths[1],
+            (Connection->PathsCount - 1) * sizeof(QUIC_PATH));
+    }
+
+    QUIC_PATH* Path = &Connection->Paths[1];
+    QuicPathInitialize(Connection, Path);
+    Connection->PathsCount++;
+
+    Path->Binding = Binding;
+    Path->OwnsBinding = TRUE;
+    QuicBindingGetLocalAddress(Binding, &Path->Route.LocalAddress);
+    Path->Route.RemoteAddress = Connection->Paths[0].Route.RemoteAddress;
+
+    Path->DestCid = DestCid;
+    QUIC_CID_SET_PATH(Connection, DestCid, Path);
+    DestCid->CID.UsedLocally = TRUE;
+    QuicPathValidate(Path);
+
+    //
+    // The path was created locally rather than from a received packet, so
+    // don't let receive processing treat it as a new peer-initiated path.
+    //
+    Path->GotValidPacket = TRUE;
+    QuicPathSetAllowance(Connection, Path, UINT32_MAX);
+
+    Path->SendChallenge = TRUE;
+    Path->PathValidationStartTime = CxPlatTimeUs64();
+    CxPlatRandom(sizeof(Path->Challenge), Path->Challenge);
+    QuicSendSetSendFlag(&Connection->Send, QUIC_CONN_SEND_FLAG_PATH_CHALLENGE);
+
+    QuicTraceEvent(
+        ConnLocalAddrAdded,
+        "[conn][%p] New Local IP: %!ADDR!",
+        Connection,
+        CASTED_CLOG_BYTEARRAY(sizeof(Path->Route.LocalAddress), &Path->Route.LocalAddress));
+
+    QuicConnUpdatePathTimer(Connection);
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnReleasePathBindings(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ BOOLEAN DetachOnly
+    )
+{
+    for (uint8_t i = 1; i < Connection->PathsCount; ++i) {
+        QUIC_PATH* Path = &Connection->Paths[i];
+        if (!Path->OwnsBinding) {
+            continue;
+        }
+        QuicBindingDetachPathConnection(Path->Binding, Connection);
+        if (!DetachOnly) {
+            QuicLibraryReleaseBinding(Path->Binding);
+            Path->Binding = NULL;
+            Path->OwnsBinding = FALSE;
+        }
+    }
+}
+
+//
+// Scale of the inverse RTT weights used by the weighted path scheduler.
+//
+#define QUIC_PATH_WEIGHT_RTT_SCALE  100000000ull
+#define QUIC_PATH_WEIGHT_MAX        100000
+
+//
+// All paths share one packet number space and congestion controller, so only
+// paths whose smoothed RTT is within this multiple of the fastest path's are
+// scheduled on. Packets spread across paths with very different RTTs arrive
+// far enough out of order to look lost.
+//
+#define QUIC_PATH_SCHEDULING_MAX_RTT_RATIO  2
+
+//
+// Returns the latest time a packet sent on any validated path was acknowledged.
+//
+static
+uint64_t
+QuicConnGetLatestPathAckTime(
+    _In_ const QUIC_CONNECTION* Connection
+    )
+{
+    uint64_t LatestAckTime = 0;
+    for (uint8_t i = 0; i < Connection->PathsCount; ++i) {
+        if (Connection->Paths[i].IsPeerValidated &&
+            LatestAckTime < Connection->Paths[i].LastAckTime) {
+            LatestAckTime = Connection->Paths[i].LastAckTime;
+        }
+    }
+    return LatestAckTime;
+}
+
+QUIC_INLINE
+BOOLEAN
+QuicPathIsStale(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ const QUIC_PATH* Path,
+    _In_ uint64_t LatestAckTime
+    )
+{
+    return
+        CxPlatTimeDiff64(Path->LastAckTime, LatestAckTime) >
+        QuicLossDetectionComputeProbeTimeout(
+            &Connection->LossDetection, Path, QUIC_CLOSE_PTO_COUNT);
+}
+
+static
+BOOLEAN
+QuicPathIsSchedulable(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ const QUIC_PATH* Path,
+    _In_ uint64_t LatestAckTime
+    )
+{
+    if (!Path->IsPeerValidated ||
+        Path->DestCid == NULL ||
+        Path->Route.State != RouteResolved) {
+        return FALSE;
+    }
+
+    //
+    // Other paths are being acknowledged but this one hasn't been for a while.
+    // The path timer revalidates it.
+    //
+    return !QuicPathIsStale(Connection, Path, LatestAckTime);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_PATH*
+QuicConnGetPathForSend(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    QUIC_PATH* ActivePath = &Connection->Paths[0];
+
+    //
+    // Only 1-RTT traffic is spread across paths, and MTU probes are always for
+    // the active path.
+    //
+    if (Connection->PathSchedulingScheme == QUIC_PATH_SCHEDULING_SCHEME_ACTIVE ||
+        Connection->PathsCount == 1 ||
+        !Connection->State.HandshakeConfirmed ||
+        ActivePath->EncryptionOffloading ||
+        (Connection->Send.SendFlags & QUIC_CONN_SEND_FLAG_DPLPMTUD)) {
+        return ActivePath;
+    }
+
+    const uint64_t LatestAckTime = QuicConnGetLatestPathAckTime(Connection);
+
+    BOOLEAN Schedulable[QUIC_MAX_PATH_COUNT];
+    uint64_t MinSmoothedRtt = UINT64_MAX;
+    for (uint8_t i = 0; i < Connection->PathsCount; ++i) {
+        QUIC_PATH* Path = &Connection->Paths[i];
+        Schedulable[i] = QuicPathIsSchedulable(Connection, Path, LatestAckTime);
+        if (Schedulable[i] && MinSmoothedRtt > Path->SmoothedRtt) {
+            MinSmoothedRtt = Path->SmoothedRtt;
+        }
+    }
+
+    QUIC_PATH* BestPath = NULL;
+    int32_t TotalWeight = 0;
+    for (uint8_t i = 0; i < Connection->PathsCount; ++i) {
+        QUIC_PATH* Path = &Connection->Paths[i];
+        if (!Schedulable[i] ||
+            Path->SmoothedRtt > MinSmoothedRtt * QUIC_PATH_SCHEDULING_MAX_RTT_RATIO) {
+            Path->SchedulerWeight = 0;
+            continue;
+        }
+
+        if (Connection->PathSchedulingScheme == QUIC_PATH_SCHEDULING_SCHEME_MIN_RTT) {
+            if (BestPath == NULL || Path->SmoothedRtt < BestPath->SmoothedRtt) {
+                BestPath = Path;
+            }
+
+        } else {
+            //
+            // Smooth weighted round robin, with each path weighted by the
+            // inverse of its RTT.
+            //
+            uint64_t Weight = QUIC_PATH_WEIGHT_RTT_SCALE / CXPLAT_MAX(Path->SmoothedRtt, 1);
+            Weight = CXPLAT_MAX(CXPLAT_MIN(Weight, QUIC_PATH_WEIGHT_MAX), 1);
+            Path->SchedulerWeight += (int32_t)Weight;
+            TotalWeight += (int32_t)Weight;
+            if (BestPath == NULL || Path->SchedulerWeight > BestPath->SchedulerWeight) {
+                BestPath = Path;
+            }
+        }
+    }
+
+    if (BestPath == NULL) {
+        return ActivePath;
+    }
+
+    BestPath->SchedulerWeight -= TotalWeight;
+    return BestPath;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnUpdatePathTimer(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    if (QuicConnIsClosed(Connection) ||
+        Connection->PathSchedulingScheme == QUIC_PATH_SCHEDULING_SCHEME_ACTIVE ||
+        Connection->PathsCount == 1) {
+        QuicConnTimerCancel(Connection, QUIC_CONN_TIMER_PATH);
+    } else if (Connection->ExpirationTimes[QUIC_CONN_TIMER_PATH] == UINT64_MAX) {
+        QuicConnTimerSet(
+            Connection,
+            QUIC_CONN_TIMER_PATH,
+            QuicLossDetectionComputeProbeTimeout(
+                &Connection->LossDetection, &Connection->Paths[0], 1));
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnProcessPathTimerOperation(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    const uint64_t TimeNow = CxPlatTimeUs64();
+    const uint64_t LatestAckTime = QuicConnGetLatestPathAckTime(Connection);
+
+    //
+    // The active path is left alone: it is what everything falls back to, and
+    // its validation is handled by the usual migration logic.
+    //
+    for (uint8_t i = 1; i < Connection->PathsCount; ++i) {
+        QUIC_PATH* Path = &Connection->Paths[i];
+        if (Path->IsPeerValidated) {
+            if (QuicPathIsStale(Connection, Path, LatestAckTime)) {
+                //
+                // Stop scheduling on the path and revalidate it.
+                //
+                Path->IsPeerValidated = FALSE;
+                Path->SendChallenge = TRUE;
+                Path->PathValidationStartTime = TimeNow;
+                CxPlatRandom(sizeof(Path->Challenge), Path->Challenge);
+                QuicSendSetSendFlag(&Connection->Send, QUIC_CONN_SEND_FLAG_PATH_CHALLENGE);
+            }
+            continue;
+        }
+
+        const uint64_t ValidationTimeout =
+            CXPLAT_MAX(
+                QuicLossDetectionComputeProbeTimeout(&Connection->LossDetection, Path, 3),
+                6 * MS_TO_US(Connection->Settings.InitialRttMs));
+        if (CxPlatTimeDiff64(Path->PathValidationStartTime, TimeNow) > ValidationTimeout) {
+            QuicTraceLogConnInfo(
+                PathValidationTimeout,
+                Connection,
+                "Path[%hhu] validation timed out",
+                Path->ID);
+            QuicPerfCounterIncrement(
+                Connection->Partition, QUIC_PERF_COUNTER_PATH_FAILURE);
+            QuicPathRemove(Connection, i--);
+        }
+    }
+
+    QuicConnUpdatePathTimer(Connection);
+}
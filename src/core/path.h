@@ -116,6 +116,17 @@ typedef struct QUIC_PATH {
     //
     BOOLEAN EncryptionOffloading : 1;
 
+    //
+    // Indicates the path was added locally and owns an exclusive binding,
+    // separate from the active path's.
+    //
+    BOOLEAN OwnsBinding : 1;
+
+    //
+    // Running weight used by the weighted path scheduler.
+    //
+    int32_t SchedulerWeight;
+
     //
     // The ending time of ECN validation testing state in microseconds.
     //
@@ -131,6 +142,13 @@ typedef struct QUIC_PATH {
     //
     uint16_t LocalMtu;
 
+    //
+    // Used on the server side until the client's IP address has been validated
+    // to prevent the server from being used for amplification attacks. A value
+    // of UINT32_MAX indicates this variable does not apply.
+    //
+    uint32_t Allowance;
+
     //
     // MTU Discovery logic.
     //
@@ -162,13 +180,6 @@ typedef struct QUIC_PATH {
     uint64_t OneWayDelay;
     uint64_t OneWayDelayLatest;
 
-    //
-    // Used on the server side until the client's IP address has been validated
-    // to prevent the server from being used for amplification attacks. A value
-    // of UINT32_MAX indicates this variable does not apply.
-    //
-    uint32_t Allowance;
-
     //
     // The last path challenge we received and needs to be sent back as in a
     // PATH_RESPONSE frame.
@@ -185,6 +196,19 @@ typedef struct QUIC_PATH {
     //
     uint64_t PathValidationStartTime;
 
+    //
+    // The last time a packet sent on this path was acknowledged (or the path
+    // was validated). Used to detect stale paths when sending on more than
+    // just the active path.
+    //
+    uint64_t LastAckTime;
+
+    //
+    // The largest packet number sent on this path that has been acknowledged.
+    // Used for loss detection when sending on more than just the active path.
+    //
+    uint64_t LargestAckedPacketNumber;
+
 } QUIC_PATH;
 
 #if DEBUG
@@ -304,6 +328,57 @@ QuicConnGetPathForPacket(
     _In_ const QUIC_RX_PACKET* Packet
     );
 
+//
+// Adds a new path from the given local address to the active path's remote
+// address, and starts validating it. Client only.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicConnAddLocalPath(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ const QUIC_ADDR* LocalAddress
+    );
+
+//
+// Releases the bindings owned by locally added paths.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnReleasePathBindings(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ BOOLEAN DetachOnly
+    );
+
+//
+// Picks the path the next send flush goes out on, according to the
+// connection's path scheduling scheme.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_PATH*
+QuicConnGetPathForSend(
+    _In_ QUIC_CONNECTION* Connection
+    );
+
+//
+// Arms the path timer while sends are spread over more than one path, and
+// cancels it otherwise.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnUpdatePathTimer(
+    _In_ QUIC_CONNECTION* Connection
+    );
+
+//
+// Revalidates secondary paths that stopped being acknowledged and removes
+// the ones whose validation timed out.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnProcessPathTimerOperation(
+    _In_ QUIC_CONNECTION* Connection
+    );
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicCopyRouteInfo(
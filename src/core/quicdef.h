@@ -190,6 +190,11 @@ typedef struct QUIC_RX_PACKET QUIC_RX_PACKET;
 //
 #define QUIC_STREAM_SEND_BATCH_COUNT            8
 
+//
+// The largest send deadline (in us) an app may set on a stream. One day.
+//
+#define QUIC_MAX_STREAM_SEND_DEADLINE_US        (24ULL * 60 * 60 * 1000 * 1000)
+
 //
 // The maximum number of received packets to batch process at a time.
 //
@@ -340,6 +345,18 @@ CXPLAT_STATIC_ASSERT(
 //
 #define QUIC_RECV_BUFFER_DRAIN_RATIO            4
 
+//
+// The largest connection flow control window receive window auto-tuning will
+// grow to, in bytes.
+//
+#define QUIC_MAX_AUTO_TUNE_CONN_FLOW_CONTROL_WINDOW 0x10000000  // 256MB
+
+//
+// The fraction (1 / divisor) of system memory that auto-tuned receive window
+// growth may use across all connections.
+//
+#define QUIC_RECV_WINDOW_AUTO_TUNE_MEMORY_DIVISOR   16
+
 //
 // The default value for send buffering being enabled or not.
 //
@@ -356,6 +373,23 @@ CXPLAT_STATIC_ASSERT(
 //
 #define QUIC_MAX_IDEAL_SEND_BUFFER_SIZE         0x8000000 // 134217728
 
+//
+// The smallest ideal send buffer size (in bytes) the connection will shrink
+// down to once it has a pacing rate estimate.
+//
+#define QUIC_MIN_IDEAL_SEND_BUFFER_SIZE         0x4000 // 16384
+
+//
+// The default amount of queuing delay (in milliseconds), on top of the RTT,
+// the ideal send buffer is sized to cover at the current pacing rate.
+//
+#define QUIC_DEFAULT_SEND_BUFFER_LATENCY_TARGET_MS  25
+
+//
+// The max send buffer latency target (in milliseconds).
+//
+#define QUIC_MAX_SEND_BUFFER_LATENCY_TARGET_MS      10000
+
 //
 // The minimum number of bytes of send allowance we must have before we will
 // send another packet.
@@ -501,9 +535,22 @@ CXPLAT_STATIC_ASSERT(
 #define QUIC_DPLPMTUD_RAISE_TIMER_TIMEOUT           S_TO_US(600)
 
 //
-// The amount of bytes to increase our PLMTU each probe
+// The DPLPMTUD binary search stops once the range between the acknowledged MTU
+// and the smallest failed probe size is narrower than this many bytes.
+//
+#define QUIC_DPLPMTUD_SEARCH_PRECISION              32
+
+//
+// The number of consecutive full-size packets lost, with no later full-size
+// packet acknowledged, before the path MTU is considered black holed.
 //
-#define QUIC_DPLPMTUD_INCREMENT                     80
+#define QUIC_DPLPMTUD_BLACKHOLE_LOSS_COUNT          3
+
+//
+// The number of consecutive probe timeouts before the path MTU is considered
+// black holed, if enough full-size packets are also unacknowledged.
+//
+#define QUIC_DPLPMTUD_BLACKHOLE_PROBE_COUNT         3
 
 //
 // The default congestion control algorithm
@@ -565,6 +612,11 @@ CXPLAT_STATIC_ASSERT(
 //
 #define QUIC_DEFAULT_STREAM_MULTI_RECEIVE_ENABLED    FALSE
 
+//
+// The default settings for auto-tuning the connection receive window.
+//
+#define QUIC_DEFAULT_RECV_WINDOW_AUTO_TUNE_ENABLED   FALSE
+
 //
 // The number of rounds in Cubic Slow Start to sample RTT.
 //
@@ -692,6 +744,8 @@ CXPLAT_STATIC_ASSERT(
 #define QUIC_SETTING_STREAM_FC_BIDI_LOCAL_WINDOW_SIZE "StreamRecvWindowBidiLocalDefault"
 #define QUIC_SETTING_STREAM_FC_BIDI_REMOTE_WINDOW_SIZE "StreamRecvWindowBidiRemoteDefault"
 #define QUIC_SETTING_STREAM_FC_UNIDI_WINDOW_SIZE    "StreamRecvWindowUnidiDefault"
+#define QUIC_SETTING_SEND_BUFFER_LATENCY_TARGET_MS  "SendBufferLatencyTargetMs"
+#define QUIC_SETTING_RECV_WINDOW_AUTO_TUNE_ENABLED  "RecvWindowAutoTuneEnabled"
 #define QUIC_SETTING_STREAM_RECV_BUFFER_SIZE        "StreamRecvBufferDefault"
 #define QUIC_SETTING_CONN_FLOW_CONTROL_WINDOW       "ConnFlowControlWindow"
 
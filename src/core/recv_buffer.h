@@ -135,6 +135,15 @@ QuicRecvBufferGetTotalLength(
     _In_ QUIC_RECV_BUFFER* RecvBuffer
     );
 
+//
+// Get the total length of memory allocated for the receive buffer chunks.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+QuicRecvBufferGetTotalAllocLength(
+    _In_ QUIC_RECV_BUFFER* RecvBuffer
+    );
+
 //
 // Returns TRUE there is any unread data in the receive buffer.
 //
@@ -73,6 +73,26 @@ MsQuicRegistrationOpen(
     }
 
     CxPlatZeroMemory(Registration, RegistrationSize);
+
+    Registration->MemoryUsage =
+        CXPLAT_ALLOC_NONPAGED(
+            sizeof(QUIC_REGISTRATION_MEMORY_USAGE) * MsQuicLib.PartitionCount,
+            QUIC_POOL_REGISTRATION_MEMORY);
+    if (Registration->MemoryUsage == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "registration memory usage",
+            sizeof(QUIC_REGISTRATION_MEMORY_USAGE) * MsQuicLib.PartitionCount);
+        CXPLAT_FREE(Registration, QUIC_POOL_REGISTRATION);
+        Registration = NULL;
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        goto Error;
+    }
+    CxPlatZeroMemory(
+        Registration->MemoryUsage,
+        sizeof(QUIC_REGISTRATION_MEMORY_USAGE) * MsQuicLib.PartitionCount);
+
     Registration->Type = QUIC_HANDLE_TYPE_REGISTRATION;
     Registration->ExecProfile =
         Config == NULL ? QUIC_EXECUTION_PROFILE_LOW_LATENCY : Config->ExecutionProfile;
@@ -132,6 +152,7 @@ Error:
         CxPlatRundownUninitialize(&Registration->Rundown);
         CxPlatDispatchLockUninitialize(&Registration->ConnectionLock);
         CxPlatLockUninitialize(&Registration->ConfigLock);
+        CXPLAT_FREE(Registration->MemoryUsage, QUIC_POOL_REGISTRATION_MEMORY);
         CXPLAT_FREE(Registration, QUIC_POOL_REGISTRATION);
     }
 
@@ -179,6 +200,7 @@ MsQuicRegistrationClose(
         CxPlatDispatchLockUninitialize(&Registration->ConnectionLock);
         CxPlatLockUninitialize(&Registration->ConfigLock);
 
+        CXPLAT_FREE(Registration->MemoryUsage, QUIC_POOL_REGISTRATION_MEMORY);
         CXPLAT_FREE(Registration, QUIC_POOL_REGISTRATION);
 
         QuicTraceEvent(
@@ -383,9 +405,42 @@ QuicRegistrationParamGet(
         void* Buffer
     )
 {
-    UNREFERENCED_PARAMETER(Registration);
-    UNREFERENCED_PARAMETER(Param);
-    UNREFERENCED_PARAMETER(BufferLength);
-    UNREFERENCED_PARAMETER(Buffer);
-    return QUIC_STATUS_INVALID_PARAMETER;
+    QUIC_STATUS Status;
+
+    switch (Param) {
+    case QUIC_PARAM_REGISTRATION_MEMORY_USAGE: {
+
+        if (*BufferLength < sizeof(uint64_t)) {
+            *BufferLength = sizeof(uint64_t);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        //
+        // The partitions are read without synchronization, so a release may be
+        // seen without the matching charge.
+        //
+        int64_t MemoryUsage = 0;
+        for (uint16_t i = 0; i < MsQuicLib.PartitionCount; ++i) {
+            MemoryUsage += Registration->MemoryUsage[i].Bytes;
+        }
+
+        *BufferLength = sizeof(uint64_t);
+        *(uint64_t*)Buffer = MemoryUsage > 0 ? (uint64_t)MemoryUsage : 0;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+    }
+
+    default:
+        Status = QUIC_STATUS_INVALID_PARAMETER;
+        break;
+    }
+
+    return Status;
 }
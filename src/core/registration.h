@@ -21,6 +21,16 @@ typedef enum QUIC_CONNECTION_ACCEPT_RESULT {
     QUIC_CONNECTION_REJECT_APP
 } QUIC_CONNECTION_ACCEPT_RESULT;
 
+//
+// A registration's share of the buffer memory usage charged on one partition.
+// Each is on its own cache line, like the partition's own counter.
+//
+typedef struct QUIC_CACHEALIGN QUIC_REGISTRATION_MEMORY_USAGE {
+
+    int64_t Bytes;
+
+} QUIC_REGISTRATION_MEMORY_USAGE;
+
 //
 // Represents per application registration state.
 //
@@ -105,6 +115,12 @@ typedef struct QUIC_REGISTRATION {
     //
     uint64_t ShutdownErrorCode;
 
+    //
+    // Estimated memory used by the connections of this registration, indexed
+    // by partition and summed on query.
+    //
+    QUIC_REGISTRATION_MEMORY_USAGE* MemoryUsage;
+
     //
     // Name of the application layer.
     //
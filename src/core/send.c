@@ -66,6 +66,13 @@ QuicSendUninitialize(
         Send->InitialToken = NULL;
     }
 
+    if (Send->RecvWindowAutoTuneBytes != 0) {
+        InterlockedExchangeAdd64(
+            (int64_t*)&MsQuicLib.RecvWindowAutoTuneBytes,
+            -(int64_t)Send->RecvWindowAutoTuneBytes);
+        Send->RecvWindowAutoTuneBytes = 0;
+    }
+
     //
     // Release all the stream refs.
     //
@@ -82,6 +89,7 @@ QuicSendUninitialize(
 
         QuicStreamRelease(Stream, QUIC_STREAM_REF_SEND);
     }
+    Send->SchedulerRoot = NULL;
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -154,6 +162,214 @@ QuicSendQueueFlush(
     }
 }
 
+//
+// Weighted fair queueing stream scheduler.
+//
+// In addition to the SendStreams list, queued streams are kept in an intrusive
+// pairing heap ordered by send deadline (streams with one ahead of those
+// without) and then by virtual time. A stream's virtual time advances by the
+// bytes it sends divided by its weight, so backlogged streams share the
+// connection in proportion to SendPriority + 1. Inserts are O(1) and removals
+// O(log n) amortized, with no allocations.
+//
+
+QUIC_INLINE
+BOOLEAN
+QuicSendSchedulerLess(
+    _In_ const QUIC_STREAM* A,
+    _In_ const QUIC_STREAM* B
+    )
+{
+    if (A->SendDeadline != B->SendDeadline) {
+        //
+        // Zero (no deadline) wraps around to sort last.
+        //
+        return A->SendDeadline - 1 < B->SendDeadline - 1;
+    }
+    return A->SchedulerVirtualTime < B->SchedulerVirtualTime;
+}
+
+//
+// Melds two detached heaps, returning the new root.
+//
+static
+QUIC_STREAM*
+QuicSendSchedulerMeld(
+    _In_opt_ QUIC_STREAM* A,
+    _In_opt_ QUIC_STREAM* B
+    )
+{
+    if (A == NULL) {
+        return B;
+    }
+    if (B == NULL) {
+        return A;
+    }
+    if (QuicSendSchedulerLess(B, A)) {
+        QUIC_STREAM* Temp = A;
+        A = B;
+        B = Temp;
+    }
+    B->SchedulerSibling = A->SchedulerChild;
+    if (A->SchedulerChild != NULL) {
+        A->SchedulerChild->SchedulerPrev = B;
+    }
+    B->SchedulerPrev = A;
+    A->SchedulerChild = B;
+    return A;
+}
+
+//
+// Standard two pass pairing of a list of sibling subtrees into one heap.
+//
+static
+QUIC_STREAM*
+QuicSendSchedulerMergePairs(
+    _In_opt_ QUIC_STREAM* First
+    )
+{
+    QUIC_STREAM* Pairs = NULL;
+    while (First != NULL) {
+        QUIC_STREAM* A = First;
+        QUIC_STREAM* B = A->SchedulerSibling;
+        First = B != NULL ? B->SchedulerSibling : NULL;
+        A->SchedulerSibling = A->SchedulerPrev = NULL;
+        if (B != NULL) {
+            B->SchedulerSibling = B->SchedulerPrev = NULL;
+        }
+        QUIC_STREAM* Pair = QuicSendSchedulerMeld(A, B);
+        Pair->SchedulerSibling = Pairs;
+        Pairs = Pair;
+    }
+
+    QUIC_STREAM* Root = NULL;
+    while (Pairs != NULL) {
+        QUIC_STREAM* Next = Pairs->SchedulerSibling;
+        Pairs->SchedulerSibling = NULL;
+        Root = QuicSendSchedulerMeld(Root, Pairs);
+        Pairs = Next;
+    }
+    return Root;
+}
+
+static
+void
+QuicSendSchedulerInsert(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    Stream->SchedulerChild = NULL;
+    Stream->SchedulerSibling = NULL;
+    Stream->SchedulerPrev = NULL;
+    Send->SchedulerRoot = QuicSendSchedulerMeld(Send->SchedulerRoot, Stream);
+}
+
+static
+void
+QuicSendSchedulerRemove(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    if (Stream == Send->SchedulerRoot) {
+        Send->SchedulerRoot = QuicSendSchedulerMergePairs(Stream->SchedulerChild);
+    } else {
+        CXPLAT_DBG_ASSERT(Stream->SchedulerPrev != NULL);
+        if (Stream->SchedulerPrev->SchedulerChild == Stream) {
+            Stream->SchedulerPrev->SchedulerChild = Stream->SchedulerSibling;
+        } else {
+            Stream->SchedulerPrev->SchedulerSibling = Stream->SchedulerSibling;
+        }
+        if (Stream->SchedulerSibling != NULL) {
+            Stream->SchedulerSibling->SchedulerPrev = Stream->SchedulerPrev;
+        }
+        Send->SchedulerRoot =
+            QuicSendSchedulerMeld(
+                Send->SchedulerRoot,
+                QuicSendSchedulerMergePairs(Stream->SchedulerChild));
+    }
+    Stream->SchedulerChild = NULL;
+    Stream->SchedulerSibling = NULL;
+    Stream->SchedulerPrev = NULL;
+}
+
+//
+// Advances the stream's virtual time for the bytes just written for it.
+//
+static
+void
+QuicSendSchedulerCharge(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream,
+    _In_ uint32_t Bytes
+    )
+{
+    Stream->SchedulerVirtualTime +=
+        ((uint64_t)Bytes << 16) / ((uint64_t)Stream->SendPriority + 1);
+    if (Stream->SendLink.Flink != NULL) {
+        QuicSendSchedulerRemove(Send, Stream);
+        QuicSendSchedulerInsert(Send, Stream);
+    }
+}
+
+//
+// Adds a (not already queued) stream to the send queue.
+//
+static
+void
+QuicSendStreamEnqueue(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    if (QuicSendGetConnection(Send)->State.UseWeightedFairStreamScheduling) {
+        CxPlatListInsertTail(&Send->SendStreams, &Stream->SendLink);
+        //
+        // A stream that was idle doesn't get to bank credit for the time it
+        // had nothing to send.
+        //
+        if (Stream->SchedulerVirtualTime < Send->SchedulerVirtualTime) {
+            Stream->SchedulerVirtualTime = Send->SchedulerVirtualTime;
+        }
+        QuicSendSchedulerInsert(Send, Stream);
+        return;
+    }
+
+    CXPLAT_LIST_ENTRY* Entry = Send->SendStreams.Blink;
+    while (Entry != &Send->SendStreams) {
+        //
+        // Search back to front for the right place (based on priority) to
+        // insert the stream.
+        //
+        if (Stream->SendPriority <=
+            CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendLink)->SendPriority) {
+            break;
+        }
+        Entry = Entry->Blink;
+    }
+    CxPlatListInsertHead(Entry, &Stream->SendLink); // Insert after current Entry
+}
+
+//
+// Removes a stream from the send queue. The caller releases the queue's
+// reference on it.
+//
+static
+void
+QuicSendStreamDequeue(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    CxPlatListEntryRemove(&Stream->SendLink);
+    Stream->SendLink.Flink = NULL;
+    if (QuicSendGetConnection(Send)->State.UseWeightedFairStreamScheduling) {
+        QuicSendSchedulerRemove(Send, Stream);
+    }
+    Stream->SendDeadline = 0;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicSendQueueFlushForStream(
@@ -166,19 +382,7 @@ QuicSendQueueFlushForStream(
         //
         // Not previously queued, so add the stream to the end of the queue.
         //
-        CXPLAT_LIST_ENTRY* Entry = Send->SendStreams.Blink;
-        while (Entry != &Send->SendStreams) {
-            //
-            // Search back to front for the right place (based on priority) to
-            // insert the stream.
-            //
-            if (Stream->SendPriority <=
-                CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendLink)->SendPriority) {
-                break;
-            }
-            Entry = Entry->Blink;
-        }
-        CxPlatListInsertHead(Entry, &Stream->SendLink); // Insert after current Entry
+        QuicSendStreamEnqueue(Send, Stream);
         QuicStreamAddRef(Stream, QUIC_STREAM_REF_SEND);
     }
 
@@ -208,21 +412,57 @@ QuicSendUpdateStreamPriority(
     )
 {
     CXPLAT_DBG_ASSERT(Stream->SendLink.Flink != NULL);
-    CxPlatListEntryRemove(&Stream->SendLink);
 
-    CXPLAT_LIST_ENTRY* Entry = Send->SendStreams.Blink;
-    while (Entry != &Send->SendStreams) {
+    if (QuicSendGetConnection(Send)->State.UseWeightedFairStreamScheduling) {
         //
-        // Search back to front for the right place (based on priority) to
-        // insert the stream.
+        // The weight only affects how fast the stream's virtual time advances
+        // from now on, but a deadline change moves it in the heap.
         //
-        if (Stream->SendPriority <=
-            CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendLink)->SendPriority) {
-            break;
-        }
-        Entry = Entry->Blink;
+        QuicSendSchedulerRemove(Send, Stream);
+        QuicSendSchedulerInsert(Send, Stream);
+        return;
+    }
+
+    CxPlatListEntryRemove(&Stream->SendLink);
+    QuicSendStreamEnqueue(Send, Stream);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendSetStreamSchedulingScheme(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM_SCHEDULING_SCHEME Scheme
+    )
+{
+    QUIC_CONNECTION* Connection = QuicSendGetConnection(Send);
+    const BOOLEAN UseWeightedFair =
+        Scheme == QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR;
+    const BOOLEAN Reorder =
+        Connection->State.UseWeightedFairStreamScheduling != UseWeightedFair;
+
+    Connection->State.UseRoundRobinStreamScheduling =
+        Scheme == QUIC_STREAM_SCHEDULING_SCHEME_ROUND_ROBIN;
+    Connection->State.UseWeightedFairStreamScheduling = UseWeightedFair;
+
+    if (!Reorder) {
+        return;
+    }
+
+    //
+    // The priority ordered list and the heap are maintained differently, so
+    // requeue everything under the new scheme.
+    //
+    CXPLAT_LIST_ENTRY Queued;
+    CxPlatListInitializeHead(&Queued);
+    CxPlatListMoveItems(&Send->SendStreams, &Queued);
+    Send->SchedulerRoot = NULL;
+
+    while (!CxPlatListIsEmpty(&Queued)) {
+        QUIC_STREAM* Stream =
+            CXPLAT_CONTAINING_RECORD(
+                CxPlatListRemoveHead(&Queued), QUIC_STREAM, SendLink);
+        QuicSendStreamEnqueue(Send, Stream);
     }
-    CxPlatListInsertHead(Entry, &Stream->SendLink); // Insert after current Entry
 }
 
 #if DEBUG
@@ -288,6 +528,7 @@ QuicSendClear(
 
         QuicStreamRelease(Stream, QUIC_STREAM_REF_SEND);
     }
+    Send->SchedulerRoot = NULL;
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -452,8 +693,6 @@ QuicSendClearStreamSendFlag(
     _In_ uint32_t SendFlags
     )
 {
-    UNREFERENCED_PARAMETER(Send);
-
     if (Stream->SendFlags & SendFlags) {
 
         QuicTraceLogStreamVerbose(
@@ -471,8 +710,7 @@ QuicSendClearStreamSendFlag(
             //
             // Since there are no flags left, remove the stream from the queue.
             //
-            CxPlatListEntryRemove(&Stream->SendLink);
-            Stream->SendLink.Flink = NULL;
+            QuicSendStreamDequeue(Send, Stream);
             QuicStreamRelease(Stream, QUIC_STREAM_REF_SEND);
         }
     }
@@ -996,6 +1234,48 @@ QuicSendCanSendStreamNow(
     return FALSE;
 }
 
+//
+// Finds the first stream in weighted fair order that can send right now,
+// without modifying the heap. Every stream below a sendable one orders after
+// it, so only the subtrees under blocked streams are searched.
+//
+static
+QUIC_STREAM*
+QuicSendSchedulerFindSendable(
+    _In_ QUIC_SEND* Send
+    )
+{
+    QUIC_STREAM* Best = NULL;
+    QUIC_STREAM* Stream = Send->SchedulerRoot;
+    while (Stream != NULL) {
+        QUIC_STREAM* Next = NULL;
+        if (Best == NULL || QuicSendSchedulerLess(Stream, Best)) {
+            if (QuicSendCanSendStreamNow(Stream)) {
+                Best = Stream;
+            } else {
+                Next = Stream->SchedulerChild;
+            }
+        }
+
+        //
+        // Go to the next sibling, walking back up to the first ancestor that
+        // has one if needed.
+        //
+        while (Next == NULL && Stream != Send->SchedulerRoot) {
+            if (Stream->SchedulerSibling != NULL) {
+                Next = Stream->SchedulerSibling;
+            } else {
+                while (Stream->SchedulerPrev->SchedulerChild != Stream) {
+                    Stream = Stream->SchedulerPrev;
+                }
+                Stream = Stream->SchedulerPrev;
+            }
+        }
+        Stream = Next;
+    }
+    return Best;
+}
+
 _Success_(return != NULL)
 QUIC_STREAM*
 QuicSendGetNextStream(
@@ -1006,6 +1286,21 @@ QuicSendGetNextStream(
     QUIC_CONNECTION* Connection = QuicSendGetConnection(Send);
     CXPLAT_DBG_ASSERT(!QuicConnIsClosed(Connection) || CxPlatListIsEmpty(&Send->SendStreams));
 
+    if (Connection->State.UseWeightedFairStreamScheduling) {
+        QUIC_STREAM* Stream = QuicSendSchedulerFindSendable(Send);
+        if (Stream != NULL) {
+            if (Send->SchedulerVirtualTime < Stream->SchedulerVirtualTime) {
+                Send->SchedulerVirtualTime = Stream->SchedulerVirtualTime;
+            }
+            //
+            // Reschedule after every packet so small streams don't wait behind
+            // a batch of bulk data.
+            //
+            *PacketCount = 1;
+        }
+        return Stream;
+    }
+
     CXPLAT_LIST_ENTRY* Entry = Send->SendStreams.Flink;
     while (Entry != &Send->SendStreams) {
 
@@ -1199,13 +1494,14 @@ typedef enum QUIC_SEND_RESULT {
 #pragma warning(push)
 #pragma warning(disable:6001) // SAL is confused by the QuicConnAddRef followed by QuicConnRelease.
 _IRQL_requires_max_(PASSIVE_LEVEL)
+static
 BOOLEAN
-QuicSendFlush(
+QuicSendFlushInternal(
     _In_ QUIC_SEND* Send
     )
 {
     QUIC_CONNECTION* Connection = QuicSendGetConnection(Send);
-    QUIC_PATH* Path = &Connection->Paths[0];
+    QUIC_PATH* Path = QuicConnGetPathForSend(Connection);
 
     CXPLAT_DBG_ASSERT(!Connection->State.HandleClosed);
 
@@ -1416,15 +1712,20 @@ QuicSendFlush(
             //
             // Write the stream frames.
             //
+            const uint16_t PrevDatagramLength = Builder.DatagramLength;
             WrotePacketFrames |= QuicStreamSendWrite(Stream, &Builder);
+            if (Connection->State.UseWeightedFairStreamScheduling &&
+                Builder.DatagramLength > PrevDatagramLength) {
+                QuicSendSchedulerCharge(
+                    Send, Stream, Builder.DatagramLength - PrevDatagramLength);
+            }
 
             if (Stream->SendFlags == 0 && Stream->SendLink.Flink != NULL) {
                 //
                 // If the stream no longer has anything to send, remove it from the
                 // list and release Send's reference on it.
                 //
-                CxPlatListEntryRemove(&Stream->SendLink);
-                Stream->SendLink.Flink = NULL;
+                QuicSendStreamDequeue(Send, Stream);
                 QuicStreamRelease(Stream, QUIC_STREAM_REF_SEND);
                 Stream = NULL;
 
@@ -1521,7 +1822,8 @@ QuicSendFlush(
     }
 
     //
-    // Clears the SendQueue list of not sent packets if the flag is applied
+    // Clears the SendQueue list of not sent packets if the flag is applied,
+    // or if their deadline has already passed.
     //
     QuicDatagramCancelBlocked(Connection);
 
@@ -1529,6 +1831,19 @@ QuicSendFlush(
 }
 #pragma warning(pop)
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicSendFlush(
+    _In_ QUIC_SEND* Send
+    )
+{
+    QUIC_PROFILE_BEGIN(QUIC_PROFILE_SEND_FLUSH);
+    BOOLEAN Result = QuicSendFlushInternal(Send);
+    QUIC_PROFILE_END(
+        QuicSendGetConnection(Send)->Partition, QUIC_PROFILE_SEND_FLUSH);
+    return Result;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 QuicSendStartDelayedAckTimer(
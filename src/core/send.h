@@ -318,6 +318,19 @@ typedef struct QUIC_SEND {
     //
     uint64_t OrderedStreamBytesDeliveredAccumulator;
 
+    //
+    // Receive window auto-tuning state. The connection's window is
+    // ConnFlowControlWindow plus RecvWindowAutoTuneBytes, and is sized from the
+    // bandwidth-delay product of the data delivered to the app. Shrinking is
+    // done by withholding RecvWindowShrinkDebt bytes of future credit, since
+    // MAX_DATA can't go backwards.
+    //
+    uint64_t RecvWindowAutoTuneBytes;
+    uint64_t RecvWindowShrinkDebt;
+    uint64_t RecvBdp;
+    uint64_t RecvRateSampleStart;
+    uint64_t RecvRateSampleBytes;
+
     //
     // Set of flags indicating what data is ready to be sent out.
     //
@@ -328,6 +341,18 @@ typedef struct QUIC_SEND {
     //
     CXPLAT_LIST_ENTRY SendStreams;
 
+    //
+    // Root of the weighted fair queueing heap of streams in SendStreams. Only
+    // used with QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR.
+    //
+    QUIC_STREAM* SchedulerRoot;
+
+    //
+    // The weighted fair queueing virtual time, i.e. the virtual time of the
+    // most recently scheduled stream.
+    //
+    uint64_t SchedulerVirtualTime;
+
     //
     // The current token to send with an Initial packet.
     //
@@ -423,7 +448,7 @@ QuicSendQueueFlushForStream(
     );
 
 //
-// Updates the stream's order in response to a priority change.
+// Updates the stream's order in response to a priority or deadline change.
 //
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
@@ -432,6 +457,17 @@ QuicSendUpdateStreamPriority(
     _In_ QUIC_STREAM* Stream
     );
 
+//
+// Switches the connection to a new stream scheduling scheme, reordering any
+// queued streams.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendSetStreamSchedulingScheme(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM_SCHEDULING_SCHEME Scheme
+    );
+
 //
 // Tries to drain all queued data that needs to be sent. Returns TRUE if all the
 // data was drained.
@@ -89,6 +89,9 @@ QuicSendBufferAlloc(
 
     if (Buf != NULL) {
         SendBuffer->BufferedBytes += Size;
+        QuicConnUpdateMemoryUsage(
+            CXPLAT_CONTAINING_RECORD(SendBuffer, QUIC_CONNECTION, SendBuffer),
+            Size);
     } else {
         QuicTraceEvent(
             AllocFailure,
@@ -110,6 +113,9 @@ QuicSendBufferFree(
 {
     CXPLAT_FREE(Buf, QUIC_POOL_SENDBUF);
     SendBuffer->BufferedBytes -= Size;
+    QuicConnUpdateMemoryUsage(
+        CXPLAT_CONTAINING_RECORD(SendBuffer, QUIC_CONNECTION, SendBuffer),
+        -(int64_t)Size);
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -246,26 +252,102 @@ QuicSendBufferStreamAdjust(
     }
 }
 
+//
+// Calculates the ideal send buffer size from the congestion controller's
+// pacing rate: enough data to cover one RTT plus the configured latency
+// target. Returns 0 if there is no rate estimate yet.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+uint64_t
+QuicSendBufferPacedIdealBytes(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    const QUIC_PATH* Path = &Connection->Paths[0];
+    if (!Path->GotFirstRttSample) {
+        return 0;
+    }
+
+    QUIC_NETWORK_STATISTICS NetworkStatistics;
+    CxPlatZeroMemory(&NetworkStatistics, sizeof(NetworkStatistics));
+    Connection->CongestionControl.QuicCongestionControlGetNetworkStatistics(
+        Connection,
+        &Connection->CongestionControl,
+        &NetworkStatistics);
+    if (NetworkStatistics.Bandwidth == 0) {
+        return 0;
+    }
+
+    const uint64_t CoveredTimeUs =
+        Path->SmoothedRtt +
+        MS_TO_US((uint64_t)Connection->Settings.SendBufferLatencyTargetMs);
+    const uint64_t IdealBytes =
+        NetworkStatistics.Bandwidth * CoveredTimeUs / 1000000;
+
+    if (IdealBytes >= QUIC_MAX_IDEAL_SEND_BUFFER_SIZE) {
+        return QUIC_MAX_IDEAL_SEND_BUFFER_SIZE;
+    }
+    if (IdealBytes >= QUIC_DEFAULT_IDEAL_SEND_BUFFER_SIZE) {
+        return QuicGetNextIdealBytes((uint32_t)IdealBytes);
+    }
+
+    //
+    // Below the default size, round up to the next power of two so small
+    // fluctuations in the rate don't generate a stream of indications.
+    //
+    uint64_t Threshold = QUIC_MIN_IDEAL_SEND_BUFFER_SIZE;
+    while (Threshold < IdealBytes) {
+        Threshold <<= 1;
+    }
+    return Threshold;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicSendBufferConnectionAdjust(
     _In_ QUIC_CONNECTION* Connection
     )
 {
-    if (Connection->SendBuffer.IdealBytes == QUIC_MAX_IDEAL_SEND_BUFFER_SIZE ||
-        Connection->Streams.StreamTable == NULL) {
+    if (Connection->Streams.StreamTable == NULL) {
         return; // Nothing to do.
     }
 
-    const uint64_t NewIdealBytes =
-        QuicGetNextIdealBytes(
-            QuicCongestionControlGetBytesInFlightMax(&Connection->CongestionControl));
+    uint64_t NewIdealBytes;
+    if (QuicLibraryGetMemoryPressure() >= QUIC_MEMORY_PRESSURE_SHRINK_SEND_BUFFER) {
+        //
+        // Drop back to (at most) the default size while buffer memory is
+        // short. The buffer regrows as usual once the pressure is relieved.
+        //
+        NewIdealBytes =
+            CXPLAT_MIN(Connection->SendBuffer.IdealBytes, QUIC_DEFAULT_IDEAL_SEND_BUFFER_SIZE);
+    } else if ((NewIdealBytes = QuicSendBufferPacedIdealBytes(Connection)) != 0) {
+        //
+        // Grow immediately, but only shrink once the paced size drops to half
+        // of the current value, to avoid flapping with noisy rate samples.
+        //
+        if (NewIdealBytes < Connection->SendBuffer.IdealBytes &&
+            NewIdealBytes > Connection->SendBuffer.IdealBytes / 2) {
+            return;
+        }
+    } else {
+        //
+        // Without a rate estimate, fall back to growing with the max bytes in
+        // flight.
+        //
+        if (Connection->SendBuffer.IdealBytes == QUIC_MAX_IDEAL_SEND_BUFFER_SIZE) {
+            return;
+        }
+        NewIdealBytes =
+            QuicGetNextIdealBytes(
+                QuicCongestionControlGetBytesInFlightMax(&Connection->CongestionControl));
+        if (NewIdealBytes < Connection->SendBuffer.IdealBytes) {
+            return;
+        }
+    }
 
-    //
-    // TODO: Currently, IdealBytes only grows and never shrinks. Add appropriate
-    // shrinking logic.
-    //
-    if (NewIdealBytes > Connection->SendBuffer.IdealBytes) {
+    if (NewIdealBytes != Connection->SendBuffer.IdealBytes) {
+        const BOOLEAN Grew = NewIdealBytes > Connection->SendBuffer.IdealBytes;
         Connection->SendBuffer.IdealBytes = NewIdealBytes;
 
         CXPLAT_HASHTABLE_ENUMERATOR Enumerator;
@@ -279,7 +361,7 @@ QuicSendBufferConnectionAdjust(
         }
         CxPlatHashtableEnumerateEnd(Connection->Streams.StreamTable, &Enumerator);
 
-        if (Connection->Settings.SendBufferingEnabled) {
+        if (Grew && Connection->Settings.SendBufferingEnabled) {
             QuicSendBufferFill(Connection);
         }
     }
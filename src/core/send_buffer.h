@@ -27,6 +27,12 @@ typedef struct QUIC_SEND_BUFFER {
     //
     uint64_t IdealBytes;
 
+    //
+    // The last time (in us) IdealBytes was re-evaluated against the pacing
+    // rate on receipt of an ACK.
+    //
+    uint64_t PacedAdjustTime;
+
 } QUIC_SEND_BUFFER;
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -80,7 +86,7 @@ QuicSendBufferStreamAdjust(
     );
 
 //
-// Updates IdealBytes upon change of BytesInFlightMax.
+// Updates IdealBytes upon change of the pacing rate or BytesInFlightMax.
 //
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
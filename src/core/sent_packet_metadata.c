@@ -103,16 +103,19 @@ _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_SENT_PACKET_METADATA*
 QuicSentPacketPoolGetPacketMetadata(
     _In_ QUIC_SENT_PACKET_POOL* Pool,
-    _In_ uint8_t FrameCount
+    _In_ uint8_t FrameCount,
+    _In_ QUIC_CONNECTION* Connection
     )
 {
     QUIC_SENT_PACKET_METADATA* Metadata =
         CxPlatPoolAlloc(Pool->Pools + FrameCount - 1);
-#if DEBUG
     if (Metadata != NULL) {
+#if DEBUG
         Metadata->Flags.Freed = FALSE;
-    }
 #endif
+        QuicConnUpdateMemoryUsage(
+            Connection, SIZEOF_QUIC_SENT_PACKET_METADATA(FrameCount));
+    }
     return Metadata;
 }
 
@@ -132,5 +135,7 @@ QuicSentPacketPoolReturnPacketMetadata(
 #endif
 
     QuicSentPacketMetadataReleaseFrames(Metadata, Connection);
+    QuicConnUpdateMemoryUsage(
+        Connection, -(int64_t)SIZEOF_QUIC_SENT_PACKET_METADATA(Metadata->FrameCount));
     CxPlatPoolFree(Metadata);
 }
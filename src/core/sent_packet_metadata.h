@@ -225,13 +225,15 @@ QuicSentPacketPoolUninitialize(
     );
 
 //
-// Allocates a sent packet metadata item.
+// Allocates a sent packet metadata item, charged to the connection's memory
+// usage until it is returned.
 //
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_SENT_PACKET_METADATA*
 QuicSentPacketPoolGetPacketMetadata(
     _In_ QUIC_SENT_PACKET_POOL* Pool,
-    _In_ uint8_t FrameCount
+    _In_ uint8_t FrameCount,
+    _In_ QUIC_CONNECTION* Connection
     );
 
 //
@@ -108,6 +108,9 @@ QuicSettingsSetDefault(
     if (!Settings->IsSet.StreamRecvBufferDefault) {
         Settings->StreamRecvBufferDefault = QUIC_DEFAULT_STREAM_RECV_BUFFER_SIZE;
     }
+    if (!Settings->IsSet.SendBufferLatencyTargetMs) {
+        Settings->SendBufferLatencyTargetMs = QUIC_DEFAULT_SEND_BUFFER_LATENCY_TARGET_MS;
+    }
     if (!Settings->IsSet.ConnFlowControlWindow) {
         Settings->ConnFlowControlWindow = QUIC_DEFAULT_CONN_FLOW_CONTROL_WINDOW;
     }
@@ -174,6 +177,9 @@ QuicSettingsSetDefault(
     if (!Settings->IsSet.StreamMultiReceiveEnabled) {
         Settings->StreamMultiReceiveEnabled = QUIC_DEFAULT_STREAM_MULTI_RECEIVE_ENABLED;
     }
+    if (!Settings->IsSet.RecvWindowAutoTuneEnabled) {
+        Settings->RecvWindowAutoTuneEnabled = QUIC_DEFAULT_RECV_WINDOW_AUTO_TUNE_ENABLED;
+    }
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -264,6 +270,9 @@ QuicSettingsCopy(
     if (!Destination->IsSet.StreamRecvBufferDefault) {
         Destination->StreamRecvBufferDefault = Source->StreamRecvBufferDefault;
     }
+    if (!Destination->IsSet.SendBufferLatencyTargetMs) {
+        Destination->SendBufferLatencyTargetMs = Source->SendBufferLatencyTargetMs;
+    }
     if (!Destination->IsSet.ConnFlowControlWindow) {
         Destination->ConnFlowControlWindow = Source->ConnFlowControlWindow;
     }
@@ -348,6 +357,9 @@ QuicSettingsCopy(
     if (!Destination->IsSet.StreamMultiReceiveEnabled) {
         Destination->StreamMultiReceiveEnabled = Source->StreamMultiReceiveEnabled;
     }
+    if (!Destination->IsSet.RecvWindowAutoTuneEnabled) {
+        Destination->RecvWindowAutoTuneEnabled = Source->RecvWindowAutoTuneEnabled;
+    }
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -583,6 +595,13 @@ QuicSettingApply(
         Destination->StreamRecvBufferDefault = Source->StreamRecvBufferDefault;
         Destination->IsSet.StreamRecvBufferDefault = TRUE;
     }
+    if (Source->IsSet.SendBufferLatencyTargetMs && (!Destination->IsSet.SendBufferLatencyTargetMs || OverWrite)) {
+        if (Source->SendBufferLatencyTargetMs > QUIC_MAX_SEND_BUFFER_LATENCY_TARGET_MS) {
+            return FALSE;
+        }
+        Destination->SendBufferLatencyTargetMs = Source->SendBufferLatencyTargetMs;
+        Destination->IsSet.SendBufferLatencyTargetMs = TRUE;
+    }
     if (Source->IsSet.ConnFlowControlWindow && (!Destination->IsSet.ConnFlowControlWindow || OverWrite)) {
         Destination->ConnFlowControlWindow = Source->ConnFlowControlWindow;
         Destination->IsSet.ConnFlowControlWindow = TRUE;
@@ -737,6 +756,11 @@ QuicSettingApply(
         Destination->StreamMultiReceiveEnabled = Source->StreamMultiReceiveEnabled;
         Destination->IsSet.StreamMultiReceiveEnabled = TRUE;
     }
+
+    if (Source->IsSet.RecvWindowAutoTuneEnabled && (!Destination->IsSet.RecvWindowAutoTuneEnabled || OverWrite)) {
+        Destination->RecvWindowAutoTuneEnabled = Source->RecvWindowAutoTuneEnabled;
+        Destination->IsSet.RecvWindowAutoTuneEnabled = TRUE;
+    }
     return TRUE;
 }
 
@@ -1037,6 +1061,18 @@ QuicSettingsLoad(
             &ValueLen);
     }
 
+    if (!Settings->IsSet.SendBufferLatencyTargetMs) {
+        ValueLen = sizeof(Settings->SendBufferLatencyTargetMs);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_SEND_BUFFER_LATENCY_TARGET_MS,
+            (uint8_t*)&Settings->SendBufferLatencyTargetMs,
+            &ValueLen);
+        if (Settings->SendBufferLatencyTargetMs > QUIC_MAX_SEND_BUFFER_LATENCY_TARGET_MS) {
+            Settings->SendBufferLatencyTargetMs = QUIC_DEFAULT_SEND_BUFFER_LATENCY_TARGET_MS;
+        }
+    }
+
     if (!Settings->IsSet.StreamRecvBufferDefault) {
         ValueLen = sizeof(Settings->StreamRecvBufferDefault);
         CxPlatStorageReadValue(
@@ -1425,6 +1461,16 @@ VersionSettingsFail:
             &ValueLen);
         Settings->StreamMultiReceiveEnabled = !!Value;
     }
+    if (!Settings->IsSet.RecvWindowAutoTuneEnabled) {
+        Value = QUIC_DEFAULT_RECV_WINDOW_AUTO_TUNE_ENABLED;
+        ValueLen = sizeof(Value);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_RECV_WINDOW_AUTO_TUNE_ENABLED,
+            (uint8_t*)&Value,
+            &ValueLen);
+        Settings->RecvWindowAutoTuneEnabled = !!Value;
+    }
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -1486,6 +1532,7 @@ QuicSettingsDump(
     QuicTraceLogVerbose(SettingDumpStatelessOperExpirMs,    "[sett] StatelessOperExpirMs   = %hu", Settings->StatelessOperationExpirationMs);
     QuicTraceLogVerbose(SettingCongestionControlAlgorithm,  "[sett] CongestionControlAlgorithm = %hu", Settings->CongestionControlAlgorithm);
     QuicTraceLogVerbose(SettingDestCidUpdateIdleTimeoutMs,  "[sett] DestCidUpdateIdleTimeoutMs = %u", Settings->DestCidUpdateIdleTimeoutMs);
+    QuicTraceLogVerbose(SettingSendBufferLatencyTargetMs,   "[sett] SendBufferLatencyTargetMs = %u", Settings->SendBufferLatencyTargetMs);
     QuicTraceLogVerbose(SettingGreaseQuicBitEnabled,        "[sett] GreaseQuicBitEnabled   = %hhu", Settings->GreaseQuicBitEnabled);
     QuicTraceLogVerbose(SettingEcnEnabled,                  "[sett] EcnEnabled             = %hhu", Settings->EcnEnabled);
     QuicTraceLogVerbose(SettingHyStartEnabled,              "[sett] HyStartEnabled         = %hhu", Settings->HyStartEnabled);
@@ -1496,6 +1543,7 @@ QuicSettingsDump(
     QuicTraceLogVerbose(SettingOneWayDelayEnabled,          "[sett] OneWayDelayEnabled     = %hhu", Settings->OneWayDelayEnabled);
     QuicTraceLogVerbose(SettingNetStatsEventEnabled,        "[sett] NetStatsEventEnabled   = %hhu", Settings->NetStatsEventEnabled);
     QuicTraceLogVerbose(SettingsStreamMultiReceiveEnabled,  "[sett] StreamMultiReceiveEnabled= %hhu", Settings->StreamMultiReceiveEnabled);
+    QuicTraceLogVerbose(SettingsRecvWindowAutoTuneEnabled,  "[sett] RecvWindowAutoTuneEnabled= %hhu", Settings->RecvWindowAutoTuneEnabled);
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -1636,6 +1684,9 @@ QuicSettingsDumpNew(
     if (Settings->IsSet.DestCidUpdateIdleTimeoutMs) {
         QuicTraceLogVerbose(SettingDestCidUpdateIdleTimeoutMs,      "[sett] DestCidUpdateIdleTimeoutMs = %u", Settings->DestCidUpdateIdleTimeoutMs);
     }
+    if (Settings->IsSet.SendBufferLatencyTargetMs) {
+        QuicTraceLogVerbose(SettingSendBufferLatencyTargetMs,       "[sett] SendBufferLatencyTargetMs = %u", Settings->SendBufferLatencyTargetMs);
+    }
     if (Settings->IsSet.GreaseQuicBitEnabled) {
         QuicTraceLogVerbose(SettingGreaseQuicBitEnabled,            "[sett] GreaseQuicBitEnabled   = %hhu", Settings->GreaseQuicBitEnabled);
     }
@@ -1666,6 +1717,9 @@ QuicSettingsDumpNew(
     if (Settings->IsSet.StreamMultiReceiveEnabled) {
         QuicTraceLogVerbose(SettingStreamMultiReceiveEnabled,       "[sett] StreamMultiReceiveEnabled  = %hhu", Settings->StreamMultiReceiveEnabled);
     }
+    if (Settings->IsSet.RecvWindowAutoTuneEnabled) {
+        QuicTraceLogVerbose(SettingRecvWindowAutoTuneEnabled,       "[sett] RecvWindowAutoTuneEnabled  = %hhu", Settings->RecvWindowAutoTuneEnabled);
+    }
 }
 
 #define SETTING_COPY_TO_INTERNAL(Field, Settings, InternalSettings) \
@@ -1924,6 +1978,13 @@ QuicSettingsSettingsToInternal(
         SettingsSize,
         InternalSettings);
 
+    SETTING_COPY_TO_INTERNAL_SIZED(
+        SendBufferLatencyTargetMs,
+        QUIC_SETTINGS,
+        Settings,
+        SettingsSize,
+        InternalSettings);
+
     SETTING_COPY_FLAG_TO_INTERNAL_SIZED(
         Flags,
         NetStatsEventEnabled,
@@ -1940,6 +2001,14 @@ QuicSettingsSettingsToInternal(
         SettingsSize,
         InternalSettings);
 
+    SETTING_COPY_FLAG_TO_INTERNAL_SIZED(
+        Flags,
+        RecvWindowAutoTuneEnabled,
+        QUIC_SETTINGS,
+        Settings,
+        SettingsSize,
+        InternalSettings);
+
     return QUIC_STATUS_SUCCESS;
 }
 
@@ -2109,6 +2178,13 @@ QuicSettingsGetSettings(
         *SettingsLength,
         InternalSettings);
 
+    SETTING_COPY_FROM_INTERNAL_SIZED(
+        SendBufferLatencyTargetMs,
+        QUIC_SETTINGS,
+        Settings,
+        *SettingsLength,
+        InternalSettings);
+
     SETTING_COPY_FLAG_FROM_INTERNAL_SIZED(
         Flags,
         NetStatsEventEnabled,
@@ -2125,6 +2201,14 @@ QuicSettingsGetSettings(
         *SettingsLength,
         InternalSettings);
 
+    SETTING_COPY_FLAG_FROM_INTERNAL_SIZED(
+        Flags,
+        RecvWindowAutoTuneEnabled,
+        QUIC_SETTINGS,
+        Settings,
+        *SettingsLength,
+        InternalSettings);
+
     *SettingsLength = CXPLAT_MIN(*SettingsLength, sizeof(QUIC_SETTINGS));
 
     return QUIC_STATUS_SUCCESS;
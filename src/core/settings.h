@@ -64,7 +64,9 @@ typedef struct QUIC_SETTINGS_INTERNAL {
             uint64_t StreamMultiReceiveEnabled              : 1;
             uint64_t XdpEnabled                             : 1;
             uint64_t QTIPEnabled                            : 1;
-            uint64_t RESERVED                               : 14;
+            uint64_t SendBufferLatencyTargetMs              : 1;
+            uint64_t RecvWindowAutoTuneEnabled              : 1;
+            uint64_t RESERVED                               : 12;
         } IsSet;
     };
 
@@ -90,6 +92,7 @@ typedef struct QUIC_SETTINGS_INTERNAL {
     uint32_t DisconnectTimeoutMs;
     uint32_t KeepAliveIntervalMs;
     uint32_t DestCidUpdateIdleTimeoutMs;
+    uint32_t SendBufferLatencyTargetMs;
     uint32_t FixedServerID;                 // Global only
     uint16_t PeerBidiStreamCount;
     uint16_t PeerUnidiStreamCount;
@@ -117,6 +120,7 @@ typedef struct QUIC_SETTINGS_INTERNAL {
     uint8_t StreamMultiReceiveEnabled       : 1;
     uint8_t XdpEnabled                      : 1;
     uint8_t QTIPEnabled                     : 1;
+    uint8_t RecvWindowAutoTuneEnabled       : 1;
     uint8_t MtuDiscoveryMissingProbeCount;
 } QUIC_SETTINGS_INTERNAL;
 
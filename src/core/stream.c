@@ -41,6 +41,7 @@ QuicStreamInitialize(
         Stream,
         Connection);
     CxPlatZeroMemory(Stream, sizeof(QUIC_STREAM));
+    QuicConnUpdateMemoryUsage(Connection, sizeof(QUIC_STREAM));
 
 #if DEBUG
     CxPlatDispatchLockAcquire(&Connection->Streams.AllStreamsLock);
@@ -77,7 +78,6 @@ QuicStreamInitialize(
     Stream->RefCount = 1;
     Stream->SendRequestsTail = &Stream->SendRequests;
     Stream->SendPriority = QUIC_STREAM_PRIORITY_DEFAULT;
-    CxPlatDispatchLockInitialize(&Stream->ApiSendRequestLock);
     CxPlatRefInitialize(&Stream->RefCount);
     QuicRangeInitialize(
         QUIC_MAX_RANGE_ALLOC_SIZE,
@@ -115,6 +115,7 @@ QuicStreamInitialize(
             Stream->Flags.LocalCloseAcked = TRUE;
             Stream->Flags.SendEnabled = FALSE;
             Stream->Flags.HandleSendShutdown = TRUE;
+            Stream->ApiSendRequests = QUIC_STREAM_API_SEND_CLOSED;
         }
     }
 
@@ -161,6 +162,7 @@ QuicStreamInitialize(
 
     Stream->MaxAllowedRecvOffset = Stream->RecvBuffer.VirtualBufferLength;
     Stream->RecvWindowLastUpdate = CxPlatTimeUs64();
+    QuicStreamRecvUpdateMemoryUsage(Stream);
 
     QuicConnAddRef(Connection, QUIC_CONN_REF_STREAM);
 
@@ -178,9 +180,9 @@ Exit:
         CxPlatDispatchLockRelease(&Connection->Streams.AllStreamsLock);
 #endif
         QuicPerfCounterDecrement(Connection->Partition, QUIC_PERF_COUNTER_STRM_ACTIVE);
-        CxPlatDispatchLockUninitialize(&Stream->ApiSendRequestLock);
         Stream->Flags.Freed = TRUE;
         CxPlatPoolFree(Stream);
+        QuicConnUpdateMemoryUsage(Connection, -(int64_t)sizeof(QUIC_STREAM));
     }
     if (PreallocatedRecvChunk) {
         CxPlatPoolFree(PreallocatedRecvChunk);
@@ -208,7 +210,9 @@ QuicStreamFree(
 
     Stream->Flags.Uninitialized = TRUE;
 
-    CXPLAT_DBG_ASSERT(Stream->ApiSendRequests == NULL);
+    CXPLAT_DBG_ASSERT(
+        Stream->ApiSendRequests == NULL ||
+        Stream->ApiSendRequests == QUIC_STREAM_API_SEND_CLOSED);
     CXPLAT_DBG_ASSERT(Stream->SendRequests == NULL);
 
 #if DEBUG
@@ -219,12 +223,13 @@ QuicStreamFree(
     QuicPerfCounterDecrement(Connection->Partition, QUIC_PERF_COUNTER_STRM_ACTIVE);
 
     QuicRecvBufferUninitialize(&Stream->RecvBuffer);
+    QuicStreamRecvUpdateMemoryUsage(Stream);
     QuicRangeUninitialize(&Stream->SparseAckRanges);
-    CxPlatDispatchLockUninitialize(&Stream->ApiSendRequestLock);
     CxPlatRefUninitialize(&Stream->RefCount);
 
     Stream->Flags.Freed = TRUE;
     CxPlatPoolFree(Stream);
+    QuicConnUpdateMemoryUsage(Connection, -(int64_t)sizeof(QUIC_STREAM));
 
     if (WasStarted) {
 #pragma warning(push)
@@ -689,6 +694,33 @@ QuicStreamParamSet(
         break;
     }
 
+    case QUIC_PARAM_STREAM_SEND_DEADLINE: {
+
+        if (BufferLength != sizeof(uint64_t) || Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        const uint64_t DeadlineUs = *(uint64_t*)Buffer;
+        if (DeadlineUs > QUIC_MAX_STREAM_SEND_DEADLINE_US) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        Stream->SendDeadline = DeadlineUs == 0 ? 0 : CxPlatTimeUs64() + DeadlineUs;
+
+        if (Stream->Flags.Started && Stream->SendFlags != 0 &&
+            Stream->Connection->State.UseWeightedFairStreamScheduling) {
+            //
+            // Deadlines only affect the weighted fair queueing order.
+            //
+            QuicSendUpdateStreamPriority(&Stream->Connection->Send, Stream);
+        }
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+    }
+
    case QUIC_PARAM_STREAM_RELIABLE_OFFSET:
 
         if (BufferLength != sizeof(uint64_t) || Buffer == NULL) {
@@ -986,6 +1018,7 @@ QuicStreamSwitchToAppOwnedBuffers(
         0,
         QUIC_RECV_BUF_MODE_APP_OWNED,
         NULL);
+    QuicStreamRecvUpdateMemoryUsage(Stream);
     Stream->Flags.UseAppOwnedRecvBuffers = TRUE;
 }
 
@@ -53,6 +53,37 @@ typedef struct QUIC_CONNECTION QUIC_CONNECTION;
 
 #define QUIC_STREAM_PRIORITY_DEFAULT 0x7FFF // Medium priority by default
 
+//
+// Marks a stream's ApiSendRequests as no longer accepting sends.
+//
+#define QUIC_STREAM_API_SEND_CLOSED ((QUIC_SEND_REQUEST*)(size_t)1)
+
+//
+// An immutable, app owned payload that send requests on any number of streams
+// may reference instead of copying it into their connection's send buffer.
+//
+typedef struct QUIC_CONTENT {
+
+    struct QUIC_HANDLE;
+
+    //
+    // One reference for the app's handle, plus one per send request.
+    //
+    CXPLAT_REF_COUNT RefCount;
+
+    //
+    // The app's payload.
+    //
+    QUIC_BUFFER Buffer;
+
+    //
+    // Invoked once the last reference is released.
+    //
+    QUIC_CONTENT_RELEASE_CALLBACK_HANDLER ReleaseHandler;
+    void* ReleaseContext;
+
+} QUIC_CONTENT;
+
 //
 // Tracks the data queued up for sending by an application.
 //
@@ -79,26 +110,57 @@ typedef struct QUIC_SEND_REQUEST {
     //
     QUIC_SEND_FLAGS Flags;
 
-    //
-    // The starting stream offset.
-    //
-    uint64_t StreamOffset;
+    union {
+        //
+        // The starting stream offset.
+        //
+        uint64_t StreamOffset;
+
+        //
+        // The time (in us) after which an unsent datagram is dropped. Zero if
+        // the datagram never expires.
+        //
+        uint64_t DatagramDeadline;
+    };
 
     //
     // The length of all the Buffers.
     //
     uint64_t TotalLength;
 
-    //
-    // Data descriptor for buffered requests.
-    //
-    QUIC_BUFFER InternalBuffer;
+    union {
+        //
+        // Data descriptor for buffered requests.
+        //
+        QUIC_BUFFER InternalBuffer;
+
+        //
+        // Datagram requests are never buffered.
+        //
+        struct {
+            //
+            // The batch allocation this request is part of, if any.
+            //
+            struct QUIC_DATAGRAM_SEND_BATCH* DatagramBatch;
+
+            //
+            // Send order within the datagram queue; higher goes first.
+            //
+            uint8_t DatagramPriority;
+        };
+    };
 
     //
     // API Client completion context.
     //
     void* ClientContext;
 
+    //
+    // The shared content InternalBuffer points into, if any. The request holds
+    // a reference on it until completed.
+    //
+    QUIC_CONTENT* Content;
+
 } QUIC_SEND_REQUEST;
 
 //
@@ -255,6 +317,15 @@ typedef struct QUIC_STREAM {
     //
     CXPLAT_LIST_ENTRY SendLink;
 
+    //
+    // Links in the output module's weighted fair queueing (pairing) heap.
+    // SchedulerPrev is the parent for the leftmost child, otherwise the left
+    // sibling.
+    //
+    struct QUIC_STREAM* SchedulerChild;
+    struct QUIC_STREAM* SchedulerSibling;
+    struct QUIC_STREAM* SchedulerPrev;
+
 #if DEBUG
     //
     // The list entry in the stream set's list of all allocated streams.
@@ -293,12 +364,16 @@ typedef struct QUIC_STREAM {
     //
 
     //
-    // API calls to StreamSend queue the send request here and then queue the
-    // send operation. That operation moves the send request onto the
-    // SendRequests list.
+    // API calls to StreamSend push the send request here and, if it was empty,
+    // then queue the send operation. That operation moves the send requests
+    // onto the SendRequests list. This is a lock-free stack (newest first)
+    // shared by any number of app threads and drained as a whole by the
+    // worker. It is QUIC_STREAM_API_SEND_CLOSED once sends are not allowed.
+    // It lives on the stream rather than the connection so that draining it
+    // needs no per-request stream lookup and keeps each stream's send order,
+    // at the cost of one queued operation per stream with pending sends.
     //
-    CXPLAT_DISPATCH_LOCK ApiSendRequestLock;
-    QUIC_SEND_REQUEST* ApiSendRequests;
+    QUIC_SEND_REQUEST* volatile ApiSendRequests;
 
     //
     // Queued send requests.
@@ -388,6 +463,18 @@ typedef struct QUIC_STREAM {
     //
     uint16_t SendPriority;
 
+    //
+    // Weighted fair queueing virtual time. Advances by the bytes sent, scaled
+    // inversely by the stream's weight (SendPriority + 1).
+    //
+    uint64_t SchedulerVirtualTime;
+
+    //
+    // Absolute time (in us) by which the currently queued data should be sent,
+    // or zero if none. Cleared once the stream has nothing left to send.
+    //
+    uint64_t SendDeadline;
+
     //
     // Recv State
     //
@@ -415,6 +502,12 @@ typedef struct QUIC_STREAM {
     //
     QUIC_RECV_BUFFER RecvBuffer;
 
+    //
+    // The receive buffer allocation currently charged to the connection's
+    // memory usage.
+    //
+    uint32_t RecvBufferMemoryUsage;
+
     //
     // The maximum length of 0-RTT secured payload received.
     //
@@ -889,6 +982,19 @@ QuicStreamIndicateSendShutdownComplete(
     _In_ BOOLEAN GracefulShutdown
     );
 
+//
+// Pushes an app send request onto ApiSendRequests. Returns FALSE if the stream
+// no longer accepts sends. WasEmpty is set if nothing else was pending, in
+// which case the caller is responsible for getting the queue flushed.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicStreamApiSendPush(
+    _In_ QUIC_STREAM* Stream,
+    _In_ QUIC_SEND_REQUEST* SendRequest,
+    _Out_ BOOLEAN* WasEmpty
+    );
+
 //
 // Indicates data has been queued up to be sent out on the stream.
 //
@@ -899,7 +1005,18 @@ QuicStreamSendFlush(
     );
 
 //
-// Copies the bytes of a send request and completes it early.
+// Releases a reference on shared content, freeing it (and notifying the app)
+// if it was the last one.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicContentRelease(
+    _In_ QUIC_CONTENT* Content
+    );
+
+//
+// Copies the bytes of a send request and completes it early. Requests on
+// shared content are completed without copying.
 //
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
@@ -1037,6 +1154,16 @@ QuicStreamRecvSetEnabledState(
     _In_ BOOLEAN NewRecvEnabled
     );
 
+//
+// Charges any change in the receive buffer's allocated size to the
+// connection's memory usage. App-owned buffers are not charged.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicStreamRecvUpdateMemoryUsage(
+    _In_ QUIC_STREAM* Stream
+    );
+
 //
 // Convert a stream receive buffer to app-owned mode.
 //
@@ -534,6 +534,7 @@ QuicStreamProcessStreamFrame(
                     &BufferSizeNeeded);
         }
 
+        QuicStreamRecvUpdateMemoryUsage(Stream);
         if (QUIC_FAILED(Status)) {
             goto Error;
         }
@@ -764,6 +765,112 @@ QuicStreamRecv(
     return Status;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicStreamRecvUpdateMemoryUsage(
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    const uint32_t AllocLength =
+        Stream->RecvBuffer.RecvMode == QUIC_RECV_BUF_MODE_APP_OWNED ?
+            0 : QuicRecvBufferGetTotalAllocLength(&Stream->RecvBuffer);
+    if (AllocLength != Stream->RecvBufferMemoryUsage) {
+        QuicConnUpdateMemoryUsage(
+            Stream->Connection,
+            (int64_t)AllocLength - (int64_t)Stream->RecvBufferMemoryUsage);
+        Stream->RecvBufferMemoryUsage = AllocLength;
+    }
+}
+
+//
+// Receive window auto-tuning:
+//
+// The rate at which data is delivered to the app is sampled over each smoothed
+// RTT, giving a bandwidth-delay product estimate of:
+//   BDP = (bytes delivered / sample duration) * MinRtt
+//
+// The connection window is kept at twice that (and at least the configured
+// ConnFlowControlWindow), so it grows ahead of demand: a sender limited by the
+// window delivers a full window per RTT, which doubles the window every RTT
+// until flow control no longer limits throughput. Growth across all
+// connections is bounded by a fraction of system memory, and windows give back
+// half their growth per RTT while the library is under memory pressure (either
+// handshake memory or the buffer memory budget). Auto-tuning is opt-in via the
+// RecvWindowAutoTuneEnabled setting; otherwise the window stays fixed at
+// ConnFlowControlWindow.
+//
+static
+void
+QuicStreamRecvAutoTuneWindow(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ uint64_t BytesDelivered,
+    _In_ uint64_t TimeNow
+    )
+{
+    QUIC_SEND* Send = &Connection->Send;
+    const QUIC_PATH* Path = &Connection->Paths[0];
+
+    if (!Connection->Settings.RecvWindowAutoTuneEnabled ||
+        !Path->GotFirstRttSample) {
+        return;
+    }
+
+    if (Send->RecvRateSampleStart == 0) {
+        Send->RecvRateSampleStart = TimeNow;
+    }
+    Send->RecvRateSampleBytes += BytesDelivered;
+
+    const uint64_t Elapsed = CxPlatTimeDiff64(Send->RecvRateSampleStart, TimeNow);
+    if (Elapsed == 0 || Elapsed < Path->SmoothedRtt) {
+        return;
+    }
+
+    Send->RecvBdp = Send->RecvRateSampleBytes * Path->MinRtt / Elapsed;
+    Send->RecvRateSampleStart = TimeNow;
+    Send->RecvRateSampleBytes = 0;
+
+    if (MsQuicLib.SendRetryEnabled ||
+        QuicLibraryGetMemoryPressure() >= QUIC_MEMORY_PRESSURE_SHRINK_RECV_WINDOW) {
+        if (Send->RecvWindowAutoTuneBytes != 0) {
+            const uint64_t Shrink =
+                Send->RecvWindowAutoTuneBytes - Send->RecvWindowAutoTuneBytes / 2;
+            Send->RecvWindowAutoTuneBytes -= Shrink;
+            Send->RecvWindowShrinkDebt += Shrink;
+            InterlockedExchangeAdd64(
+                (int64_t*)&MsQuicLib.RecvWindowAutoTuneBytes, -(int64_t)Shrink);
+        }
+        return;
+    }
+
+    const uint64_t Window = Connection->Settings.ConnFlowControlWindow;
+    const uint64_t Target =
+        CXPLAT_MIN(2 * Send->RecvBdp, QUIC_MAX_AUTO_TUNE_CONN_FLOW_CONTROL_WINDOW);
+    if (Target <= Window + Send->RecvWindowAutoTuneBytes) {
+        return;
+    }
+
+    const uint64_t Grow = Target - (Window + Send->RecvWindowAutoTuneBytes);
+    const uint64_t NewTotal =
+        (uint64_t)InterlockedExchangeAdd64(
+            (int64_t*)&MsQuicLib.RecvWindowAutoTuneBytes, (int64_t)Grow) + Grow;
+    if (NewTotal > MsQuicLib.RecvWindowAutoTuneLimit) {
+        InterlockedExchangeAdd64(
+            (int64_t*)&MsQuicLib.RecvWindowAutoTuneBytes, -(int64_t)Grow);
+        return;
+    }
+    Send->RecvWindowAutoTuneBytes += Grow;
+
+    //
+    // Growth first pays off any credit still withheld from a previous shrink.
+    //
+    const uint64_t Repaid = CXPLAT_MIN(Grow, Send->RecvWindowShrinkDebt);
+    Send->RecvWindowShrinkDebt -= Repaid;
+    if (Grow > Repaid) {
+        Send->MaxData += Grow - Repaid;
+        QuicSendSetSendFlag(Send, QUIC_CONN_SEND_FLAG_MAX_DATA);
+    }
+}
+
 //
 // Criteria for sending MAX_DATA/MAX_STREAM_DATA frames:
 //
@@ -782,32 +889,43 @@ QuicStreamOnBytesDelivered(
     _In_ uint64_t BytesDelivered
     )
 {
+    QUIC_SEND* Send = &Stream->Connection->Send;
     const uint64_t RecvBufferDrainThreshold =
         Stream->RecvBuffer.VirtualBufferLength / QUIC_RECV_BUFFER_DRAIN_RATIO;
 
     Stream->RecvWindowBytesDelivered += BytesDelivered;
-    Stream->Connection->Send.MaxData += BytesDelivered;
 
-    Stream->Connection->Send.OrderedStreamBytesDeliveredAccumulator += BytesDelivered;
-    if (Stream->Connection->Send.OrderedStreamBytesDeliveredAccumulator >=
-        Stream->Connection->Settings.ConnFlowControlWindow / QUIC_RECV_BUFFER_DRAIN_RATIO) {
-        Stream->Connection->Send.OrderedStreamBytesDeliveredAccumulator = 0;
-        QuicSendSetSendFlag(
-            &Stream->Connection->Send,
-            QUIC_CONN_SEND_FLAG_MAX_DATA);
+    uint64_t Credit = BytesDelivered;
+    if (Send->RecvWindowShrinkDebt != 0) {
+        const uint64_t Withheld = CXPLAT_MIN(Credit, Send->RecvWindowShrinkDebt);
+        Send->RecvWindowShrinkDebt -= Withheld;
+        Credit -= Withheld;
+    }
+    Send->MaxData += Credit;
+
+    const uint64_t TimeNow = CxPlatTimeUs64();
+    QuicStreamRecvAutoTuneWindow(Stream->Connection, BytesDelivered, TimeNow);
+    const uint64_t ConnWindow =
+        Stream->Connection->Settings.ConnFlowControlWindow + Send->RecvWindowAutoTuneBytes;
+
+    Send->OrderedStreamBytesDeliveredAccumulator += BytesDelivered;
+    if (Send->OrderedStreamBytesDeliveredAccumulator >=
+        ConnWindow / QUIC_RECV_BUFFER_DRAIN_RATIO) {
+        Send->OrderedStreamBytesDeliveredAccumulator = 0;
+        QuicSendSetSendFlag(Send, QUIC_CONN_SEND_FLAG_MAX_DATA);
     }
 
     if (Stream->RecvWindowBytesDelivered >= RecvBufferDrainThreshold) {
 
-        uint64_t TimeNow = CxPlatTimeUs64();
-
         //
-        // Limit stream FC window growth by the connection FC window size.
+        // Limit stream FC window growth by the connection FC window size, and
+        // don't grow at all while buffer memory is short.
         // When using app-owned buffers, skip this: the virtual buffer length is entirely based
         // on the amount of buffer space provided by the app.
         //
         if (Stream->RecvBuffer.VirtualBufferLength != 0 &&
-            Stream->RecvBuffer.VirtualBufferLength < Stream->Connection->Settings.ConnFlowControlWindow) {
+            Stream->RecvBuffer.VirtualBufferLength < ConnWindow &&
+            QuicLibraryGetMemoryPressure() == QUIC_MEMORY_PRESSURE_NONE) {
 
             uint64_t TimeThreshold =
                 ((Stream->RecvWindowBytesDelivered * Stream->Connection->Paths[0].SmoothedRtt) / RecvBufferDrainThreshold);
@@ -823,7 +941,8 @@ QuicStreamOnBytesDelivered(
                 //   R / QUIC_RECV_BUFFER_DRAIN_RATIO
                 //
                 // Double VirtualBufferLength to make sure it doesn't limit
-                // throughput.
+                // throughput, or jump straight to the connection's BDP based
+                // window if that is larger.
                 //
                 // Mainly people complain about flow control when it limits
                 // throughput. But if we grow the buffer limit and then the app
@@ -832,15 +951,21 @@ QuicStreamOnBytesDelivered(
                 // low.
                 //
 
+                uint64_t NewLength =
+                    CXPLAT_MAX(
+                        (uint64_t)Stream->RecvBuffer.VirtualBufferLength * 2,
+                        CXPLAT_MIN(2 * Send->RecvBdp, ConnWindow));
+                NewLength = CXPLAT_MIN(NewLength, UINT32_MAX);
+
                 QuicRecvBufferIncreaseVirtualBufferLength(
                     &Stream->RecvBuffer,
-                    Stream->RecvBuffer.VirtualBufferLength * 2);
+                    (uint32_t)NewLength);
 
                 QuicTraceLogStreamVerbose(
                     IncreaseRxBuffer,
                     Stream,
                     "Increasing max RX buffer size to %u (MinRtt=%llu; TimeNow=%llu; LastUpdate=%llu)",
-                    Stream->RecvBuffer.VirtualBufferLength * 2,
+                    Stream->RecvBuffer.VirtualBufferLength,
                     Stream->Connection->Paths[0].MinRtt,
                     TimeNow,
                     Stream->RecvWindowLastUpdate);
@@ -875,11 +1000,9 @@ QuicStreamOnBytesDelivered(
     Stream->MaxAllowedRecvOffset =
         Stream->RecvBuffer.BaseOffset + Stream->RecvBuffer.VirtualBufferLength;
 
-    QuicSendSetSendFlag(
-        &Stream->Connection->Send,
-        QUIC_CONN_SEND_FLAG_MAX_DATA);
+    QuicSendSetSendFlag(Send, QUIC_CONN_SEND_FLAG_MAX_DATA);
     QuicSendSetStreamSendFlag(
-        &Stream->Connection->Send,
+        Send,
         Stream,
         QUIC_STREAM_SEND_FLAG_MAX_DATA,
         FALSE);
@@ -1120,6 +1243,7 @@ QuicStreamReceiveComplete(
         QuicRecvBufferDrain(&Stream->RecvBuffer, BufferLength)) {
         Stream->Flags.ReceiveDataPending = FALSE; // No more pending data to deliver.
     }
+    QuicStreamRecvUpdateMemoryUsage(Stream);
 
     if (BufferLength != 0) {
         Stream->RecvPendingLength -= BufferLength;
@@ -84,6 +84,90 @@ QuicStreamValidateRecoveryState(
 
 #endif
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicStreamApiSendPush(
+    _In_ QUIC_STREAM* Stream,
+    _In_ QUIC_SEND_REQUEST* SendRequest,
+    _Out_ BOOLEAN* WasEmpty
+    )
+{
+    QUIC_SEND_REQUEST* Head = (QUIC_SEND_REQUEST*)QuicReadPtrNoFence((void**)&Stream->ApiSendRequests);
+    for (;;) {
+        if (Head == QUIC_STREAM_API_SEND_CLOSED) {
+            return FALSE;
+        }
+        SendRequest->Next = Head;
+        QUIC_SEND_REQUEST* Prev =
+            (QUIC_SEND_REQUEST*)InterlockedCompareExchangePointer(
+                (void* volatile*)&Stream->ApiSendRequests,
+                SendRequest,
+                Head);
+        if (Prev == Head) {
+            break;
+        }
+        Head = Prev;
+    }
+    *WasEmpty = Head == NULL;
+    return TRUE;
+}
+
+//
+// Takes everything off the ApiSendRequests stack, optionally closing it to
+// further sends, and returns it in the order the app queued it.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+QUIC_SEND_REQUEST*
+QuicStreamApiSendDrain(
+    _In_ QUIC_STREAM* Stream,
+    _In_ BOOLEAN Close
+    )
+{
+    QUIC_SEND_REQUEST* Head;
+    if (Close) {
+        Head =
+            (QUIC_SEND_REQUEST*)InterlockedExchangePointer(
+                (void* volatile*)&Stream->ApiSendRequests,
+                QUIC_STREAM_API_SEND_CLOSED);
+    } else {
+        //
+        // Only the worker closes the stack, so once it is observed to be open
+        // the only possible race is with app threads pushing more requests.
+        //
+        Head = (QUIC_SEND_REQUEST*)QuicReadPtrNoFence((void**)&Stream->ApiSendRequests);
+        for (;;) {
+            if (Head == NULL || Head == QUIC_STREAM_API_SEND_CLOSED) {
+                return NULL;
+            }
+            QUIC_SEND_REQUEST* Prev =
+                (QUIC_SEND_REQUEST*)InterlockedCompareExchangePointer(
+                    (void* volatile*)&Stream->ApiSendRequests,
+                    NULL,
+                    Head);
+            if (Prev == Head) {
+                break;
+            }
+            Head = Prev;
+        }
+    }
+    if (Head == QUIC_STREAM_API_SEND_CLOSED) {
+        return NULL;
+    }
+
+    //
+    // Reverse the stack back into FIFO order.
+    //
+    QUIC_SEND_REQUEST* Ordered = NULL;
+    while (Head != NULL) {
+        QUIC_SEND_REQUEST* Next = Head->Next;
+        Head->Next = Ordered;
+        Ordered = Head;
+        Head = Next;
+    }
+    return Ordered;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicStreamIndicateSendShutdownComplete(
@@ -92,7 +176,7 @@ QuicStreamIndicateSendShutdownComplete(
     )
 {
     CXPLAT_DBG_ASSERT(!Stream->Flags.SendEnabled);
-    CXPLAT_DBG_ASSERT(Stream->ApiSendRequests == NULL);
+    CXPLAT_DBG_ASSERT(Stream->ApiSendRequests == QUIC_STREAM_API_SEND_CLOSED);
     CXPLAT_DBG_ASSERT(Stream->SendRequests == NULL);
 
     if (!Stream->Flags.HandleSendShutdown) {
@@ -132,11 +216,8 @@ QuicStreamSendShutdown(
     //
     QuicStreamRemoveOutFlowBlockedReason(Stream, QUIC_FLOW_BLOCKED_APP);
 
-    CxPlatDispatchLockAcquire(&Stream->ApiSendRequestLock);
     Stream->Flags.SendEnabled = FALSE;
-    QUIC_SEND_REQUEST* ApiSendRequests = Stream->ApiSendRequests;
-    Stream->ApiSendRequests = NULL;
-    CxPlatDispatchLockRelease(&Stream->ApiSendRequestLock);
+    QUIC_SEND_REQUEST* ApiSendRequests = QuicStreamApiSendDrain(Stream, TRUE);
 
     if (Graceful) {
         CXPLAT_DBG_ASSERT(!Silent);
@@ -454,13 +535,17 @@ QuicStreamCompleteSendRequest(
         }
 
         (void)QuicStreamIndicateEvent(Stream, &Event);
-    } else if (SendRequest->InternalBuffer.Length != 0) {
+    } else if (SendRequest->Content == NULL && SendRequest->InternalBuffer.Length != 0) {
         QuicSendBufferFree(
             &Connection->SendBuffer,
             SendRequest->InternalBuffer.Buffer,
             SendRequest->InternalBuffer.Length);
     }
 
+    if (SendRequest->Content != NULL) {
+        QuicContentRelease(SendRequest->Content);
+    }
+
     if (PreviouslyPosted) {
         CXPLAT_DBG_ASSERT(Connection->SendBuffer.PostedBytes >= SendRequest->TotalLength);
         Connection->SendBuffer.PostedBytes -= SendRequest->TotalLength;
@@ -473,6 +558,20 @@ QuicStreamCompleteSendRequest(
     CxPlatPoolFree(SendRequest);
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicContentRelease(
+    _In_ QUIC_CONTENT* Content
+    )
+{
+    if (CxPlatRefDecrement(&Content->RefCount)) {
+        if (Content->ReleaseHandler != NULL) {
+            Content->ReleaseHandler(Content->ReleaseContext);
+        }
+        CXPLAT_FREE(Content, QUIC_POOL_CONTENT);
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 QuicStreamSendBufferRequest(
@@ -484,7 +583,13 @@ QuicStreamSendBufferRequest(
 
     CXPLAT_DBG_ASSERT(Req->TotalLength <= UINT32_MAX);
 
-    if (Req->TotalLength != 0) {
+    if (Req->Content != NULL) {
+        //
+        // The bytes already live in shared content that the request holds a
+        // reference on, so there is nothing to copy.
+        //
+        CXPLAT_DBG_ASSERT(Req->Buffers == &Req->InternalBuffer);
+    } else if (Req->TotalLength != 0) {
         //
         // Copy the request bytes into an internal buffer.
         //
@@ -597,13 +702,12 @@ QuicStreamSendFlush(
     _In_ QUIC_STREAM* Stream
     )
 {
-    CxPlatDispatchLockAcquire(&Stream->ApiSendRequestLock);
-    QUIC_SEND_REQUEST* ApiSendRequests = Stream->ApiSendRequests;
-    Stream->ApiSendRequests = NULL;
-    CxPlatDispatchLockRelease(&Stream->ApiSendRequestLock);
+    QUIC_SEND_REQUEST* ApiSendRequests = QuicStreamApiSendDrain(Stream, FALSE);
     int64_t TotalBytesSent = 0;
 
     BOOLEAN Start = FALSE;
+    BOOLEAN DataQueued = FALSE;
+    BOOLEAN DelaySend = TRUE;
 
     while (ApiSendRequests != NULL) {
         QUIC_SEND_REQUEST* SendRequest = ApiSendRequests;
@@ -652,18 +756,28 @@ QuicStreamSendFlush(
                 0);
         }
 
+        DataQueued = TRUE;
+        if (!(SendRequest->Flags & QUIC_SEND_FLAG_DELAY_SEND)) {
+            DelaySend = FALSE;
+        }
+
+        CXPLAT_DBG_ASSERT(Stream->SendRequests != NULL);
+    }
+
+    if (DataQueued) {
+        //
+        // Schedule and buffer the whole batch at once, rather than per request.
+        //
         QuicSendSetStreamSendFlag(
             &Stream->Connection->Send,
             Stream,
             QUIC_STREAM_SEND_FLAG_DATA,
-            !!(SendRequest->Flags & QUIC_SEND_FLAG_DELAY_SEND));
+            DelaySend);
 
         if (Stream->Connection->Settings.SendBufferingEnabled) {
             QuicSendBufferFill(Stream->Connection);
         }
 
-        CXPLAT_DBG_ASSERT(Stream->SendRequests != NULL);
-
         QuicStreamSendDumpState(Stream);
     }
 
@@ -761,7 +761,9 @@ QuicWorkerLoop(
     }
 
     if (MsQuicLib.ExecutionConfig &&
-        (uint64_t)MsQuicLib.ExecutionConfig->PollingIdleTimeoutUs >
+        (uint64_t)CXPLAT_MIN(
+            MsQuicLib.ExecutionConfig->PollingIdleTimeoutUs,
+            State->PollingIdleLimitUs) >
             CxPlatTimeDiff64(State->LastWorkTime, State->TimeNow)) {
         //
         // Busy loop for a while to keep the thread hot in case new work comes
@@ -793,7 +795,7 @@ CXPLAT_THREAD_CALLBACK(QuicWorkerThread, Context)
     CXPLAT_EXECUTION_CONTEXT* EC = &Worker->ExecutionContext;
 
     CXPLAT_EXECUTION_STATE State = {
-        0, 0, 0, UINT32_MAX, 0, CxPlatCurThreadID()
+        0, 0, 0, UINT32_MAX, 0, CxPlatCurThreadID(), UINT32_MAX
     };
 
     QuicTraceEvent(
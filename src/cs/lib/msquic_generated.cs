@@ -219,6 +219,7 @@ namespace Microsoft.Quic
         NO_IDEAL_PROC = 0x0008,
         HIGH_PRIORITY = 0x0010,
         AFFINITIZE = 0x0020,
+        ADAPTIVE_POLLING = 0x0040,
     }
 
     internal unsafe partial struct QUIC_GLOBAL_EXECUTION_CONFIG
@@ -924,6 +925,21 @@ namespace Microsoft.Quic
 
         [NativeTypeName("uint32_t")]
         internal uint RttVariance;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong SendConnFlowControlBlockedTimeUs;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong RecvConnFlowControlWindow;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong SendDatagramsDroppedExpired;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong SendDatagramsDroppedBlocked;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong SendDatagramsDroppedTooLarge;
     }
 
     internal partial struct QUIC_NETWORK_STATISTICS
@@ -993,6 +1009,8 @@ namespace Microsoft.Quic
         SEND_STATELESS_RESET,
         SEND_STATELESS_RETRY,
         CONN_LOAD_REJECT,
+        WORK_ACTIVE_US,
+        WORK_POLL_US,
         MAX,
     }
 
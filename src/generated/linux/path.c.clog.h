@@ -145,6 +145,26 @@ tracepoint(CLOG_PATH_C, PathQeoDisabled , arg1, arg3);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for PathValidationTimeout
+// [conn][%p] Path[%hhu] validation timed out
+// QuicTraceLogConnInfo(
+                PathValidationTimeout,
+                Connection,
+                "Path[%hhu] validation timed out",
+                Path->ID);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Path->ID = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_PathValidationTimeout
+#define _clog_4_ARGS_TRACE_PathValidationTimeout(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_PATH_C, PathValidationTimeout , arg1, arg3);\
+
+#endif
+
+
+
+
 #ifdef __cplusplus
 }
 #endif
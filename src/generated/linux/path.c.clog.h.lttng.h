@@ -144,3 +144,26 @@ TRACEPOINT_EVENT(CLOG_PATH_C, PathQeoDisabled,
         ctf_integer(unsigned char, arg3, arg3)
     )
 )
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for PathValidationTimeout
+// [conn][%p] Path[%hhu] validation timed out
+// QuicTraceLogConnInfo(
+                PathValidationTimeout,
+                Connection,
+                "Path[%hhu] validation timed out",
+                Path->ID);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Path->ID = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_PATH_C, PathValidationTimeout,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned char, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned char, arg3, arg3)
+    )
+)
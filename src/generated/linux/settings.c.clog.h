@@ -677,6 +677,21 @@ tracepoint(CLOG_SETTINGS_C, SettingDestCidUpdateIdleTimeoutMs , arg2);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for SettingSendBufferLatencyTargetMs
+// [sett] SendBufferLatencyTargetMs = %u
+// QuicTraceLogVerbose(SettingSendBufferLatencyTargetMs,   "[sett] SendBufferLatencyTargetMs = %u", Settings->SendBufferLatencyTargetMs);
+// arg2 = arg2 = Settings->SendBufferLatencyTargetMs = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingSendBufferLatencyTargetMs
+#define _clog_3_ARGS_TRACE_SettingSendBufferLatencyTargetMs(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingSendBufferLatencyTargetMs , arg2);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for SettingGreaseQuicBitEnabled
 // [sett] GreaseQuicBitEnabled   = %hhu
@@ -827,6 +842,21 @@ tracepoint(CLOG_SETTINGS_C, SettingsStreamMultiReceiveEnabled , arg2);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for SettingsRecvWindowAutoTuneEnabled
+// [sett] RecvWindowAutoTuneEnabled= %hhu
+// QuicTraceLogVerbose(SettingsRecvWindowAutoTuneEnabled,  "[sett] RecvWindowAutoTuneEnabled= %hhu", Settings->RecvWindowAutoTuneEnabled);
+// arg2 = arg2 = Settings->RecvWindowAutoTuneEnabled = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingsRecvWindowAutoTuneEnabled
+#define _clog_3_ARGS_TRACE_SettingsRecvWindowAutoTuneEnabled(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingsRecvWindowAutoTuneEnabled , arg2);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for SettingDumpLFixedServerID
 // [sett] FixedServerID          = %u
@@ -872,6 +902,21 @@ tracepoint(CLOG_SETTINGS_C, SettingStreamMultiReceiveEnabled , arg2);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for SettingRecvWindowAutoTuneEnabled
+// [sett] RecvWindowAutoTuneEnabled  = %hhu
+// QuicTraceLogVerbose(SettingRecvWindowAutoTuneEnabled,       "[sett] RecvWindowAutoTuneEnabled  = %hhu", Settings->RecvWindowAutoTuneEnabled);
+// arg2 = arg2 = Settings->RecvWindowAutoTuneEnabled = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingRecvWindowAutoTuneEnabled
+#define _clog_3_ARGS_TRACE_SettingRecvWindowAutoTuneEnabled(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingRecvWindowAutoTuneEnabled , arg2);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for SettingsLoadInvalidAcceptableVersion
 // Invalid AcceptableVersion loaded from storage! 0x%x at position %d
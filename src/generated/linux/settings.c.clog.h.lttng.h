@@ -698,6 +698,22 @@ TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingDestCidUpdateIdleTimeoutMs,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for SettingSendBufferLatencyTargetMs
+// [sett] SendBufferLatencyTargetMs = %u
+// QuicTraceLogVerbose(SettingSendBufferLatencyTargetMs,   "[sett] SendBufferLatencyTargetMs = %u", Settings->SendBufferLatencyTargetMs);
+// arg2 = arg2 = Settings->SendBufferLatencyTargetMs = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingSendBufferLatencyTargetMs,
+    TP_ARGS(
+        unsigned int, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned int, arg2, arg2)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for SettingGreaseQuicBitEnabled
 // [sett] GreaseQuicBitEnabled   = %hhu
@@ -858,6 +874,22 @@ TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingsStreamMultiReceiveEnabled,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for SettingsRecvWindowAutoTuneEnabled
+// [sett] RecvWindowAutoTuneEnabled= %hhu
+// QuicTraceLogVerbose(SettingsRecvWindowAutoTuneEnabled,  "[sett] RecvWindowAutoTuneEnabled= %hhu", Settings->RecvWindowAutoTuneEnabled);
+// arg2 = arg2 = Settings->RecvWindowAutoTuneEnabled = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingsRecvWindowAutoTuneEnabled,
+    TP_ARGS(
+        unsigned char, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned char, arg2, arg2)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for SettingDumpLFixedServerID
 // [sett] FixedServerID          = %u
@@ -906,6 +938,22 @@ TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingStreamMultiReceiveEnabled,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for SettingRecvWindowAutoTuneEnabled
+// [sett] RecvWindowAutoTuneEnabled  = %hhu
+// QuicTraceLogVerbose(SettingRecvWindowAutoTuneEnabled,       "[sett] RecvWindowAutoTuneEnabled  = %hhu", Settings->RecvWindowAutoTuneEnabled);
+// arg2 = arg2 = Settings->RecvWindowAutoTuneEnabled = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingRecvWindowAutoTuneEnabled,
+    TP_ARGS(
+        unsigned char, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned char, arg2, arg2)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for SettingsLoadInvalidAcceptableVersion
 // Invalid AcceptableVersion loaded from storage! 0x%x at position %d
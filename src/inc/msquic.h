@@ -190,9 +190,19 @@ DEFINE_ENUM_FLAG_OPERATORS(QUIC_SEND_RESUMPTION_FLAGS)
 typedef enum QUIC_STREAM_SCHEDULING_SCHEME {
     QUIC_STREAM_SCHEDULING_SCHEME_FIFO          = 0x0000,   // Sends stream data first come, first served. (Default)
     QUIC_STREAM_SCHEDULING_SCHEME_ROUND_ROBIN   = 0x0001,   // Sends stream data evenly multiplexed.
+    QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR = 0x0002,   // Shares bandwidth by priority weight, with optional send deadlines.
     QUIC_STREAM_SCHEDULING_SCHEME_COUNT,                    // The number of stream scheduling schemes.
 } QUIC_STREAM_SCHEDULING_SCHEME;
 
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+typedef enum QUIC_PATH_SCHEDULING_SCHEME {
+    QUIC_PATH_SCHEDULING_SCHEME_ACTIVE          = 0x0000,   // Sends only on the active path. (Default)
+    QUIC_PATH_SCHEDULING_SCHEME_MIN_RTT         = 0x0001,   // Sends on the validated path with the lowest smoothed RTT.
+    QUIC_PATH_SCHEDULING_SCHEME_WEIGHTED        = 0x0002,   // Spreads sends over validated paths, weighted by inverse RTT.
+    QUIC_PATH_SCHEDULING_SCHEME_COUNT,                      // The number of path scheduling schemes.
+} QUIC_PATH_SCHEDULING_SCHEME;
+#endif
+
 typedef enum QUIC_STREAM_OPEN_FLAGS {
     QUIC_STREAM_OPEN_FLAG_NONE              = 0x0000,
     QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL    = 0x0001,   // Indicates the stream is unidirectional.
@@ -277,6 +287,7 @@ typedef enum QUIC_GLOBAL_EXECUTION_CONFIG_FLAGS {
     QUIC_GLOBAL_EXECUTION_CONFIG_FLAG_NO_IDEAL_PROC    = 0x0008,
     QUIC_GLOBAL_EXECUTION_CONFIG_FLAG_HIGH_PRIORITY    = 0x0010,
     QUIC_GLOBAL_EXECUTION_CONFIG_FLAG_AFFINITIZE       = 0x0020,
+    QUIC_GLOBAL_EXECUTION_CONFIG_FLAG_ADAPTIVE_POLLING = 0x0040,
 } QUIC_GLOBAL_EXECUTION_CONFIG_FLAGS;
 
 DEFINE_ENUM_FLAG_OPERATORS(QUIC_GLOBAL_EXECUTION_CONFIG_FLAGS)
@@ -649,6 +660,13 @@ typedef struct QUIC_STATISTICS_V2 {
 
     uint32_t RttVariance;                   // In microseconds
 
+    uint64_t SendConnFlowControlBlockedTimeUs; // Time sending was blocked by the peer's connection flow control.
+    uint64_t RecvConnFlowControlWindow;     // Current (auto-tuned) connection receive window, in bytes.
+
+    uint64_t SendDatagramsDroppedExpired;   // Datagrams dropped because their deadline passed before sending.
+    uint64_t SendDatagramsDroppedBlocked;   // Datagrams dropped by QUIC_SEND_FLAG_CANCEL_ON_BLOCKED.
+    uint64_t SendDatagramsDroppedTooLarge;  // Datagrams dropped because the max datagram size shrank.
+
     // N.B. New fields must be appended to end
 
 } QUIC_STATISTICS_V2;
@@ -714,6 +732,8 @@ typedef enum QUIC_PERFORMANCE_COUNTERS {
     QUIC_PERF_COUNTER_SEND_STATELESS_RESET, // Total stateless reset packets sent ever.
     QUIC_PERF_COUNTER_SEND_STATELESS_RETRY, // Total stateless retry packets sent ever.
     QUIC_PERF_COUNTER_CONN_LOAD_REJECT,     // Total connections rejected due to worker load.
+    QUIC_PERF_COUNTER_WORK_ACTIVE_US,       // Total microseconds workers spent processing work.
+    QUIC_PERF_COUNTER_WORK_POLL_US,         // Total microseconds workers spent polling without work.
     QUIC_PERF_COUNTER_MAX,
 } QUIC_PERFORMANCE_COUNTERS;
 
@@ -797,7 +817,9 @@ typedef struct QUIC_SETTINGS {
             uint64_t XdpEnabled                             : 1;
             uint64_t QTIPEnabled                            : 1;
             uint64_t ReservedRioEnabled                     : 1;
-            uint64_t RESERVED                               : 18;
+            uint64_t SendBufferLatencyTargetMs              : 1;
+            uint64_t RecvWindowAutoTuneEnabled              : 1;
+            uint64_t RESERVED                               : 16;
 #else
             uint64_t RESERVED                               : 26;
 #endif
@@ -851,7 +873,8 @@ typedef struct QUIC_SETTINGS {
             uint64_t XdpEnabled                : 1;
             uint64_t QTIPEnabled               : 1;
             uint64_t ReservedRioEnabled        : 1;
-            uint64_t ReservedFlags             : 55;
+            uint64_t RecvWindowAutoTuneEnabled : 1;
+            uint64_t ReservedFlags             : 54;
 #else
             uint64_t ReservedFlags             : 63;
 #endif
@@ -860,6 +883,7 @@ typedef struct QUIC_SETTINGS {
     uint32_t StreamRecvWindowBidiLocalDefault;
     uint32_t StreamRecvWindowBidiRemoteDefault;
     uint32_t StreamRecvWindowUnidiDefault;
+    uint32_t SendBufferLatencyTargetMs;
 
 } QUIC_SETTINGS;
 
@@ -984,10 +1008,12 @@ void
 #define QUIC_PARAM_GLOBAL_STATELESS_RESET_KEY           0x0100000B  // uint8_t[] - Array size is QUIC_STATELESS_RESET_KEY_LENGTH
 #define QUIC_PARAM_GLOBAL_STATISTICS_V2_SIZES           0x0100000C  // uint32_t[] - Array of sizes for each QUIC_STATISTICS_V2 version. Get-only. Pass a buffer of uint32_t, output count is variable. See documentation for details.
 #define QUIC_PARAM_GLOBAL_STATELESS_RETRY_CONFIG        0x0100000D  // QUIC_STATELESS_RETRY_CONFIG
+#define QUIC_PARAM_GLOBAL_BUFFER_MEMORY_LIMIT           0x0100000E  // uint64_t - bytes
 
 //
 // Parameters for Registration.
 //
+#define QUIC_PARAM_REGISTRATION_MEMORY_USAGE            0x02000000  // uint64_t - bytes. Get-only.
 
 //
 // Parameters for Configuration.
@@ -1050,6 +1076,8 @@ typedef struct QUIC_SCHANNEL_CREDENTIAL_ATTRIBUTE_W {
 #define QUIC_PARAM_CONN_SEND_DSCP                       0x05000019  // uint8_t
 #ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
 #define QUIC_PARAM_CONN_NETWORK_STATISTICS              0x05000020  // struct QUIC_NETWORK_STATISTICS
+#define QUIC_PARAM_CONN_PATH_SCHEDULING_SCHEME          0x05000021  // QUIC_PATH_SCHEDULING_SCHEME
+#define QUIC_PARAM_CONN_ADD_LOCAL_ADDRESS               0x05000022  // QUIC_ADDR
 #endif
 
 //
@@ -1084,6 +1112,7 @@ typedef struct QUIC_SCHANNEL_CONTEXT_ATTRIBUTE_EX_W {
 #ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
 #define QUIC_PARAM_STREAM_RELIABLE_OFFSET               0x08000005  // uint64_t
 #endif
+#define QUIC_PARAM_STREAM_SEND_DEADLINE                 0x08000006  // uint64_t - microseconds from now, 0 to clear
 
 typedef
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -1728,6 +1757,65 @@ QUIC_STATUS
     _In_reads_(BufferCount) const QUIC_BUFFER* Buffers
     );
 
+//
+// Shared content: an immutable payload that any number of streams, on any
+// connections, may send from without it being copied into each connection's
+// send buffer. The payload memory stays owned by the app and must remain valid
+// until the release callback is invoked, once the content has been closed and
+// no send still references it.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Function_class_(QUIC_CONTENT_RELEASE_CALLBACK)
+void
+(QUIC_API QUIC_CONTENT_RELEASE_CALLBACK)(
+    _In_opt_ void* Context
+    );
+
+typedef QUIC_CONTENT_RELEASE_CALLBACK *QUIC_CONTENT_RELEASE_CALLBACK_HANDLER;
+
+//
+// Opens a new content object over the app's buffer.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+(QUIC_API * QUIC_CONTENT_OPEN_FN)(
+    _In_ _Pre_defensive_ const QUIC_BUFFER* const Buffer,
+    _In_opt_ QUIC_CONTENT_RELEASE_CALLBACK_HANDLER Handler,
+    _In_opt_ void* Context,
+    _Outptr_ _At_(*Content, __drv_allocatesMem(Mem)) _Pre_defensive_
+        HQUIC* Content
+    );
+
+//
+// Releases the app's reference on the content. Sends already queued from it
+// are unaffected.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+(QUIC_API * QUIC_CONTENT_CLOSE_FN)(
+    _In_ _Pre_defensive_ __drv_freesMem(Mem)
+        HQUIC Content
+    );
+
+//
+// Queues a range of shared content to be sent on the stream. The send holds a
+// reference on the content until the range has been acknowledged or canceled.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+(QUIC_API * QUIC_STREAM_SEND_CONTENT_FN)(
+    _In_ _Pre_defensive_ HQUIC Stream,
+    _In_ _Pre_defensive_ HQUIC Content,
+    _In_ uint64_t Offset,
+    _In_ uint32_t Length,
+    _In_ QUIC_SEND_FLAGS Flags,
+    _In_opt_ void* ClientSendContext
+    );
+
 #endif
 
 //
@@ -1750,6 +1838,35 @@ QUIC_STATUS
     _In_opt_ void* ClientSendContext
     );
 
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+
+#define QUIC_DATAGRAM_PRIORITY_DEFAULT 0x7F     // Priority of datagrams queued with DatagramSend.
+
+typedef struct QUIC_DATAGRAM_SEND_ITEM {
+    QUIC_BUFFER Buffer;
+    uint64_t DeadlineUs;                        // Drop if still unsent this long after the call. Zero for none.
+    uint8_t Priority;                           // Higher values are sent first; equal values in order.
+    void* ClientContext;                        // Passed back with QUIC_CONNECTION_EVENT_DATAGRAM_SEND_STATE_CHANGED.
+} QUIC_DATAGRAM_SEND_ITEM;
+
+//
+// Queues a batch of unreliable datagrams in a single call. Each item completes
+// separately, exactly as if it were sent with DatagramSend. Items that are
+// still queued when their deadline passes are canceled instead of sent.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+(QUIC_API * QUIC_DATAGRAM_SEND_BATCH_FN)(
+    _In_ _Pre_defensive_ HQUIC Connection,
+    _In_reads_(ItemCount) _Pre_defensive_
+        const QUIC_DATAGRAM_SEND_ITEM* const Items,
+    _In_ uint32_t ItemCount,
+    _In_ QUIC_SEND_FLAGS Flags
+    );
+
+#endif // QUIC_API_ENABLE_PREVIEW_FEATURES
+
 //
 // Connection Pool API
 //
@@ -1763,6 +1880,22 @@ typedef enum QUIC_CONNECTION_POOL_FLAGS {
 
 DEFINE_ENUM_FLAG_OPERATORS(QUIC_CONNECTION_POOL_FLAGS);
 
+//
+// Invoked once, after every connection in the pool has either completed its
+// handshake or shut down without completing it.
+//
+typedef
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Function_class_(QUIC_CONNECTION_POOL_COMPLETE_CALLBACK)
+void
+(QUIC_API QUIC_CONNECTION_POOL_COMPLETE_CALLBACK)(
+    _In_opt_ void* Context,
+    _In_ uint16_t ConnectedCount,
+    _In_ uint16_t FailedCount
+    );
+
+typedef QUIC_CONNECTION_POOL_COMPLETE_CALLBACK *QUIC_CONNECTION_POOL_COMPLETE_CALLBACK_HANDLER;
+
 typedef struct QUIC_CONNECTION_POOL_CONFIG {
     HQUIC Registration;
     HQUIC Configuration;
@@ -1779,6 +1912,8 @@ typedef struct QUIC_CONNECTION_POOL_CONFIG {
         uint8_t** CibirIds;                     // Optional
     uint8_t CibirIdLength;                      // Zero if not using CIBIR
     QUIC_CONNECTION_POOL_FLAGS Flags;
+    QUIC_CONNECTION_POOL_COMPLETE_CALLBACK_HANDLER CompleteHandler; // Optional
+    void* CompleteContext;                      // Optional
 } QUIC_CONNECTION_POOL_CONFIG;
 
 //
@@ -1787,6 +1922,8 @@ typedef struct QUIC_CONNECTION_POOL_CONFIG {
 // Connections are spread evenly across RSS CPUs as much as possible.
 // If NumberOfConnections is more than the number of RSS cores, then multiple
 // connections will be put on the same CPU.
+// Returns as soon as all connections are started; handshakes complete in
+// parallel, and CompleteHandler (if set) is invoked once they all finish.
 //
 typedef
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -1861,6 +1998,12 @@ typedef struct QUIC_API_TABLE {
     QUIC_EXECUTION_DELETE_FN            ExecutionDelete;    // Available from v2.5
     QUIC_EXECUTION_POLL_FN              ExecutionPoll;      // Available from v2.5
 #endif // _KERNEL_MODE
+
+    QUIC_DATAGRAM_SEND_BATCH_FN         DatagramSendBatch;  // Available from v2.6
+
+    QUIC_CONTENT_OPEN_FN                ContentOpen;        // Available from v2.6
+    QUIC_CONTENT_CLOSE_FN               ContentClose;       // Available from v2.6
+    QUIC_STREAM_SEND_CONTENT_FN         StreamSendContent;  // Available from v2.6
 #endif // QUIC_API_ENABLE_PREVIEW_FEATURES
 
 } QUIC_API_TABLE;
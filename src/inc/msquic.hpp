@@ -714,6 +714,8 @@ public:
     MsQuicSettings& SetOneWayDelayEnabled(bool value) { OneWayDelayEnabled = value; IsSet.OneWayDelayEnabled = TRUE; return *this; }
     MsQuicSettings& SetNetStatsEventEnabled(bool value) { NetStatsEventEnabled = value; IsSet.NetStatsEventEnabled = TRUE; return *this; }
     MsQuicSettings& SetStreamMultiReceiveEnabled(bool value) { StreamMultiReceiveEnabled = value; IsSet.StreamMultiReceiveEnabled = TRUE; return *this; }
+    MsQuicSettings& SetSendBufferLatencyTargetMs(uint32_t Value) { SendBufferLatencyTargetMs = Value; IsSet.SendBufferLatencyTargetMs = TRUE; return *this; }
+    MsQuicSettings& SetRecvWindowAutoTuneEnabled(bool Value) { RecvWindowAutoTuneEnabled = Value; IsSet.RecvWindowAutoTuneEnabled = TRUE; return *this; }
 #endif
 
     QUIC_STATUS
@@ -1706,6 +1708,16 @@ struct MsQuicStream {
                 Priority);
     }
 
+    QUIC_STATUS
+    SetSendDeadline(_In_ uint64_t DeadlineUs) noexcept {
+        return
+            MsQuic->SetParam(
+                Handle,
+                QUIC_PARAM_STREAM_SEND_DEADLINE,
+                sizeof(DeadlineUs),
+                &DeadlineUs);
+    }
+
     QUIC_STATUS
     GetIdealSendBufferSize(_Out_ uint64_t* SendBufferSize) const noexcept {
         uint32_t Size = sizeof(*SendBufferSize);
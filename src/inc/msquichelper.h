@@ -199,6 +199,8 @@ DumpMsQuicPerfCounters(
     printf("  SEND_STATELESS_RESET:  %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_SEND_STATELESS_RESET]);
     printf("  SEND_STATELESS_RETRY:  %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_SEND_STATELESS_RETRY]);
     printf("  CONN_LOAD_REJECT:      %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_CONN_LOAD_REJECT]);
+    printf("  WORK_ACTIVE_US:        %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_WORK_ACTIVE_US]);
+    printf("  WORK_POLL_US:          %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_WORK_POLL_US]);
 }
 
 //
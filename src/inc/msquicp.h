@@ -69,6 +69,47 @@ typedef struct QUIC_TEST_DATAPATH_HOOKS {
     QUIC_TEST_DATAPATH_SEND_HOOK Send;
 } QUIC_TEST_DATAPATH_HOOKS;
 
+//
+// Emulation of a constrained network link, applied by the datapath to all
+// outgoing UDP socket traffic. Probabilities are in parts per million.
+//
+#define QUIC_NETWORK_EMULATION_MAX_RATE_SCHEDULE 16
+
+typedef struct QUIC_NETWORK_EMULATION_RATE {
+    uint32_t DurationMs;
+    uint32_t RateKbps;                  // Zero indicates a link outage.
+} QUIC_NETWORK_EMULATION_RATE;
+
+typedef struct QUIC_NETWORK_EMULATION_CONFIG {
+    uint32_t RateKbps;                  // Bottleneck rate. Zero for unlimited.
+    uint32_t BufferBytes;               // Bottleneck queue size. Zero for unlimited.
+    uint32_t DelayUs;                   // One-way propagation delay.
+    uint32_t GoodToBadProbability;      // Gilbert-Elliott transition probabilities.
+    uint32_t BadToGoodProbability;
+    uint32_t GoodLossProbability;       // Gilbert-Elliott loss probability per state.
+    uint32_t BadLossProbability;
+    uint32_t RateScheduleCount;         // Repeating rate schedule, overrides RateKbps.
+    QUIC_NETWORK_EMULATION_RATE RateSchedule[QUIC_NETWORK_EMULATION_MAX_RATE_SCHEDULE];
+} QUIC_NETWORK_EMULATION_CONFIG;
+
+//
+// Cycle counters for hot code paths, only collected when the library is built
+// with QUIC_ENABLE_PROFILING. Cycles are inclusive of nested stages (i.e. the
+// receive stage includes ACK processing, which includes congestion control).
+//
+typedef enum QUIC_PROFILE_STAGE {
+    QUIC_PROFILE_SEND_FLUSH,            // QuicSendFlush
+    QUIC_PROFILE_RECV_DATAGRAMS,        // QuicConnRecvDatagrams
+    QUIC_PROFILE_PROCESS_ACK,           // QuicLossDetectionProcessAckFrame
+    QUIC_PROFILE_CC_DATA_ACKED,         // Congestion control OnDataAcknowledged
+    QUIC_PROFILE_STAGE_MAX
+} QUIC_PROFILE_STAGE;
+
+typedef struct QUIC_PROFILE_COUNTER {
+    uint64_t Cycles;
+    uint64_t Calls;
+} QUIC_PROFILE_COUNTER;
+
 #if DEBUG
 //
 // Datapath hooks are currently only enabled on debug builds for functional
@@ -117,6 +158,8 @@ typedef struct QUIC_PRIVATE_TRANSPORT_PARAMETER {
 #define QUIC_PARAM_GLOBAL_IN_USE                        0x81000004  // BOOLEAN
 #define QUIC_PARAM_GLOBAL_DATAPATH_FEATURES             0x81000005  // uint32_t
 #define QUIC_PARAM_GLOBAL_PLATFORM_WORKER_POOL          0x81000006  // CXPLAT_WORKER_POOL*
+#define QUIC_PARAM_GLOBAL_NETWORK_EMULATION             0x81000007  // QUIC_NETWORK_EMULATION_CONFIG
+#define QUIC_PARAM_GLOBAL_PROFILE_COUNTERS              0x81000008  // QUIC_PROFILE_COUNTER[QUIC_PROFILE_STAGE_MAX]
 
 //
 // The different private parameters for Configuration.
@@ -499,6 +499,19 @@ CxPlatDataPathUpdatePollingIdleTimeout(
     _In_ uint32_t PollingIdleTimeoutUs
     );
 
+//
+// Enables (or disables, with a NULL config) emulation of a constrained network
+// link on all outgoing UDP socket traffic.
+//
+struct QUIC_NETWORK_EMULATION_CONFIG;
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatDataPathSetNetworkEmulation(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _In_opt_ const struct QUIC_NETWORK_EMULATION_CONFIG* Config
+    );
+
 //
 // Queries the currently supported features of the datapath for the given type
 // of socket.
@@ -601,6 +614,11 @@ typedef struct CXPLAT_UDP_CONFIG {
     uint8_t CibirIdOffsetSrc;           // CIBIR ID offset in source CID
     uint8_t CibirIdOffsetDst;           // CIBIR ID offset in destination CID
     uint8_t CibirId[6];                 // CIBIR ID data
+
+    // used for server socket steering
+    uint8_t PartitionIdOffset;          // Partition ID offset in short header packets. Value of 0 indicates steering isn't used
+    uint16_t PartitionIdMask;           // Partition index bits of the partition ID
+    uint16_t PartitionCount;            // Number of partitions the partition ID indexes
 } CXPLAT_UDP_CONFIG;
 
 //
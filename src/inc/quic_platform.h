@@ -161,6 +161,12 @@ typedef struct CXPLAT_SLIST_ENTRY {
 #define QUIC_POOL_DATAPATH_RSS_CONFIG       'F4cQ' // Qc4F - QUIC Datapath RSS configuration
 #define QUIC_POOL_TLS_AUX_DATA              '05cQ' // Qc50 - QUIC TLS Backing Aux data
 #define QUIC_POOL_TLS_RECORD_ENTRY          '15cQ' // Qc51 - QUIC TLS Backing Record storage
+#define QUIC_POOL_NETWORK_EMULATION         '25cQ' // Qc52 - QUIC Network emulation config
+#define QUIC_POOL_DATAGRAM_BATCH            '45cQ' // Qc54 - QUIC Datagram send batch
+#define QUIC_POOL_CONTENT                   '55cQ' // Qc55 - QUIC Shared send content
+#define QUIC_POOL_CONN_POOL_TRACKER         '65cQ' // Qc56 - QUIC Connection pool handshake tracker
+#define QUIC_POOL_DATAGRAM_TAILS            '75cQ' // Qc57 - QUIC Datagram priority level tails
+#define QUIC_POOL_REGISTRATION_MEMORY       '85cQ' // Qc58 - QUIC Registration per-partition memory usage
 
 typedef enum CXPLAT_THREAD_FLAGS {
     CXPLAT_THREAD_FLAG_NONE               = 0x0000,
@@ -467,6 +473,7 @@ typedef struct CXPLAT_EXECUTION_STATE {
     uint32_t WaitTime;
     uint32_t NoWorkCount;
     CXPLAT_THREAD_ID ThreadID;
+    uint32_t PollingIdleLimitUs;    // Upper bound on idle polling, in microseconds
 } CXPLAT_EXECUTION_STATE;
 
 typedef struct CXPLAT_WORKER_POOL CXPLAT_WORKER_POOL;
@@ -534,6 +541,17 @@ CxPlatWorkerPoolWorkerPoll(
     _In_ QUIC_EXECUTION* Execution
     );
 
+//
+// Sums the time all the workers spent processing work and polling without
+// finding any work.
+//
+void
+CxPlatWorkerPoolGetExecutionTime(
+    _In_ CXPLAT_WORKER_POOL* WorkerPool,
+    _Out_ uint64_t* ActiveTimeUs,
+    _Out_ uint64_t* PollTimeUs
+    );
+
 //
 // Supports more dynamic operations, but must be submitted to the platform worker
 // to manage.
@@ -236,6 +236,17 @@ InterlockedExchangePointer(
     return __sync_lock_test_and_set(Target, Value);
 }
 
+QUIC_INLINE
+void*
+InterlockedCompareExchangePointer(
+    _Inout_ _Interlocked_operand_ void* volatile *Destination,
+    _In_opt_ void* ExChange,
+    _In_opt_ void* Comperand
+    )
+{
+    return __sync_val_compare_and_swap(Destination, Comperand, ExChange);
+}
+
 QUIC_INLINE
 void*
 InterlockedFetchAndClearPointer(
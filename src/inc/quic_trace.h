@@ -108,6 +108,10 @@ typedef enum QUIC_TRACE_API_TYPE {
     QUIC_TRACE_API_EXECUTION_CREATE,
     QUIC_TRACE_API_EXECUTION_DELETE,
     QUIC_TRACE_API_EXECUTION_POLL,
+    QUIC_TRACE_API_DATAGRAM_SEND_BATCH,
+    QUIC_TRACE_API_CONTENT_OPEN,
+    QUIC_TRACE_API_CONTENT_CLOSE,
+    QUIC_TRACE_API_STREAM_SEND_CONTENT,
     QUIC_TRACE_API_COUNT // Must be last
 } QUIC_TRACE_API_TYPE;
 
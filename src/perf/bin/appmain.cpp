@@ -23,6 +23,48 @@ typedef struct {
 #include "quic_driver_helpers.h"
 #endif // _WIN32
 
+void
+QuicPrintLatencyResult(
+    _In_ uint32_t RPS,
+    _In_ const Statistics& LatencyStats,
+    _In_ const Percentiles& PercentileStats
+    )
+{
+    WriteOutput(
+        "Result: %u RPS, Latency,us 0th: %d, 50th: %.0f, 90th: %.0f, 99th: %.0f, 99.9th: %.0f, 99.99th: %.0f, 99.999th: %.0f, 99.9999th: %.0f, Max: %d\n",
+        RPS,
+        LatencyStats.Min,
+        PercentileStats.P50,
+        PercentileStats.P90,
+        PercentileStats.P99,
+        PercentileStats.P99p9,
+        PercentileStats.P99p99,
+        PercentileStats.P99p999,
+        PercentileStats.P99p9999,
+        LatencyStats.Max);
+}
+
+void
+QuicWriteLatencyHistogram(
+    _In_ const struct hdr_histogram* Histogram,
+    _In_z_ const char* FileName
+    )
+{
+#ifdef _WIN32
+    FILE* FilePtr = nullptr;
+    errno_t FileErr = fopen_s(&FilePtr, FileName, "w");
+#else
+    FILE* FilePtr = fopen(FileName, "w");
+    int FileErr = (FilePtr == nullptr) ? 1 : 0;
+#endif
+    if (FileErr) {
+        printf("Failed to open file '%s' for write, error: %d\n", FileName, FileErr);
+        return;
+    }
+    hdr_percentiles_print((struct hdr_histogram*)Histogram, FilePtr, 5, 1.0, CLASSIC);
+    fclose(FilePtr);
+}
+
 void
 QuicHandleExtraData(
     _In_reads_(Length) uint8_t* ExtraData,
@@ -51,31 +93,9 @@ QuicHandleExtraData(
     Statistics LatencyStats;
     Percentiles PercentileStats;
     GetStatistics((uint32_t*)ExtraData, MaxCount, &LatencyStats, &PercentileStats);
-    WriteOutput(
-        "Result: %u RPS, Latency,us 0th: %d, 50th: %.0f, 90th: %.0f, 99th: %.0f, 99.9th: %.0f, 99.99th: %.0f, 99.999th: %.0f, 99.9999th: %.0f, Max: %d\n",
-        RPS,
-        LatencyStats.Min,
-        PercentileStats.P50,
-        PercentileStats.P90,
-        PercentileStats.P99,
-        PercentileStats.P99p9,
-        PercentileStats.P99p99,
-        PercentileStats.P99p999,
-        PercentileStats.P99p9999,
-        LatencyStats.Max);
+    QuicPrintLatencyResult(RPS, LatencyStats, PercentileStats);
 
     if (FileName != nullptr) {
-#ifdef _WIN32
-        FILE* FilePtr = nullptr;
-        errno_t FileErr = fopen_s(&FilePtr, FileName, "w");
-#else
-        FILE* FilePtr = fopen(FileName, "w");
-        int FileErr = (FilePtr == nullptr) ? 1 : 0;
-#endif
-        if (FileErr) {
-            printf("Failed to open file '%s' for write, error: %d\n", FileName, FileErr);
-            return;
-        }
         struct hdr_histogram* histogram = nullptr;
         if (hdr_init(1, LatencyStats.Max, 3, &histogram)) {
             printf("Failed to create histogram\n");
@@ -83,10 +103,33 @@ QuicHandleExtraData(
             for (size_t i = 0; i < MaxCount; i++) {
                 hdr_record_value(histogram, ((uint32_t*)ExtraData)[i]);
             }
-            hdr_percentiles_print(histogram, FilePtr, 5, 1.0, CLASSIC);
+            QuicWriteLatencyHistogram(histogram, FileName);
             hdr_close(histogram);
         }
-        fclose(FilePtr);
+    }
+}
+
+void
+QuicHandleLatencyHistogram(
+    _In_ const struct hdr_histogram* Histogram,
+    _In_ uint64_t RunTime,
+    _In_ uint64_t CompletedRequests,
+    _In_opt_z_ const char* FileName
+    )
+{
+    uint32_t RPS = RunTime ? (uint32_t)((CompletedRequests * 1000ull * 1000ull) / RunTime) : 0;
+    if (RPS == 0 || Histogram->total_count == 0) {
+        printf("Error: No requests were completed\n");
+        return;
+    }
+
+    Statistics LatencyStats;
+    Percentiles PercentileStats;
+    GetHistogramStatistics(Histogram, &LatencyStats, &PercentileStats);
+    QuicPrintLatencyResult(RPS, LatencyStats, PercentileStats);
+
+    if (FileName != nullptr) {
+        QuicWriteLatencyHistogram(Histogram, FileName);
     }
 }
 
@@ -121,6 +164,13 @@ QuicUserMain(
         QuicHandleExtraData(Buffer.get(), DataLength, FileName);
     }
 
+    uint64_t RunTime, CompletedRequests;
+    if (const struct hdr_histogram* Histogram =
+            QuicMainGetLatencyHistogram(&RunTime, &CompletedRequests);
+        Histogram) {
+        QuicHandleLatencyHistogram(Histogram, RunTime, CompletedRequests, FileName);
+    }
+
 Exit:
     QuicMainFree();
     if (!SimpleOutput) {
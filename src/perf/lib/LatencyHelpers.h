@@ -11,6 +11,10 @@ Abstract:
 
 #pragma once
 
+#ifndef _KERNEL_MODE
+#include "histogram/hdr_histogram.h"
+#endif
+
 //
 // Forward declaration because of include issues with math.h
 //
@@ -145,3 +149,36 @@ GetStatistics(
     PercentileIndex = (uint32_t)(DataLength * 0.999999);
     PercentileStats->P99p9999 = Data[PercentileIndex];
 }
+
+#ifndef _KERNEL_MODE
+static
+void
+GetHistogramStatistics(
+    _In_ const struct hdr_histogram* Histogram,
+    _Out_ Statistics* AllStatistics,
+    _Out_ Percentiles* PercentileStats
+    )
+{
+    if (Histogram->total_count == 0) {
+        return;
+    }
+
+    const double StandardDeviation = hdr_stddev(Histogram);
+    *AllStatistics = Statistics {
+        hdr_mean(Histogram),
+        StandardDeviation * StandardDeviation,
+        StandardDeviation,
+        StandardDeviation / sqrt((double)Histogram->total_count),
+        (uint32_t)hdr_min(Histogram),
+        (uint32_t)hdr_max(Histogram)
+    };
+
+    PercentileStats->P50 = (double)hdr_value_at_percentile(Histogram, 50.0);
+    PercentileStats->P90 = (double)hdr_value_at_percentile(Histogram, 90.0);
+    PercentileStats->P99 = (double)hdr_value_at_percentile(Histogram, 99.0);
+    PercentileStats->P99p9 = (double)hdr_value_at_percentile(Histogram, 99.9);
+    PercentileStats->P99p99 = (double)hdr_value_at_percentile(Histogram, 99.99);
+    PercentileStats->P99p999 = (double)hdr_value_at_percentile(Histogram, 99.999);
+    PercentileStats->P99p9999 = (double)hdr_value_at_percentile(Histogram, 99.9999);
+}
+#endif
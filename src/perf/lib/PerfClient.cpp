@@ -31,6 +31,7 @@ PerfClient::Init(
     // Scenario profile sets new defauls for values below, that may then be
     // further overridden by command line arguments.
     //
+    const char* CcMix = nullptr;
     const char* ScenarioStr = GetValue(argc, argv, "scenario");
     if (ScenarioStr != nullptr) {
         if (IsValue(ScenarioStr, "upload")) {
@@ -61,6 +62,10 @@ PerfClient::Init(
             RunTime = S_TO_US(20); // 20 seconds
             RepeatStreams = TRUE;
             PrintLatency = TRUE;
+        } else if (IsValue(ScenarioStr, "fairness")) {
+            Upload = S_TO_US(20); // 20 seconds
+            Timed = TRUE;
+            CcMix = "cubic:2,bbrresync:2,cubicprobe:1";
         } else if (IsValue(ScenarioStr, "latency")) {
             Upload = 512;
             Download = 4000;
@@ -156,6 +161,12 @@ PerfClient::Init(
     TryGetValue(argc, argv, "pstream", &PrintStreams);
     TryGetValue(argc, argv, "platency", &PrintLatency);
     TryGetValue(argc, argv, "plat", &PrintLatency);
+    TryGetValue(argc, argv, "pprofile", &PrintProfileCounters);
+#ifndef _KERNEL_MODE
+    TryGetVariableUnitValue(argc, argv, "latinterval", &LatencyInterval);
+#endif
+    TryGetVariableUnitValue(argc, argv, "timeseries", &TimeSeriesInterval);
+    TimeSeriesFile = GetValue(argc, argv, "tsfile");
 
     //
     // Scenario options
@@ -189,6 +200,24 @@ PerfClient::Init(
     TryGetValue(argc, argv, "rstream", &RepeatStreams);
     TryGetValue(argc, argv, "rs", &RepeatStreams);
 
+    TryGetValue(argc, argv, "ccmix", &CcMix);
+    if (CcMix) {
+        if (UseTCP || RepeatConnections) {
+            WriteOutput("'ccmix' doesn't support TCP or repeated connections!\n");
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+        QUIC_STATUS Status = ParseCcMix(CcMix);
+        if (QUIC_FAILED(Status)) {
+            WriteOutput("Failed to parse ccmix[%s]!\n", CcMix);
+            return Status;
+        }
+        ConnectionCount = FlowCount;
+        if (!Upload) {
+            WriteOutput("'ccmix' requires an upload, as the client's congestion control is measured!\n");
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+    }
+
     if ((RepeatConnections || RepeatStreams) && !RunTime) {
         WriteOutput("Must specify a 'runtime' if using a repeat parameter!\n");
         return QUIC_STATUS_INVALID_PARAMETER;
@@ -203,6 +232,15 @@ PerfClient::Init(
             WriteOutput("TCP mode doesn't support CIBIR!\n");
             return QUIC_STATUS_INVALID_PARAMETER;
         }
+        if (TimeSeriesInterval) {
+            WriteOutput("TCP mode doesn't support 'timeseries'!\n");
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+    }
+
+    if (TimeSeriesInterval && TimeSeriesInterval < 1000) {
+        WriteOutput("'timeseries' interval must be at least 1ms!\n");
+        return QUIC_STATUS_INVALID_PARAMETER;
     }
 
     if ((Upload || Download) && !StreamCount) {
@@ -246,6 +284,26 @@ PerfClient::Init(
         }
 #endif
         Configuration.SetSettings(Settings);
+
+        for (uint32_t i = 0; i < FlowCount; ++i) {
+            auto& CcConfiguration = CcConfigurations[FlowResults[i].Algorithm];
+            if (CcConfiguration) {
+                continue;
+            }
+            CcConfiguration.reset(
+                new(std::nothrow) MsQuicConfiguration(
+                    Registration,
+                    MsQuicAlpn(PERF_ALPN),
+                    DefaultSettings()
+                        .SetCongestionControlAlgorithm(
+                            (QUIC_CONGESTION_CONTROL_ALGORITHM)FlowResults[i].Algorithm),
+                    CredentialConfig));
+            if (!CcConfiguration || !CcConfiguration->IsValid() ||
+                QUIC_FAILED(CcConfiguration->SetSettings(Settings))) {
+                WriteOutput("Failed to create configuration for ccmix!\n");
+                return QUIC_STATUS_INTERNAL_ERROR;
+            }
+        }
     }
 
     //
@@ -260,6 +318,23 @@ PerfClient::Init(
 
     RequestBuffer.Init(IoSize, Timed ? UINT64_MAX : Download);
     if (PrintLatency) {
+#ifndef _KERNEL_MODE
+        //
+        // Each worker records into its own histogram, which is drained into
+        // the merged one at each interval and at the end, so memory use doesn't
+        // grow with the length of the run.
+        //
+        if (hdr_init(1, UINT32_MAX, 3, &Latency) ||
+            hdr_init(1, UINT32_MAX, 3, &IntervalLatency)) {
+            return QUIC_STATUS_OUT_OF_MEMORY;
+        }
+        for (uint32_t i = 0; i < WorkerCount; ++i) {
+            if (hdr_init(1, UINT32_MAX, 3, &Workers[i].Latency)) {
+                return QUIC_STATUS_OUT_OF_MEMORY;
+            }
+        }
+        LastLatencyCollectTime = CxPlatTimeUs64();
+#else
         if (RunTime) {
             MaxLatencyIndex = ((uint64_t)RunTime / (1000 * 1000)) * PERF_MAX_REQUESTS_PER_SECOND;
             if (MaxLatencyIndex > (UINT32_MAX / sizeof(uint32_t))) {
@@ -276,11 +351,209 @@ PerfClient::Init(
             return QUIC_STATUS_OUT_OF_MEMORY;
         }
         CxPlatZeroMemory(LatencyValues.get(), (size_t)(sizeof(uint32_t) * MaxLatencyIndex));
+#endif
+    }
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+QUIC_STATUS
+PerfClient::ParseCcMix(
+    _In_z_ const char* CcMix
+    ) {
+    //
+    // Format: <algo>[:<count>][,<algo>[:<count>]...]
+    // Longer names come first, since matching is by prefix.
+    //
+    static const struct {
+        const char* Name;
+        QUIC_CONGESTION_CONTROL_ALGORITHM Algorithm;
+    } Algorithms[] = {
+        { "cubicprobe", QUIC_CONGESTION_CONTROL_ALGORITHM_CUBICPROBE },
+        { "cubic", QUIC_CONGESTION_CONTROL_ALGORITHM_CUBIC },
+        { "bbrresync", QUIC_CONGESTION_CONTROL_ALGORITHM_BBRRESYNC },
+        { "bbr", QUIC_CONGESTION_CONTROL_ALGORITHM_BBR },
+    };
+
+    uint8_t FlowAlgorithms[PERF_MAX_FLOW_COUNT];
+    FlowCount = 0;
+    do {
+        if (*CcMix == ',') CcMix++;
+        uint32_t i = 0;
+        while (i < ARRAYSIZE(Algorithms) && !IsValue(CcMix, Algorithms[i].Name)) {
+            ++i;
+        }
+        if (i == ARRAYSIZE(Algorithms)) {
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+        CcMix += strlen(Algorithms[i].Name);
+        uint32_t Count = 1;
+        if (*CcMix == ':') {
+            CcMix++;
+            Count = (uint32_t)strtoul(CcMix, (char**)&CcMix, 10);
+        }
+        if (*CcMix != '\0' && *CcMix != ',') {
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+        if (Count > PERF_MAX_FLOW_COUNT - FlowCount) {
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+        while (Count-- > 0) {
+            FlowAlgorithms[FlowCount++] = (uint8_t)Algorithms[i].Algorithm;
+        }
+    } while (*CcMix);
+
+    if (FlowCount == 0) {
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+    FlowResults.reset(new(std::nothrow) PerfFlowResult[FlowCount]);
+    if (!FlowResults) {
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+    CxPlatZeroMemory(FlowResults.get(), sizeof(PerfFlowResult) * FlowCount);
+    for (uint32_t i = 0; i < FlowCount; ++i) {
+        FlowResults[i].Algorithm = FlowAlgorithms[i];
     }
 
     return QUIC_STATUS_SUCCESS;
 }
 
+void
+PerfClient::PrintFairness(
+    ) {
+    static const char* AlgorithmNames[] = { "cubic", "cubicprobe", "bbrresync", "bbr" };
+    static_assert(ARRAYSIZE(AlgorithmNames) == QUIC_CONGESTION_CONTROL_ALGORITHM_MAX, "Missing algorithm name");
+
+    uint64_t TotalRate = 0;
+    uint64_t SumOfSquares = 0;
+    uint32_t CompletedCount = 0;
+    uint64_t AlgorithmRates[QUIC_CONGESTION_CONTROL_ALGORITHM_MAX] = {0};
+    uint32_t AlgorithmFlows[QUIC_CONGESTION_CONTROL_ALGORITHM_MAX] = {0};
+
+    for (uint32_t i = 0; i < FlowCount; ++i) {
+        const auto& Flow = FlowResults[i];
+        AlgorithmFlows[Flow.Algorithm]++;
+        if (!Flow.Completed) {
+            WriteOutput("Flow %u (%s): did not complete\n", i, AlgorithmNames[Flow.Algorithm]);
+            continue;
+        }
+        //
+        // RTT inflation is the flow's final smoothed RTT over its minimum RTT,
+        // i.e. how much queuing delay it ended up seeing at the bottleneck.
+        //
+        const uint32_t Inflation = Flow.MinRtt ? (uint32_t)((uint64_t)Flow.Rtt * 100 / Flow.MinRtt) : 0;
+        WriteOutput(
+            "Flow %u (%s): %u kbps, RTT %u us (min %u us, max %u us, inflation %u.%02ux)\n",
+            i,
+            AlgorithmNames[Flow.Algorithm],
+            Flow.RateKbps,
+            Flow.Rtt,
+            Flow.MinRtt,
+            Flow.MaxRtt,
+            Inflation / 100,
+            Inflation % 100);
+        TotalRate += Flow.RateKbps;
+        SumOfSquares += (uint64_t)Flow.RateKbps * Flow.RateKbps;
+        AlgorithmRates[Flow.Algorithm] += Flow.RateKbps;
+        CompletedCount++;
+    }
+
+    if (TotalRate == 0) {
+        WriteOutput("Result: No flows completed!\n");
+        return;
+    }
+
+    for (uint32_t i = 0; i < QUIC_CONGESTION_CONTROL_ALGORITHM_MAX; ++i) {
+        if (AlgorithmFlows[i]) {
+            WriteOutput(
+                "Result: %s %u flows, %llu kbps (%llu%% share)\n",
+                AlgorithmNames[i],
+                AlgorithmFlows[i],
+                (unsigned long long)AlgorithmRates[i],
+                (unsigned long long)(AlgorithmRates[i] * 100 / TotalRate));
+        }
+    }
+
+    //
+    // Jain's fairness index: (sum x)^2 / (n * sum x^2), in thousandths. It is
+    // computed in integers (as this also runs in kernel mode) and ordered to
+    // stay within 64 bits for rates up to 100 Gbps.
+    //
+    const uint64_t Jain =
+        (TotalRate * (TotalRate / CompletedCount)) / CXPLAT_MAX(1, SumOfSquares / 1000);
+    WriteOutput(
+        "Result: Jain's fairness index %llu.%03llu across %u flows\n",
+        (unsigned long long)(Jain / 1000),
+        (unsigned long long)(Jain % 1000),
+        CompletedCount);
+}
+
+bool
+PerfClient::GetProfileCounters(
+    _Out_writes_(QUIC_PROFILE_STAGE_MAX) QUIC_PROFILE_COUNTER* Counters,
+    _Out_writes_(2) int64_t* Datagrams
+    ) {
+    uint32_t BufferLength = sizeof(QUIC_PROFILE_COUNTER) * QUIC_PROFILE_STAGE_MAX;
+    if (QUIC_FAILED(
+        MsQuic->GetParam(
+            nullptr,
+            QUIC_PARAM_GLOBAL_PROFILE_COUNTERS,
+            &BufferLength,
+            Counters))) {
+        return false;
+    }
+
+    int64_t PerfCounters[QUIC_PERF_COUNTER_MAX] = {0};
+    BufferLength = sizeof(PerfCounters);
+    if (QUIC_FAILED(
+        MsQuic->GetParam(
+            nullptr,
+            QUIC_PARAM_GLOBAL_PERF_COUNTERS,
+            &BufferLength,
+            PerfCounters))) {
+        return false;
+    }
+    Datagrams[0] = PerfCounters[QUIC_PERF_COUNTER_UDP_RECV];
+    Datagrams[1] = PerfCounters[QUIC_PERF_COUNTER_UDP_SEND];
+    return true;
+}
+
+void
+PerfClient::PrintProfile(
+    ) {
+    static const char* StageNames[] = { "SendFlush", "RecvDatagrams", "ProcessAck", "CcDataAcked" };
+    static_assert(ARRAYSIZE(StageNames) == QUIC_PROFILE_STAGE_MAX, "Missing stage name");
+
+    QUIC_PROFILE_COUNTER Counters[QUIC_PROFILE_STAGE_MAX];
+    int64_t Datagrams[2];
+    if (!GetProfileCounters(Counters, Datagrams)) {
+        WriteOutput("Profile counters not available. Build with QUIC_ENABLE_PROFILING.\n");
+        return;
+    }
+
+    //
+    // Counters are library wide (client and server, when run in the same
+    // process) and cumulative, so report the delta over this run. Cycles per
+    // packet use sent datagrams for the send stage and received datagrams for
+    // the rest.
+    //
+    const uint64_t RecvCount = (uint64_t)(Datagrams[0] - ProfileDatagramsStart[0]);
+    const uint64_t SendCount = (uint64_t)(Datagrams[1] - ProfileDatagramsStart[1]);
+    for (uint32_t i = 0; i < QUIC_PROFILE_STAGE_MAX; ++i) {
+        const uint64_t Cycles = Counters[i].Cycles - ProfileStart[i].Cycles;
+        const uint64_t Calls = Counters[i].Calls - ProfileStart[i].Calls;
+        const uint64_t Packets = i == QUIC_PROFILE_SEND_FLUSH ? SendCount : RecvCount;
+        WriteOutput(
+            "Profile: %-14s %llu cycles, %llu calls, %llu cycles/call, %llu cycles/packet\n",
+            StageNames[i],
+            (unsigned long long)Cycles,
+            (unsigned long long)Calls,
+            (unsigned long long)(Calls ? Cycles / Calls : 0),
+            (unsigned long long)(Packets ? Cycles / Packets : 0));
+    }
+}
+
 static void AppendIntToString(char* String, uint8_t Value) {
     const char* Hex = "0123456789ABCDEF";
     String[0] = Hex[(Value >> 4) & 0xF];
@@ -293,6 +566,13 @@ PerfClient::Start(
     _In_ CXPLAT_EVENT* StopEvent
     ) {
     CompletionEvent = StopEvent;
+    StartTime = CxPlatTimeUs64();
+
+    if (PrintProfileCounters &&
+        !GetProfileCounters(ProfileStart, ProfileDatagramsStart)) {
+        WriteOutput("Warning: Profile counters not available. Build with QUIC_ENABLE_PROFILING.\n");
+        PrintProfileCounters = FALSE;
+    }
 
     //
     // Configure and start all the workers.
@@ -355,6 +635,30 @@ PerfClient::Wait(
         Timeout = RunTime < 1000 ? 1 : (int)US_TO_MS(RunTime);
     }
 
+#ifndef _KERNEL_MODE
+    if (Latency && LatencyInterval) {
+        //
+        // Wake up every interval to report the latency of the requests that
+        // completed in it.
+        //
+        const uint64_t WaitStart = CxPlatTimeUs64();
+        for (;;) {
+            uint64_t WaitMs = CXPLAT_MAX(1, US_TO_MS(LatencyInterval));
+            if (Timeout) {
+                const uint64_t ElapsedMs = US_TO_MS(CxPlatTimeDiff64(WaitStart, CxPlatTimeUs64()));
+                if (ElapsedMs >= (uint64_t)Timeout) {
+                    break;
+                }
+                WaitMs = CXPLAT_MIN(WaitMs, (uint64_t)Timeout - ElapsedMs);
+            }
+            const bool Completed = CxPlatEventWaitWithTimeout(*CompletionEvent, (uint32_t)WaitMs);
+            CollectLatency(true);
+            if (Completed) {
+                break;
+            }
+        }
+    } else
+#endif
     if (Timeout) {
         CxPlatEventWaitWithTimeout(*CompletionEvent, Timeout);
     } else {
@@ -373,6 +677,24 @@ PerfClient::Wait(
         return QUIC_STATUS_CONNECTION_REFUSED;
     }
 
+    if (TimeSeriesInterval) {
+        WriteTimeSeries();
+    }
+
+    if (FlowCount) {
+        PrintFairness();
+    }
+
+    if (PrintProfileCounters) {
+        PrintProfile();
+    }
+
+#ifndef _KERNEL_MODE
+    if (Latency) {
+        CollectLatency(false);
+    }
+#endif
+
     unsigned long long CompletedConnections = GetConnectedConnections();
     unsigned long long CompletedStreams = GetStreamsCompleted();
 
@@ -442,6 +764,110 @@ PerfClient::GetExtraData(
     CxPlatCopyMemory(Data, LatencyValues.get(), (size_t)(Count * sizeof(uint32_t)));
 }
 
+#ifndef _KERNEL_MODE
+void
+PerfClient::CollectLatency(
+    _In_ bool PrintInterval
+    ) {
+    const uint64_t Now = CxPlatTimeUs64();
+    hdr_reset(IntervalLatency);
+    for (uint32_t i = 0; i < WorkerCount; ++i) {
+        Workers[i].Lock.Acquire();
+        hdr_add(IntervalLatency, Workers[i].Latency);
+        hdr_reset(Workers[i].Latency);
+        Workers[i].Lock.Release();
+    }
+    hdr_add(Latency, IntervalLatency);
+
+    const uint64_t ElapsedUs = CxPlatTimeDiff64(LastLatencyCollectTime, Now);
+    LastLatencyCollectTime = Now;
+    if (PrintInterval && IntervalLatency->total_count != 0 && ElapsedUs != 0) {
+        WriteOutput(
+            "Interval: %llu RPS, Latency,us 50th: %lld, 90th: %lld, 99th: %lld, 99.9th: %lld, Max: %lld\n",
+            (unsigned long long)(IntervalLatency->total_count * 1000 * 1000 / ElapsedUs),
+            (long long)hdr_value_at_percentile(IntervalLatency, 50.0),
+            (long long)hdr_value_at_percentile(IntervalLatency, 90.0),
+            (long long)hdr_value_at_percentile(IntervalLatency, 99.0),
+            (long long)hdr_value_at_percentile(IntervalLatency, 99.9),
+            (long long)hdr_max(IntervalLatency));
+    }
+}
+
+#define TimeSeriesOutput(...) \
+    (File ? (void)fprintf(File, __VA_ARGS__) : (void)WriteOutput(__VA_ARGS__))
+#else
+#define TimeSeriesOutput(...) (void)WriteOutput(__VA_ARGS__)
+#endif
+
+void
+PerfClient::WriteTimeSeries(
+    ) {
+#ifndef _KERNEL_MODE
+    FILE* File = nullptr;
+    if (TimeSeriesFile) {
+        File = fopen(TimeSeriesFile, "w");
+        if (!File) {
+            WriteOutput("Failed to open time series file '%s'!\n", TimeSeriesFile);
+        }
+    }
+#endif
+
+    TimeSeriesOutput(
+        "time_ms,worker,conn,rtt_us,min_rtt_us,cwnd,send_kbps,recv_kbps,lost_packets,congestion_events,mtu\n");
+
+    //
+    // Each worker's samples are already in time order, so just merge them.
+    //
+    const PerfTimeSeries::Block* Blocks[PERF_MAX_THREAD_COUNT];
+    uint32_t Indexes[PERF_MAX_THREAD_COUNT];
+    for (uint32_t i = 0; i < WorkerCount; ++i) {
+        Blocks[i] = Workers[i].TimeSeries.Head;
+        Indexes[i] = 0;
+    }
+
+    for (;;) {
+        uint32_t Next = UINT32_MAX;
+        for (uint32_t i = 0; i < WorkerCount; ++i) {
+            if (Blocks[i] && Indexes[i] == Blocks[i]->Count) {
+                Blocks[i] = Blocks[i]->Next;
+                Indexes[i] = 0;
+            }
+            if (Blocks[i] && Blocks[i]->Count != 0 &&
+                (Next == UINT32_MAX ||
+                 Blocks[i]->Samples[Indexes[i]].TimeUs <
+                    Blocks[Next]->Samples[Indexes[Next]].TimeUs)) {
+                Next = i;
+            }
+        }
+        if (Next == UINT32_MAX) {
+            break;
+        }
+
+        const PerfTimeSample* Sample = &Blocks[Next]->Samples[Indexes[Next]++];
+        TimeSeriesOutput(
+            "%llu.%03u,%u,%u,%u,%u,%u,%llu,%llu,%llu,%u,%hu\n",
+            (unsigned long long)(Sample->TimeUs / 1000),
+            (uint32_t)(Sample->TimeUs % 1000),
+            Next,
+            Sample->ConnectionId,
+            Sample->Rtt,
+            Sample->MinRtt,
+            Sample->CongestionWindow,
+            (unsigned long long)(Sample->SendBytes * 8 * 1000 / TimeSeriesInterval),
+            (unsigned long long)(Sample->RecvBytes * 8 * 1000 / TimeSeriesInterval),
+            (unsigned long long)Sample->LostPackets,
+            Sample->CongestionEvents,
+            Sample->PathMtu);
+    }
+
+#ifndef _KERNEL_MODE
+    if (File) {
+        fclose(File);
+        WriteOutput("Time series written to '%s'\n", TimeSeriesFile);
+    }
+#endif
+}
+
 void
 PerfClientWorker::WorkerThread() {
 #ifdef QUIC_COMPARTMENT_ID
@@ -454,14 +880,108 @@ PerfClientWorker::WorkerThread() {
     }
 #endif
 
+    const uint64_t Interval = Client->TimeSeriesInterval;
+    uint64_t NextSampleTime = Interval ? CxPlatTimeUs64() + Interval : 0;
+
     while (Client->Running) {
         while (Client->Running && ConnectionsCreated < ConnectionsQueued) {
             StartNewConnection();
         }
-        WakeEvent.WaitForever();
+        if (Interval) {
+            uint64_t Now = CxPlatTimeUs64();
+            if (Now >= NextSampleTime) {
+                SampleTimeSeries(Now);
+                NextSampleTime += Interval;
+                if (NextSampleTime <= Now) {
+                    NextSampleTime = Now + Interval; // Fell behind; skip intervals
+                }
+            }
+            WakeEvent.WaitTimeout((uint32_t)US_TO_MS(NextSampleTime - Now) + 1);
+        } else {
+            WakeEvent.WaitForever();
+        }
     }
 }
 
+void
+PerfClientWorker::SampleTimeSeries(
+    _In_ uint64_t Now
+    ) {
+    //
+    // Collect the connections to sample under the lock, but query them outside
+    // of it, because GetParam blocks on the connection's worker, which may be
+    // trying to free the connection. Connections freed while being sampled are
+    // freed here instead.
+    //
+    Lock.Acquire();
+    if (TimeSeriesConnectionCount > SampleConnectionsCapacity) {
+        const uint32_t NewCapacity = CXPLAT_MAX(TimeSeriesConnectionCount, 2 * SampleConnectionsCapacity);
+        auto NewArray = new(std::nothrow) PerfClientConnection*[NewCapacity];
+        if (NewArray) {
+            SampleConnections.reset(NewArray);
+            SampleConnectionsCapacity = NewCapacity;
+        }
+    }
+    uint32_t Count = 0;
+    for (CXPLAT_LIST_ENTRY* Entry = TimeSeriesConnections.Flink;
+         Entry != &TimeSeriesConnections && Count < SampleConnectionsCapacity;
+         Entry = Entry->Flink) {
+        auto Connection = ((PerfClientConnection::TimeSeriesEntry*)Entry)->Connection;
+        Connection->Sampling = true;
+        SampleConnections[Count++] = Connection;
+    }
+    Lock.Release();
+
+    const uint64_t TimeUs = CxPlatTimeDiff64(Client->StartTime, Now);
+    for (uint32_t i = 0; i < Count; ++i) {
+        SampleConnections[i]->Sample(TimeUs);
+    }
+
+    uint32_t FreeCount = 0;
+    Lock.Acquire();
+    for (uint32_t i = 0; i < Count; ++i) {
+        auto Connection = SampleConnections[i];
+        Connection->Sampling = false;
+        if (Connection->PendingFree) {
+            SampleConnections[FreeCount++] = Connection;
+        }
+    }
+    Lock.Release();
+
+    for (uint32_t i = 0; i < FreeCount; ++i) {
+        ConnectionPool.Free(SampleConnections[i]);
+    }
+}
+
+void
+PerfClientWorker::AddTimeSeriesConnection(
+    _In_ PerfClientConnection* Connection
+    ) {
+    Lock.Acquire();
+    Connection->TimeSeriesId = (uint32_t)ConnectionsCreated;
+    CxPlatListInsertTail(&TimeSeriesConnections, &Connection->TimeSeriesLink.Link);
+    TimeSeriesConnectionCount++;
+    Lock.Release();
+}
+
+void
+PerfClientWorker::FreeConnection(
+    _In_ PerfClientConnection* Connection
+    ) {
+    if (Connection->TimeSeriesLink.Link.Flink) {
+        Lock.Acquire();
+        CxPlatListEntryRemove(&Connection->TimeSeriesLink.Link);
+        Connection->TimeSeriesLink.Link.Flink = nullptr;
+        TimeSeriesConnectionCount--;
+        const bool Deferred = Connection->PendingFree = Connection->Sampling;
+        Lock.Release();
+        if (Deferred) {
+            return; // Freed once sampling completes
+        }
+    }
+    ConnectionPool.Free(Connection);
+}
+
 void
 PerfClientWorker::StartNewConnection() {
     InterlockedIncrement64((int64_t*)&ConnectionsCreated);
@@ -496,7 +1016,7 @@ PerfClientConnection::Initialize() {
         TcpConn = // TODO: replace new/delete with pool alloc/free
             new (std::nothrow) TcpConnection(Client.Engine.get(), &Client.TcpConfig, this);
         if (!TcpConn->IsInitialized()) {
-            Worker.ConnectionPool.Free(this);
+            Worker.FreeConnection(this);
             return;
         }
 
@@ -506,7 +1026,7 @@ PerfClientConnection::Initialize() {
                 Worker.RemoteAddr.GetPort(),
                 Worker.LocalAddr.GetFamily() != QUIC_ADDRESS_FAMILY_UNSPEC ? &Worker.LocalAddr.SockAddr : nullptr,
                 &Worker.RemoteAddr.SockAddr)) {
-            Worker.ConnectionPool.Free(this);
+            Worker.FreeConnection(this);
             return;
         }
 
@@ -517,10 +1037,21 @@ PerfClientConnection::Initialize() {
                 PerfClientConnection::s_ConnectionCallback,
                 this,
                 &Handle))) {
-            Worker.ConnectionPool.Free(this);
+            Worker.FreeConnection(this);
             return;
         }
 
+        if (Client.TimeSeriesInterval) {
+            Worker.AddTimeSeriesConnection(this);
+        }
+
+        const MsQuicConfiguration* Configuration = &Client.Configuration;
+        if (Client.FlowCount) {
+            FlowIndex = (uint32_t)InterlockedIncrement64((int64_t*)&Client.NextFlowIndex) - 1;
+            Configuration =
+                Client.CcConfigurations[Client.FlowResults[FlowIndex].Algorithm].get();
+        }
+
         QUIC_STATUS Status;
         BOOLEAN Value;
         if (!Client.UseEncryption) {
@@ -533,7 +1064,7 @@ PerfClientConnection::Initialize() {
                     &Value);
             if (QUIC_FAILED(Status)) {
                 WriteOutput("SetDisable1RttEncryption failed, 0x%x\n", Status);
-                Worker.ConnectionPool.Free(this);
+                Worker.FreeConnection(this);
                 return;
             }
         }
@@ -547,7 +1078,7 @@ PerfClientConnection::Initialize() {
                     &PerfDefaultDscpValue);
             if (QUIC_FAILED(Status)) {
                 WriteOutput("SetSendDscp failed, 0x%x\n", Status);
-                Worker.ConnectionPool.Free(this);
+                Worker.FreeConnection(this);
                 return;
             }
         }
@@ -561,7 +1092,7 @@ PerfClientConnection::Initialize() {
                     Client.CibirId);
             if (QUIC_FAILED(Status)) {
                 WriteOutput("SetCibirId failed, 0x%x\n", Status);
-                Worker.ConnectionPool.Free(this);
+                Worker.FreeConnection(this);
                 return;
             }
         }
@@ -576,7 +1107,7 @@ PerfClientConnection::Initialize() {
                     &Value);
             if (QUIC_FAILED(Status)) {
                 WriteOutput("SetShareUdpBinding failed, 0x%x\n", Status);
-                Worker.ConnectionPool.Free(this);
+                Worker.FreeConnection(this);
                 return;
             }
 
@@ -589,7 +1120,7 @@ PerfClientConnection::Initialize() {
                         &Worker.LocalAddr);
                 if (QUIC_FAILED(Status)) {
                     WriteOutput("SetLocalAddr failed!\n");
-                    Worker.ConnectionPool.Free(this);
+                    Worker.FreeConnection(this);
                     return;
                 }
             }
@@ -603,20 +1134,20 @@ PerfClientConnection::Initialize() {
                 &Worker.RemoteAddr);
         if (QUIC_FAILED(Status)) {
             WriteOutput("SetRemoteAddr failed!\n");
-            Worker.ConnectionPool.Free(this);
+            Worker.FreeConnection(this);
             return;
         }
 
         Status =
             MsQuic->ConnectionStart(
                 Handle,
-                Client.Configuration,
+                *Configuration,
                 Client.TargetFamily,
                 Worker.Target.get(),
                 Worker.RemoteAddr.GetPort());
         if (QUIC_FAILED(Status)) {
             WriteOutput("Start failed, 0x%x\n", Status);
-            Worker.ConnectionPool.Free(this);
+            Worker.FreeConnection(this);
             return;
         }
 
@@ -670,7 +1201,7 @@ PerfClientConnection::OnShutdownComplete() {
     if (!WorkerConnComplete) {
         Worker.OnConnectionComplete();
     }
-    Worker.ConnectionPool.Free(this);
+    Worker.FreeConnection(this);
 }
 
 void
@@ -742,6 +1273,45 @@ PerfClientConnection::Shutdown() {
     }
 }
 
+void
+PerfClientConnection::Sample(
+    _In_ uint64_t TimeUs
+    ) {
+    QUIC_STATISTICS_V2 Stats;
+    uint32_t StatsSize = sizeof(Stats);
+    if (QUIC_FAILED(
+        MsQuic->GetParam(
+            Handle,
+            QUIC_PARAM_CONN_STATISTICS_V2,
+            &StatsSize,
+            &Stats))) {
+        return;
+    }
+
+    auto TimeSample = Worker.TimeSeries.Append();
+    if (!TimeSample) {
+        return;
+    }
+
+    const uint64_t LostPackets =
+        Stats.SendSuspectedLostPackets - Stats.SendSpuriousLostPackets;
+    TimeSample->TimeUs = TimeUs;
+    TimeSample->ConnectionId = TimeSeriesId;
+    TimeSample->Rtt = Stats.Rtt;
+    TimeSample->MinRtt = Stats.MinRtt;
+    TimeSample->CongestionWindow = Stats.SendCongestionWindow;
+    TimeSample->SendBytes = Stats.SendTotalBytes - LastSendBytes;
+    TimeSample->RecvBytes = Stats.RecvTotalBytes - LastRecvBytes;
+    TimeSample->LostPackets = LostPackets > LastLostPackets ? LostPackets - LastLostPackets : 0;
+    TimeSample->CongestionEvents = Stats.SendCongestionCount - LastCongestionEvents;
+    TimeSample->PathMtu = Stats.SendPathMtu;
+
+    LastSendBytes = Stats.SendTotalBytes;
+    LastRecvBytes = Stats.RecvTotalBytes;
+    LastLostPackets = CXPLAT_MAX(LostPackets, LastLostPackets);
+    LastCongestionEvents = Stats.SendCongestionCount;
+}
+
 QUIC_STATUS
 PerfClientConnection::ConnectionCallback(
     _Inout_ QUIC_CONNECTION_EVENT* Event
@@ -994,6 +1564,24 @@ PerfClientStream::OnShutdown() {
             InterlockedExchangeAdd64(
                 (int64_t*)&Connection.Worker.UploadRate,
                 Rate);
+
+            if (Connection.FlowIndex != UINT32_MAX) {
+                auto& Flow = Client.FlowResults[Connection.FlowIndex];
+                QUIC_STATISTICS_V2 Stats;
+                uint32_t StatsSize = sizeof(Stats);
+                if (QUIC_SUCCEEDED(
+                    MsQuic->GetParam(
+                        Connection.Handle,
+                        QUIC_PARAM_CONN_STATISTICS_V2,
+                        &StatsSize,
+                        &Stats))) {
+                    Flow.Rtt = Stats.Rtt;
+                    Flow.MinRtt = Stats.MinRtt;
+                    Flow.MaxRtt = Stats.MaxRtt;
+                }
+                Flow.RateKbps = Rate;
+                Flow.Completed = true;
+            }
         }
     }
 
@@ -1024,12 +1612,22 @@ PerfClientStream::OnShutdown() {
 
     if (SendSuccess && RecvSuccess) {
         if (Client.Running) {
+#ifndef _KERNEL_MODE
+            if (Connection.Worker.Latency) {
+                const auto Latency = CxPlatTimeDiff64(StartTime, RecvEndTime);
+                Connection.Worker.Lock.Acquire();
+                hdr_record_value(Connection.Worker.Latency, (int64_t)CXPLAT_MIN(Latency, UINT32_MAX));
+                Connection.Worker.Lock.Release();
+                InterlockedIncrement64((int64_t*)&Connection.Client.LatencyCount);
+            }
+#else
             const auto Index = (uint64_t)InterlockedIncrement64((int64_t*)&Connection.Client.CurLatencyIndex) - 1;
             if (Index < Client.MaxLatencyIndex) {
                 const auto Latency = CxPlatTimeDiff64(StartTime, RecvEndTime);
                 Client.LatencyValues[(size_t)Index] = Latency > UINT32_MAX ? UINT32_MAX : (uint32_t)Latency;
                 InterlockedIncrement64((int64_t*)&Connection.Client.LatencyCount);
             }
+#endif
         }
         InterlockedIncrement64((int64_t*)&Connection.Worker.StreamsCompleted);
     }
@@ -13,6 +13,74 @@ Abstract:
 
 #include "SecNetPerf.h"
 #include "Tcp.h"
+#ifndef _KERNEL_MODE
+#include "histogram/hdr_histogram.h"
+#endif
+
+//
+// A single connection's state over one time series interval.
+//
+struct PerfTimeSample {
+    uint64_t TimeUs;            // Since the start of the run
+    uint32_t ConnectionId;      // Unique per worker
+    uint32_t Rtt;
+    uint32_t MinRtt;
+    uint32_t CongestionWindow;
+    uint64_t SendBytes;         // In the interval
+    uint64_t RecvBytes;         // In the interval
+    uint64_t LostPackets;       // In the interval
+    uint32_t CongestionEvents;  // In the interval
+    uint16_t PathMtu;
+};
+
+//
+// Append-only list of samples. Only written by the owning worker's thread and
+// only read after that thread has exited, so it needs no synchronization.
+//
+struct PerfTimeSeries {
+    static const uint32_t BlockSize = 1024;
+    struct Block {
+        Block* Next {nullptr};
+        uint32_t Count {0};
+        PerfTimeSample Samples[BlockSize];
+    };
+    Block* Head {nullptr};
+    Block* Tail {nullptr};
+    ~PerfTimeSeries() {
+        while (Head) {
+            Block* Next = Head->Next;
+            delete Head;
+            Head = Next;
+        }
+    }
+    PerfTimeSample* Append() {
+        if (!Tail || Tail->Count == BlockSize) {
+            Block* New = new(std::nothrow) Block;
+            if (!New) {
+                return nullptr;
+            }
+            if (Tail) {
+                Tail->Next = New;
+            } else {
+                Head = New;
+            }
+            Tail = New;
+        }
+        return &Tail->Samples[Tail->Count++];
+    }
+};
+
+//
+// The outcome of a single flow in a multi-flow (fairness) run.
+//
+struct PerfFlowResult {
+    uint8_t Algorithm;          // QUIC_CONGESTION_CONTROL_ALGORITHM
+    bool Completed;
+    uint32_t RateKbps;
+    uint32_t Rtt;
+    uint32_t MinRtt;
+    uint32_t MaxRtt;
+};
 
 struct PerfClientConnection {
     struct PerfClient& Client;
@@ -25,6 +93,20 @@ struct PerfClientConnection {
     uint64_t StreamsCreated {0};
     uint64_t StreamsActive {0};
     bool WorkerConnComplete {false}; // Indicated completion to worker
+    uint32_t FlowIndex {UINT32_MAX}; // Only set for multi-flow runs
+    // Time series state (protected by the worker's lock)
+    struct TimeSeriesEntry {
+        CXPLAT_LIST_ENTRY Link {nullptr, nullptr}; // Must be first
+        PerfClientConnection* Connection;
+    } TimeSeriesLink {{nullptr, nullptr}, this};
+    uint32_t TimeSeriesId {0};
+    bool Sampling {false};
+    bool PendingFree {false};
+    // Time series state (only used by the worker thread)
+    uint64_t LastSendBytes {0};
+    uint64_t LastRecvBytes {0};
+    uint64_t LastLostPackets {0};
+    uint32_t LastCongestionEvents {0};
     PerfClientConnection(_In_ PerfClient& Client, _In_ PerfClientWorker& Worker) : Client(Client), Worker(Worker) { }
     ~PerfClientConnection();
     void Initialize();
@@ -33,6 +115,7 @@ struct PerfClientConnection {
     void OnShutdownComplete();
     void OnStreamShutdown();
     void Shutdown();
+    void Sample(_In_ uint64_t TimeUs);
     QUIC_STATUS ConnectionCallback(_Inout_ QUIC_CONNECTION_EVENT* Event);
     static QUIC_STATUS QUIC_API s_ConnectionCallback(HQUIC, void* Context, _Inout_ QUIC_CONNECTION_EVENT* Event) {
         return ((PerfClientConnection*)Context)->ConnectionCallback(Event);
@@ -100,18 +183,33 @@ struct QUIC_CACHEALIGN PerfClientWorker {
     UniquePtr<char[]> Target;
     QuicAddr LocalAddr;
     QuicAddr RemoteAddr;
+    CXPLAT_LIST_ENTRY TimeSeriesConnections; // Protected by Lock
+    uint32_t TimeSeriesConnectionCount {0};
+    UniquePtr<PerfClientConnection*[]> SampleConnections;
+    uint32_t SampleConnectionsCapacity {0};
+    PerfTimeSeries TimeSeries;
+#ifndef _KERNEL_MODE
+    struct hdr_histogram* Latency {nullptr}; // Protected by Lock; drained by the client
+#endif
     CxPlatPoolT<PerfClientConnection> ConnectionPool;
     CxPlatPoolT<PerfClientStream> StreamPool;
     CxPlatPoolT<TcpConnection> TcpConnectionPool;
     CxPlatPoolT<TcpSendData> TcpSendDataPool;
-    PerfClientWorker() { }
-    ~PerfClientWorker() { WaitForThread(); }
+    PerfClientWorker() { CxPlatListInitializeHead(&TimeSeriesConnections); }
+    ~PerfClientWorker() {
+        WaitForThread();
+#ifndef _KERNEL_MODE
+        if (Latency) { hdr_close(Latency); }
+#endif
+    }
     void Uninitialize() { WaitForThread(); }
     void QueueNewConnection() {
         InterlockedIncrement64((int64_t*)&ConnectionsQueued);
         WakeEvent.Set();
     }
     void OnConnectionComplete();
+    void AddTimeSeriesConnection(_In_ PerfClientConnection* Connection);
+    void FreeConnection(_In_ PerfClientConnection* Connection);
     static CXPLAT_THREAD_CALLBACK(s_WorkerThread, Context) {
         ((PerfClientWorker*)Context)->WorkerThread();
         CXPLAT_THREAD_RETURN(QUIC_STATUS_SUCCESS);
@@ -126,6 +224,7 @@ private:
         }
     }
     void StartNewConnection();
+    void SampleTimeSeries(_In_ uint64_t Now);
     void WorkerThread();
 };
 
@@ -135,7 +234,13 @@ struct PerfClient {
             Workers[i].Client = this;
         }
     }
-    ~PerfClient() { Running = false; }
+    ~PerfClient() {
+        Running = false;
+#ifndef _KERNEL_MODE
+        if (Latency) { hdr_close(Latency); }
+        if (IntervalLatency) { hdr_close(IntervalLatency); }
+#endif
+    }
     QUIC_STATUS Init(
         _In_ int argc,
         _In_reads_(argc) _Null_terminated_ char* argv[],
@@ -144,13 +249,33 @@ struct PerfClient {
     QUIC_STATUS Wait(_In_ int Timeout);
     uint32_t GetExtraDataLength();
     void GetExtraData(_Out_writes_bytes_(Length) uint8_t* Data, _In_ uint32_t Length);
+    void WriteTimeSeries();
+    QUIC_STATUS ParseCcMix(_In_z_ const char* CcMix);
+    void PrintFairness();
+    bool GetProfileCounters(
+        _Out_writes_(QUIC_PROFILE_STAGE_MAX) QUIC_PROFILE_COUNTER* Counters,
+        _Out_writes_(2) int64_t* Datagrams);
+    void PrintProfile();
+#ifndef _KERNEL_MODE
+    void CollectLatency(_In_ bool PrintInterval);
+    const struct hdr_histogram* GetLatencyHistogram(_Out_ uint64_t* CompletedRequests) const {
+        *CompletedRequests = LatencyCount;
+        return Latency;
+    }
+#endif
 
     bool Running {true};
     CXPLAT_EVENT* CompletionEvent {nullptr};
     uint64_t MaxLatencyIndex {0};
     uint64_t CurLatencyIndex {0};
     uint64_t LatencyCount {0};
-    UniquePtr<uint32_t[]> LatencyValues {nullptr}; // TODO - Move to Worker
+    UniquePtr<uint32_t[]> LatencyValues {nullptr}; // Kernel mode only
+#ifndef _KERNEL_MODE
+    struct hdr_histogram* Latency {nullptr}; // Merged from the workers
+    struct hdr_histogram* IntervalLatency {nullptr};
+    uint64_t LatencyInterval {0};
+    uint64_t LastLatencyCollectTime {0};
+#endif
     PerfClientWorker Workers[PERF_MAX_THREAD_COUNT];
 
     UniquePtr<TcpEngine> Engine;
@@ -162,17 +287,25 @@ struct PerfClient {
         "perf-client",
         PerfDefaultExecutionProfile,
         true};
-    MsQuicConfiguration Configuration {
-        Registration,
-        MsQuicAlpn(PERF_ALPN),
-        MsQuicSettings()
+    static MsQuicSettings DefaultSettings() {
+        return MsQuicSettings()
             .SetDisconnectTimeoutMs(PERF_DEFAULT_DISCONNECT_TIMEOUT)
             .SetIdleTimeoutMs(PERF_DEFAULT_IDLE_TIMEOUT)
             .SetSendBufferingEnabled(false)
             .SetCongestionControlAlgorithm(PerfDefaultCongestionControl)
             .SetEcnEnabled(PerfDefaultEcnEnabled)
-            .SetEncryptionOffloadAllowed(PerfDefaultQeoAllowed),
+            .SetEncryptionOffloadAllowed(PerfDefaultQeoAllowed);
+    }
+    MsQuicConfiguration Configuration {
+        Registration,
+        MsQuicAlpn(PERF_ALPN),
+        DefaultSettings(),
         CredentialConfig};
+    // Multi-flow (fairness) parameters
+    UniquePtr<MsQuicConfiguration> CcConfigurations[QUIC_CONGESTION_CONTROL_ALGORITHM_MAX];
+    UniquePtr<PerfFlowResult[]> FlowResults; // One per connection
+    uint32_t FlowCount {0};
+    uint64_t NextFlowIndex {0};
     // Target parameters
     UniquePtr<char[]> Target;
     QUIC_ADDRESS_FAMILY TargetFamily {QUIC_ADDRESS_FAMILY_UNSPEC};
@@ -198,6 +331,12 @@ struct PerfClient {
     uint8_t PrintConnections {FALSE};
     uint8_t PrintStreams {FALSE};
     uint8_t PrintLatency {FALSE};
+    uint8_t PrintProfileCounters {FALSE};
+    QUIC_PROFILE_COUNTER ProfileStart[QUIC_PROFILE_STAGE_MAX] {};
+    int64_t ProfileDatagramsStart[2] {}; // UDP recv, UDP send
+    uint64_t TimeSeriesInterval {0};
+    const char* TimeSeriesFile {nullptr};
+    uint64_t StartTime {0};
     // Scenario parameters
     uint32_t ConnectionCount {1};
     uint32_t StreamCount {0};
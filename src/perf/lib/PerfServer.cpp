@@ -31,6 +31,19 @@ PerfServer::Init(
 
     TryGetValue(argc, argv, "stats", &PrintStats);
 
+    uint8_t UseContent = FALSE;
+    if (TryGetValue(argc, argv, "content", &UseContent) && UseContent) {
+        //
+        // Serve every response from one shared content object, instead of
+        // each stream's sends being copied into its connection's send buffer.
+        //
+        QUIC_STATUS Status;
+        if (QUIC_FAILED(Status = MsQuic->ContentOpen(ResponseBuffer, nullptr, nullptr, &ResponseContent))) {
+            WriteOutput("Failed to open response content 0x%x\n", Status);
+            return Status;
+        }
+    }
+
     const char* LocalAddress = nullptr;
     uint16_t Port = 0;
     if (TryGetValue(argc, argv, "bind", &LocalAddress)) {
@@ -414,7 +427,11 @@ PerfServer::SendResponse(
             SendData->Fin = (Flags & QUIC_SEND_FLAG_FIN) ? TRUE : FALSE;
             ((TcpConnection*)Handle)->Send(SendData);
         } else {
-            MsQuic->StreamSend((HQUIC)Handle, Buffer, 1, Flags, Buffer);
+            if (ResponseContent) {
+                MsQuic->StreamSendContent((HQUIC)Handle, ResponseContent, 0, IoSize, Flags, Buffer);
+            } else {
+                MsQuic->StreamSend((HQUIC)Handle, Buffer, 1, Flags, Buffer);
+            }
         }
     }
 }
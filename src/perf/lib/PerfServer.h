@@ -82,6 +82,11 @@ public:
             CxPlatSocketDelete(TeardownBinding);
             TeardownBinding = nullptr;
         }
+
+        if (ResponseContent) {
+            MsQuic->ContentClose(ResponseContent);
+            ResponseContent = nullptr;
+        }
     }
 
     QUIC_STATUS
@@ -188,6 +193,7 @@ private:
     QUIC_ADDR LocalAddr;
     CXPLAT_EVENT* StopEvent {nullptr};
     uint8_t PrintStats {FALSE};
+    HQUIC ResponseContent {nullptr}; // Shared content over ResponseBuffer, if enabled.
 
     TcpEngine Engine;
     TcpConfiguration TcpConfig;
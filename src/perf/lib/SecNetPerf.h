@@ -41,6 +41,7 @@ Abstract:
 
 #define PERF_MAX_THREAD_COUNT               128
 #define PERF_MAX_REQUESTS_PER_SECOND        2000000 // best guess - must increase if we can do better
+#define PERF_MAX_FLOW_COUNT                 64
 
 typedef enum TCP_EXECUTION_PROFILE {
     TCP_EXECUTION_PROFILE_LOW_LATENCY,
@@ -89,6 +90,18 @@ QuicMainGetExtraData(
     _In_ uint32_t Length
     );
 
+#ifndef _KERNEL_MODE
+//
+// Returns the merged request latency histogram, if latency was tracked.
+//
+extern
+const struct hdr_histogram*
+QuicMainGetLatencyHistogram(
+    _Out_ uint64_t* RunTime,
+    _Out_ uint64_t* CompletedRequests
+    );
+#endif
+
 QUIC_INLINE
 const char*
 TryGetTarget(
@@ -180,7 +193,9 @@ QuicPrintConnectionStatistics(
         "  RecvReorderedPackets      %llu\n"
         "  RecvDroppedPackets        %llu\n"
         "  RecvDuplicatePackets      %llu\n"
-        "  RecvDecryptionFailures    %llu\n",
+        "  RecvDecryptionFailures    %llu\n"
+        "  SendFlowControlBlocked    %llu us\n"
+        "  RecvFlowControlWindow     %llu\n",
         Stats.Rtt,
         Stats.MinRtt,
         Stats.EcnCapable,
@@ -193,7 +208,9 @@ QuicPrintConnectionStatistics(
         (unsigned long long)Stats.RecvReorderedPackets,
         (unsigned long long)Stats.RecvDroppedPackets,
         (unsigned long long)Stats.RecvDuplicatePackets,
-        (unsigned long long)Stats.RecvDecryptionFailures);
+        (unsigned long long)Stats.RecvDecryptionFailures,
+        (unsigned long long)Stats.SendConnFlowControlBlockedTimeUs,
+        (unsigned long long)Stats.RecvConnFlowControlWindow);
     QUIC_HANDSHAKE_INFO HandshakeInfo = {};
     uint32_t HandshakeInfoSize = sizeof(HandshakeInfo);
     ApiTable->GetParam(Connection, QUIC_PARAM_TLS_HANDSHAKE_INFO, &HandshakeInfoSize, &HandshakeInfo);
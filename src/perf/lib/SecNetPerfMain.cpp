@@ -80,6 +80,7 @@ PrintHelp(
         "  -port:<####>             The UDP port of the server. Ignored if \"bind\" is passed. (def:%u)\n"
         "  -serverid:<####>         The ID of the server (used for load balancing).\n"
         "  -cibir:<hex_bytes>       A CIBIR well-known idenfitier.\n"
+        "  -content:<0/1>           Sends all responses from one shared, uncopied content object. (def:0)\n"
         "  -delay:<####>[unit]      Delay, with an optional unit (def unit is us), to be introduced before the server responds to a request.\n"
         "  -delayType:<fixed/variable>    Optional delay type can be specified in conjunction with the 'delay' argument.\n"
         "                                 'fixed' - introduce the specified delay for each request (default).\n"
@@ -111,10 +112,15 @@ PrintHelp(
         "  -pconn:<0/1>             Print connection statistics. (def:0)\n"
         "  -pstream:<0/1>           Print stream statistics. (def:0)\n"
         "  -platency<0/1>           Print latency statistics. (def:0)\n"
+        "  -latinterval:<####>[unit] Also prints latency statistics at this interval (def unit is us). (def:0)\n"
+        "  -pprofile:<0/1>          Print hot path cycle counters (needs a QUIC_ENABLE_PROFILING build). (def:0)\n"
+        "  -timeseries:<####>[unit] Samples each connection's RTT, cwnd, throughput and loss at this interval\n"
+        "                            (def unit is us) and prints them as CSV at the end. (def:0)\n"
+        "  -tsfile:<path>           Writes the time series CSV to a file instead.\n"
         "\n"
         "  Scenario options:\n"
         "  -scenario:<profile>      Scenario profile to use.\n"
-        "                            - {upload, download, hps, rps, rps-multi, latency}.\n"
+        "                            - {upload, download, hps, rps, rps-multi, latency, fairness}.\n"
         "  -conns:<####>            The number of connections to use. (def:1)\n"
         "  -streams:<####>          The number of streams to send on at a time. (def:0)\n"
         "  -upload:<####>[unit]     The length of bytes to send on each stream, with an optional (time or length) unit. (def:0)\n"
@@ -124,6 +130,8 @@ PrintHelp(
         "  -rconn:<0/1>             Repeat the scenario at the connection level. (def:0)\n"
         "  -rstream:<0/1>           Repeat the scenario at the stream level. (def:0)\n"
         "  -runtime:<####>[unit]    The total runtime, with an optional unit (def unit is us). Only relevant for repeat scenarios. (def:0)\n"
+        "  -ccmix:<algo>[:<n>],...  Uploads on one connection per flow, each with the given congestion control\n"
+        "                            algorithm, and prints per-flow and aggregate fairness. (def for fairness:cubic:2,bbrresync:2,cubicprobe:1)\n"
         "\n"
         "Both (client & server) options:\n"
         "  -exec:<profile>          Execution profile to use.\n"
@@ -131,6 +139,7 @@ PrintHelp(
         "  -cc:<algo>               Congestion control algorithm to use.\n"
         "                            - {cubic, bbr}.\n"
         "  -pollidle:<time_us>      Amount of time to poll while idle before sleeping (default: 0).\n"
+        "  -adaptivepoll:<0/1>      Adapts the idle poll time, up to -pollidle, to the observed load. (def:0)\n"
         "  -ecn:<0/1>               Enables/disables sender-side ECN support. (def:0)\n"
         "  -qeo:<0/1>               Allows/disallowes QUIC encryption offload. (def:0)\n"
 #ifndef _KERNEL_MODE
@@ -144,6 +153,15 @@ PrintHelp(
         "  -cipher:<value>          Decimal value of 1 or more QUIC_ALLOWED_CIPHER_SUITE_FLAGS.\n"
         "  -highpri:<0/1>           Configures MsQuic to run threads at high priority. (def:0)\n"
         "  -dscp:<0-63>             Specify DSCP value to mark sent packets with. (def:0)\n"
+        "  -netrate:<kbps>          Emulates a bottleneck link of the given rate on send. (def:0, unlimited)\n"
+        "  -netbuffer:<bytes>       Size of the emulated bottleneck buffer; tail drops when full. (def:0, unlimited)\n"
+        "  -netdelay:<time_us>      Emulated one-way propagation delay on send. (def:0)\n"
+        "  -netloss:<ppm>[,<r>,<good_ppm>,<bad_ppm>]\n"
+        "                           Emulated random loss rate, or Gilbert-Elliott loss where <ppm> and <r>\n"
+        "                            are the good->bad and bad->good transition probabilities.\n"
+        "  -netsched:<ms>:<kbps>[,<ms>:<kbps>...]\n"
+        "                           Repeating schedule of emulated link rates, overriding -netrate.\n"
+        "                            A zero rate emulates an outage. At most 16 entries.\n"
         "\n",
         PERF_DEFAULT_PORT,
         PERF_DEFAULT_PORT
@@ -228,6 +246,12 @@ QuicMainStart(
         SetConfig = true;
     }
 
+    uint8_t AdaptivePolling = 0;
+    if (TryGetValue(argc, argv, "adaptivepoll", &AdaptivePolling) && AdaptivePolling) {
+        Config->Flags |= QUIC_GLOBAL_EXECUTION_CONFIG_FLAG_ADAPTIVE_POLLING;
+        SetConfig = true;
+    }
+
     if (SetConfig &&
         QUIC_FAILED(
         Status =
@@ -240,11 +264,79 @@ QuicMainStart(
         return Status;
     }
 
+    QUIC_NETWORK_EMULATION_CONFIG NetEmuConfig = {0};
+    bool SetNetEmu = false;
+    if (TryGetValue(argc, argv, "netrate", &NetEmuConfig.RateKbps)) {
+        SetNetEmu = true;
+    }
+    if (TryGetValue(argc, argv, "netbuffer", &NetEmuConfig.BufferBytes)) {
+        SetNetEmu = true;
+    }
+    if (TryGetValue(argc, argv, "netdelay", &NetEmuConfig.DelayUs)) {
+        SetNetEmu = true;
+    }
+    const char* NetLossStr;
+    if ((NetLossStr = GetValue(argc, argv, "netloss")) != nullptr) {
+        SetNetEmu = true;
+        uint32_t Values[4] = {0};
+        uint32_t ValueCount = 0;
+        do {
+            if (*NetLossStr == ',') NetLossStr++;
+            Values[ValueCount++] = (uint32_t)_strtoul(NetLossStr, (char**)&NetLossStr, 10);
+        } while (*NetLossStr && ValueCount < ARRAYSIZE(Values));
+        if (ValueCount == 1) {
+            NetEmuConfig.GoodLossProbability = Values[0];
+        } else if (ValueCount == 4) {
+            NetEmuConfig.GoodToBadProbability = Values[0];
+            NetEmuConfig.BadToGoodProbability = Values[1];
+            NetEmuConfig.GoodLossProbability = Values[2];
+            NetEmuConfig.BadLossProbability = Values[3];
+        } else {
+            WriteOutput("Failed to parse netloss[%s]!\n", GetValue(argc, argv, "netloss"));
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+    }
+    const char* NetSchedStr;
+    if ((NetSchedStr = GetValue(argc, argv, "netsched")) != nullptr) {
+        SetNetEmu = true;
+        do {
+            if (*NetSchedStr == ',') NetSchedStr++;
+            if (NetEmuConfig.RateScheduleCount == QUIC_NETWORK_EMULATION_MAX_RATE_SCHEDULE) {
+                WriteOutput(
+                    "netsched supports at most %u entries!\n",
+                    (uint32_t)QUIC_NETWORK_EMULATION_MAX_RATE_SCHEDULE);
+                return QUIC_STATUS_INVALID_PARAMETER;
+            }
+            QUIC_NETWORK_EMULATION_RATE* Rate =
+                &NetEmuConfig.RateSchedule[NetEmuConfig.RateScheduleCount++];
+            Rate->DurationMs = (uint32_t)_strtoul(NetSchedStr, (char**)&NetSchedStr, 10);
+            if (*NetSchedStr != ':') {
+                WriteOutput("Failed to parse netsched[%s]!\n", GetValue(argc, argv, "netsched"));
+                return QUIC_STATUS_INVALID_PARAMETER;
+            }
+            NetSchedStr++;
+            Rate->RateKbps = (uint32_t)_strtoul(NetSchedStr, (char**)&NetSchedStr, 10);
+        } while (*NetSchedStr);
+    }
+
+    if (SetNetEmu &&
+        QUIC_FAILED(
+        Status =
+        MsQuic->SetParam(
+            nullptr,
+            QUIC_PARAM_GLOBAL_NETWORK_EMULATION,
+            sizeof(NetEmuConfig),
+            &NetEmuConfig))) {
+        WriteOutput("Failed to set network emulation %d\n", Status);
+        return Status;
+    }
+
     const char* ScenarioStr = GetValue(argc, argv, "scenario");
     if (ScenarioStr != nullptr) {
         if (IsValue(ScenarioStr, "upload") ||
             IsValue(ScenarioStr, "download") ||
-            IsValue(ScenarioStr, "hps")) {
+            IsValue(ScenarioStr, "hps") ||
+            IsValue(ScenarioStr, "fairness")) {
             PerfDefaultExecutionProfile = QUIC_EXECUTION_PROFILE_TYPE_MAX_THROUGHPUT;
             TcpDefaultExecutionProfile = TCP_EXECUTION_PROFILE_MAX_THROUGHPUT;
         } else if (
@@ -381,6 +473,23 @@ QuicMainGetExtraData(
     Client->GetExtraData(Data, Length);
 }
 
+#ifndef _KERNEL_MODE
+const struct hdr_histogram*
+QuicMainGetLatencyHistogram(
+    _Out_ uint64_t* RunTime,
+    _Out_ uint64_t* CompletedRequests
+    )
+{
+    *RunTime = 0;
+    *CompletedRequests = 0;
+    if (!Client) {
+        return nullptr;
+    }
+    *RunTime = Client->RunTime;
+    return Client->GetLatencyHistogram(CompletedRequests);
+}
+#endif
+
 const char* TimeUnits[] = { "m", "ms", "us", "s" };
 const uint64_t TimeMult[] = { 60 * 1000 * 1000, 1000, 1, 1000 * 1000 };
 const char* SizeUnits[] = { "gb", "mb", "kb", "b" };
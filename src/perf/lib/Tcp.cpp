@@ -294,7 +294,7 @@ CXPLAT_THREAD_CALLBACK(TcpWorker::WorkerThread, Context)
 {
     TcpWorker* This = (TcpWorker*)Context;
     CXPLAT_EXECUTION_STATE DummyState = {
-        0, 0, 0, UINT32_MAX, 0, CxPlatCurThreadID()
+        0, 0, 0, UINT32_MAX, 0, CxPlatCurThreadID(), UINT32_MAX
     };
     while (DoWork(This, &DummyState)) {
         if (!InterlockedFetchAndClearBoolean(&This->ExecutionContext.Ready)) {
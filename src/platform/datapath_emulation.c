@@ -0,0 +1,543 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    QUIC Datapath Network Emulation
+
+    Emulates a constrained network link (bottleneck rate and buffer,
+    propagation delay, Gilbert-Elliott loss and a repeating schedule of link
+    rates) on outgoing UDP socket traffic, so that congestion control behavior
+    can be evaluated reproducibly, without kernel level traffic shaping.
+
+    Emulation is applied on send only, like netem. Both ends must enable it to
+    emulate a link in both directions. Queued packets are released by an
+    execution context on the first platform worker, so timing precision is
+    bounded by the worker's timer resolution unless idle polling is enabled.
+
+--*/
+
+#include "platform_internal.h"
+
+typedef struct CXPLAT_EMULATED_SEND {
+
+    CXPLAT_LIST_ENTRY Link;
+
+    //
+    // Link in the bottleneck buffer, while Buffered is set.
+    //
+    CXPLAT_LIST_ENTRY BufferLink;
+
+    //
+    // The time the packet finishes being serialized onto the bottleneck link
+    // and the time it is delivered to the real socket.
+    //
+    uint64_t TxEndTime;
+    uint64_t ReleaseTime;
+
+    uint32_t Length;
+
+    BOOLEAN Buffered;
+
+    CXPLAT_SOCKET* Socket;
+    CXPLAT_SEND_DATA* SendData;
+    CXPLAT_ROUTE Route;
+
+} CXPLAT_EMULATED_SEND;
+
+typedef struct CXPLAT_NETWORK_EMULATION {
+
+    CXPLAT_EXECUTION_CONTEXT Ec;
+
+    //
+    // Set once the execution context has been cleaned up.
+    //
+    CXPLAT_EVENT Done;
+
+    //
+    // Set whenever no packet is being handed to a socket.
+    //
+    CXPLAT_EVENT SendIdle;
+
+    //
+    // Protects all the state below.
+    //
+    CXPLAT_LOCK Lock;
+
+    CXPLAT_POOL SendPool;
+
+    //
+    // Queued packets, in release order.
+    //
+    CXPLAT_LIST_ENTRY Queue;
+
+    //
+    // Queued packets that are still in the bottleneck buffer (i.e. have not
+    // been fully serialized yet), in serialization order, and their total
+    // length.
+    //
+    CXPLAT_LIST_ENTRY Buffer;
+    uint32_t BufferedBytes;
+
+    //
+    // The socket a released packet is currently being sent on, outside the
+    // lock, and the thread doing it.
+    //
+    CXPLAT_SOCKET* SendingSocket;
+    CXPLAT_THREAD_ID SendingThread;
+
+    QUIC_NETWORK_EMULATION_CONFIG Config;
+    uint64_t ScheduleStartTime;
+    uint64_t ScheduleLengthUs;
+
+    //
+    // The time the bottleneck link finishes serializing all queued packets.
+    //
+    uint64_t LinkFreeTime;
+
+    uint64_t RandomState;
+
+    BOOLEAN Enabled;
+    BOOLEAN LossBadState;
+    BOOLEAN Shutdown;
+
+} CXPLAT_NETWORK_EMULATION;
+
+static
+uint32_t
+CxPlatNetworkEmulationRandom(
+    _Inout_ CXPLAT_NETWORK_EMULATION* Emulation
+    )
+{
+    //
+    // xorshift64*, scaled to parts per million.
+    //
+    uint64_t x = Emulation->RandomState;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    Emulation->RandomState = x;
+    return (uint32_t)((x * 0x2545F4914F6CDD1DULL) >> 32) % 1000000;
+}
+
+//
+// Runs the Gilbert-Elliott model for one packet. Returns TRUE if the packet is
+// lost.
+//
+static
+BOOLEAN
+CxPlatNetworkEmulationIsLost(
+    _Inout_ CXPLAT_NETWORK_EMULATION* Emulation
+    )
+{
+    const QUIC_NETWORK_EMULATION_CONFIG* Config = &Emulation->Config;
+    if (Emulation->LossBadState) {
+        if (CxPlatNetworkEmulationRandom(Emulation) < Config->BadToGoodProbability) {
+            Emulation->LossBadState = FALSE;
+        }
+    } else {
+        if (CxPlatNetworkEmulationRandom(Emulation) < Config->GoodToBadProbability) {
+            Emulation->LossBadState = TRUE;
+        }
+    }
+    const uint32_t LossProbability =
+        Emulation->LossBadState ?
+            Config->BadLossProbability : Config->GoodLossProbability;
+    return
+        LossProbability != 0 &&
+        CxPlatNetworkEmulationRandom(Emulation) < LossProbability;
+}
+
+//
+// Returns the link rate at the given time and the time that rate ends.
+//
+static
+uint32_t
+CxPlatNetworkEmulationGetRate(
+    _In_ const CXPLAT_NETWORK_EMULATION* Emulation,
+    _In_ uint64_t Time,
+    _Out_ uint64_t* RateEndTime
+    )
+{
+    const QUIC_NETWORK_EMULATION_CONFIG* Config = &Emulation->Config;
+    if (Config->RateScheduleCount == 0) {
+        *RateEndTime = UINT64_MAX;
+        return Config->RateKbps;
+    }
+
+    const uint64_t Offset =
+        CxPlatTimeDiff64(Emulation->ScheduleStartTime, Time) % Emulation->ScheduleLengthUs;
+    uint64_t EntryEnd = 0;
+    for (uint32_t i = 0; i < Config->RateScheduleCount; ++i) {
+        EntryEnd += MS_TO_US((uint64_t)Config->RateSchedule[i].DurationMs);
+        if (Offset < EntryEnd) {
+            *RateEndTime = Time + (EntryEnd - Offset);
+            return Config->RateSchedule[i].RateKbps;
+        }
+    }
+
+    CXPLAT_FRE_ASSERT(FALSE); // Offset is always within the schedule length.
+    *RateEndTime = UINT64_MAX;
+    return 0;
+}
+
+//
+// Takes a packet out of the bottleneck buffer, if it is still in it. This is
+// the only place the buffer accounting is reduced.
+//
+static
+void
+CxPlatNetworkEmulationUnbuffer(
+    _Inout_ CXPLAT_NETWORK_EMULATION* Emulation,
+    _In_ CXPLAT_EMULATED_SEND* Send
+    )
+{
+    if (Send->Buffered) {
+        CXPLAT_DBG_ASSERT(Emulation->BufferedBytes >= Send->Length);
+        CxPlatListEntryRemove(&Send->BufferLink);
+        Emulation->BufferedBytes -= Send->Length;
+        Send->Buffered = FALSE;
+    }
+}
+
+//
+// Takes packets out of the bottleneck buffer once they have been fully
+// serialized.
+//
+static
+void
+CxPlatNetworkEmulationDrainBuffer(
+    _Inout_ CXPLAT_NETWORK_EMULATION* Emulation,
+    _In_ uint64_t TimeNow
+    )
+{
+    while (!CxPlatListIsEmpty(&Emulation->Buffer)) {
+        CXPLAT_EMULATED_SEND* Send =
+            CXPLAT_CONTAINING_RECORD(Emulation->Buffer.Flink, CXPLAT_EMULATED_SEND, BufferLink);
+        if (Send->TxEndTime > TimeNow) {
+            break;
+        }
+        CxPlatNetworkEmulationUnbuffer(Emulation, Send);
+    }
+}
+
+//
+// Removes a packet from the queue (and the buffer) before it is sent or freed.
+//
+static
+void
+CxPlatNetworkEmulationRemove(
+    _Inout_ CXPLAT_NETWORK_EMULATION* Emulation,
+    _In_ CXPLAT_EMULATED_SEND* Send
+    )
+{
+    CxPlatNetworkEmulationUnbuffer(Emulation, Send);
+    CxPlatListEntryRemove(&Send->Link);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+BOOLEAN
+CxPlatNetworkEmulationRun(
+    _Inout_ void* Context,
+    _Inout_ CXPLAT_EXECUTION_STATE* State
+    )
+{
+    CXPLAT_NETWORK_EMULATION* Emulation = (CXPLAT_NETWORK_EMULATION*)Context;
+
+    CxPlatLockAcquire(&Emulation->Lock);
+
+    if (Emulation->Shutdown) {
+        while (!CxPlatListIsEmpty(&Emulation->Queue)) {
+            CXPLAT_EMULATED_SEND* Send =
+                CXPLAT_CONTAINING_RECORD(Emulation->Queue.Flink, CXPLAT_EMULATED_SEND, Link);
+            CxPlatNetworkEmulationRemove(Emulation, Send);
+            SendDataFree(Send->SendData);
+            CxPlatPoolFree(Send);
+        }
+        CXPLAT_DBG_ASSERT(Emulation->BufferedBytes == 0);
+        CxPlatLockRelease(&Emulation->Lock);
+        CxPlatEventSet(Emulation->Done);
+        return FALSE;
+    }
+
+    //
+    // Due packets are taken off the queue one at a time and sent without the
+    // lock held, so a send completion that re-enters the emulation layer
+    // can't deadlock. SendingSocket keeps CxPlatNetworkEmulationSocketDelete
+    // from returning while its socket is still in use here.
+    //
+    Emulation->Ec.NextTimeUs = UINT64_MAX;
+    while (!CxPlatListIsEmpty(&Emulation->Queue)) {
+        CXPLAT_EMULATED_SEND* Send =
+            CXPLAT_CONTAINING_RECORD(Emulation->Queue.Flink, CXPLAT_EMULATED_SEND, Link);
+        if (Send->ReleaseTime > State->TimeNow) {
+            Emulation->Ec.NextTimeUs = Send->ReleaseTime;
+            break;
+        }
+        CxPlatNetworkEmulationRemove(Emulation, Send);
+        Emulation->SendingSocket = Send->Socket;
+        Emulation->SendingThread = CxPlatCurThreadID();
+        CxPlatEventReset(Emulation->SendIdle);
+        CxPlatLockRelease(&Emulation->Lock);
+
+        SocketSend(Send->Socket, &Send->Route, Send->SendData);
+        CxPlatPoolFree(Send);
+
+        CxPlatLockAcquire(&Emulation->Lock);
+        Emulation->SendingSocket = NULL;
+        CxPlatEventSet(Emulation->SendIdle);
+    }
+
+    CxPlatLockRelease(&Emulation->Lock);
+
+    return TRUE;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatDataPathSetNetworkEmulation(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _In_opt_ const QUIC_NETWORK_EMULATION_CONFIG* Config
+    )
+{
+    if (Config != NULL) {
+        if (Config->RateScheduleCount > QUIC_NETWORK_EMULATION_MAX_RATE_SCHEDULE ||
+            Config->GoodToBadProbability > 1000000 ||
+            Config->BadToGoodProbability > 1000000 ||
+            Config->GoodLossProbability > 1000000 ||
+            Config->BadLossProbability > 1000000) {
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+        uint64_t ScheduleLengthUs = 0;
+        for (uint32_t i = 0; i < Config->RateScheduleCount; ++i) {
+            ScheduleLengthUs += MS_TO_US((uint64_t)Config->RateSchedule[i].DurationMs);
+        }
+        if (Config->RateScheduleCount != 0 && ScheduleLengthUs == 0) {
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+    }
+
+    CXPLAT_NETWORK_EMULATION* Emulation = Datapath->NetworkEmulation;
+    if (Emulation == NULL) {
+        if (Config == NULL) {
+            return QUIC_STATUS_SUCCESS;
+        }
+
+        Emulation =
+            CXPLAT_ALLOC_NONPAGED(sizeof(CXPLAT_NETWORK_EMULATION), QUIC_POOL_DATAPATH);
+        if (Emulation == NULL) {
+            return QUIC_STATUS_OUT_OF_MEMORY;
+        }
+        CxPlatZeroMemory(Emulation, sizeof(*Emulation));
+        CxPlatEventInitialize(&Emulation->Done, TRUE, FALSE);
+        CxPlatEventInitialize(&Emulation->SendIdle, TRUE, TRUE);
+        CxPlatLockInitialize(&Emulation->Lock);
+        CxPlatPoolInitialize(
+            FALSE, sizeof(CXPLAT_EMULATED_SEND), QUIC_POOL_DATAPATH, &Emulation->SendPool);
+        CxPlatListInitializeHead(&Emulation->Queue);
+        CxPlatListInitializeHead(&Emulation->Buffer);
+        CxPlatRandom(sizeof(Emulation->RandomState), &Emulation->RandomState);
+        Emulation->RandomState |= 1; // Must be non-zero.
+
+        Emulation->Ec.Context = Emulation;
+        Emulation->Ec.Callback = CxPlatNetworkEmulationRun;
+        Emulation->Ec.NextTimeUs = UINT64_MAX;
+        CxPlatWorkerPoolAddExecutionContext(Datapath->WorkerPool, &Emulation->Ec, 0);
+
+        CxPlatDataPathPublishNetworkEmulation(Datapath, Emulation);
+    }
+
+    CxPlatLockAcquire(&Emulation->Lock);
+    if (Config != NULL) {
+        Emulation->Config = *Config;
+        Emulation->ScheduleStartTime = CxPlatTimeUs64();
+        Emulation->ScheduleLengthUs = 0;
+        for (uint32_t i = 0; i < Config->RateScheduleCount; ++i) {
+            Emulation->ScheduleLengthUs += MS_TO_US((uint64_t)Config->RateSchedule[i].DurationMs);
+        }
+        Emulation->LossBadState = FALSE;
+        Emulation->Enabled = TRUE;
+    } else {
+        //
+        // Already queued packets still drain normally.
+        //
+        Emulation->Enabled = FALSE;
+    }
+    CxPlatLockRelease(&Emulation->Lock);
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatNetworkEmulationUninitialize(
+    _In_ CXPLAT_DATAPATH* Datapath
+    )
+{
+    CXPLAT_NETWORK_EMULATION* Emulation = Datapath->NetworkEmulation;
+    if (Emulation == NULL) {
+        return;
+    }
+
+    CxPlatLockAcquire(&Emulation->Lock);
+    Emulation->Shutdown = TRUE;
+    CxPlatLockRelease(&Emulation->Lock);
+    CxPlatWakeExecutionContext(&Emulation->Ec);
+    CxPlatEventWaitForever(Emulation->Done);
+
+    CxPlatDataPathPublishNetworkEmulation(Datapath, NULL);
+    CxPlatPoolUninitialize(&Emulation->SendPool);
+    CxPlatLockUninitialize(&Emulation->Lock);
+    CxPlatEventUninitialize(Emulation->SendIdle);
+    CxPlatEventUninitialize(Emulation->Done);
+    CXPLAT_FREE(Emulation, QUIC_POOL_DATAPATH);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CxPlatNetworkEmulationIsEnabled(
+    _In_ const CXPLAT_NETWORK_EMULATION* Emulation
+    )
+{
+    return Emulation->Enabled;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CxPlatNetworkEmulationSend(
+    _In_ CXPLAT_NETWORK_EMULATION* Emulation,
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ const CXPLAT_ROUTE* Route,
+    _In_ CXPLAT_SEND_DATA* SendData
+    )
+{
+    const uint32_t Length = ((CXPLAT_SEND_DATA_COMMON*)SendData)->TotalSize;
+    const uint64_t TimeNow = CxPlatTimeUs64();
+    BOOLEAN WakeEc = FALSE;
+
+    CxPlatLockAcquire(&Emulation->Lock);
+
+    if (!Emulation->Enabled && CxPlatListIsEmpty(&Emulation->Queue)) {
+        CxPlatLockRelease(&Emulation->Lock);
+        return FALSE; // Send directly.
+    }
+
+    if (Emulation->Enabled && CxPlatNetworkEmulationIsLost(Emulation)) {
+        goto Drop;
+    }
+
+    uint64_t TxEndTime = TimeNow;
+    uint64_t ReleaseTime = TimeNow;
+    if (Emulation->Enabled) {
+        CxPlatNetworkEmulationDrainBuffer(Emulation, TimeNow);
+
+        uint64_t RateEndTime;
+        uint64_t TxStartTime = CXPLAT_MAX(TimeNow, Emulation->LinkFreeTime);
+        uint32_t RateKbps = CxPlatNetworkEmulationGetRate(Emulation, TxStartTime, &RateEndTime);
+        for (uint32_t i = 0;
+             RateKbps == 0 && i < Emulation->Config.RateScheduleCount;
+             ++i) {
+            //
+            // The link is down. Start sending once it comes back up.
+            //
+            TxStartTime = RateEndTime;
+            RateKbps = CxPlatNetworkEmulationGetRate(Emulation, TxStartTime, &RateEndTime);
+        }
+
+        if (RateKbps != 0) {
+            if (Emulation->Config.BufferBytes != 0 &&
+                Emulation->BufferedBytes + Length > Emulation->Config.BufferBytes) {
+                goto Drop; // Tail drop.
+            }
+            TxEndTime = TxStartTime + CXPLAT_MAX(1, ((uint64_t)Length * 8000) / RateKbps);
+            Emulation->LinkFreeTime = TxEndTime;
+        } else if (Emulation->Config.RateScheduleCount != 0) {
+            goto Drop; // The link is never up.
+        }
+
+        ReleaseTime = TxEndTime + Emulation->Config.DelayUs;
+    }
+
+    CXPLAT_EMULATED_SEND* Send = CxPlatPoolAlloc(&Emulation->SendPool);
+    if (Send == NULL) {
+        goto Drop;
+    }
+    Send->TxEndTime = TxEndTime;
+    Send->ReleaseTime = ReleaseTime;
+    Send->Length = Length;
+    Send->Buffered = FALSE;
+    Send->Socket = Socket;
+    Send->SendData = SendData;
+    CxPlatCopyMemory(&Send->Route, Route, sizeof(*Route));
+
+    //
+    // Release times are almost always increasing, so search from the tail.
+    //
+    CXPLAT_LIST_ENTRY* Prev = Emulation->Queue.Blink;
+    while (Prev != &Emulation->Queue &&
+           CXPLAT_CONTAINING_RECORD(Prev, CXPLAT_EMULATED_SEND, Link)->ReleaseTime > ReleaseTime) {
+        Prev = Prev->Blink;
+    }
+    CxPlatListInsertHead(Prev, &Send->Link);
+    if (Emulation->Enabled && TxEndTime > TimeNow) {
+        //
+        // Serialization ends are increasing, so the buffer stays in order.
+        //
+        CxPlatListInsertTail(&Emulation->Buffer, &Send->BufferLink);
+        Emulation->BufferedBytes += Length;
+        Send->Buffered = TRUE;
+    }
+    if (Prev == &Emulation->Queue) {
+        WakeEc = TRUE; // New head of the queue.
+    }
+
+    CxPlatLockRelease(&Emulation->Lock);
+
+    if (WakeEc) {
+        CxPlatWakeExecutionContext(&Emulation->Ec);
+    }
+
+    return TRUE;
+
+Drop:
+
+    CxPlatLockRelease(&Emulation->Lock);
+    SendDataFree(SendData);
+    return TRUE;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatNetworkEmulationSocketDelete(
+    _In_ CXPLAT_NETWORK_EMULATION* Emulation,
+    _In_ CXPLAT_SOCKET* Socket
+    )
+{
+    CxPlatLockAcquire(&Emulation->Lock);
+    CXPLAT_LIST_ENTRY* Entry = Emulation->Queue.Flink;
+    while (Entry != &Emulation->Queue) {
+        CXPLAT_EMULATED_SEND* Send =
+            CXPLAT_CONTAINING_RECORD(Entry, CXPLAT_EMULATED_SEND, Link);
+        Entry = Entry->Flink;
+        if (Send->Socket == Socket) {
+            CxPlatNetworkEmulationRemove(Emulation, Send);
+            SendDataFree(Send->SendData);
+            CxPlatPoolFree(Send);
+        }
+    }
+
+    //
+    // Wait for a release in progress on the socket, unless this is being
+    // called from within that send.
+    //
+    while (Emulation->SendingSocket == Socket &&
+           Emulation->SendingThread != CxPlatCurThreadID()) {
+        CxPlatLockRelease(&Emulation->Lock);
+        CxPlatEventWaitForever(Emulation->SendIdle);
+        CxPlatLockAcquire(&Emulation->Lock);
+    }
+    CxPlatLockRelease(&Emulation->Lock);
+}
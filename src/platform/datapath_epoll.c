@@ -1136,7 +1136,12 @@ SocketCreateUdp(
         // round robin, but each flow will be sent to the same socket, just not
         // based on RSS.
         //
-        (void)CxPlatSocketConfigureRss(&Binding->SocketContexts[0], SocketCount);
+        (void)CxPlatSocketConfigureRss(
+            &Binding->SocketContexts[0],
+            SocketCount,
+            Config->PartitionIdOffset,
+            Config->PartitionIdMask,
+            Config->PartitionCount);
     }
 
     CxPlatConvertFromMappedV6(&Binding->LocalAddress, &Binding->LocalAddress);
@@ -1432,7 +1437,7 @@ SocketCreateTcpListener(
     // than the default round-robin strategy, but it's good to keep TCP behavior
     // consistent with UDP.
     //
-    (void)CxPlatSocketConfigureRss(&Binding->SocketContexts[0], SocketCount);
+    (void)CxPlatSocketConfigureRss(&Binding->SocketContexts[0], SocketCount, 0, 0, 0);
 
     for (uint32_t i = 0; i < SocketCount; i++) {
         CxPlatSocketContextSetEvents(&Binding->SocketContexts[i], EPOLL_CTL_ADD, EPOLLIN);
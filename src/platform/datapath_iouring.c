@@ -1302,7 +1302,12 @@ SocketCreateUdp(
         // round robin, but each flow will be sent to the same socket, just not
         // based on RSS.
         //
-        (void)CxPlatSocketConfigureRss(&Binding->SocketContexts[0], SocketCount);
+        (void)CxPlatSocketConfigureRss(
+            &Binding->SocketContexts[0],
+            SocketCount,
+            Config->PartitionIdOffset,
+            Config->PartitionIdMask,
+            Config->PartitionCount);
     }
 
     CxPlatConvertFromMappedV6(&Binding->LocalAddress, &Binding->LocalAddress);
@@ -194,22 +194,61 @@ Error:
 QUIC_STATUS
 CxPlatSocketConfigureRss(
     _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
-    _In_ uint32_t SocketCount
+    _In_ uint32_t SocketCount,
+    _In_ uint8_t PartitionIdOffset,
+    _In_ uint16_t PartitionIdMask,
+    _In_ uint16_t PartitionCount
     )
 {
 #ifdef SO_ATTACH_REUSEPORT_CBPF
     QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
     int Result = 0;
 
+    //
+    // The partition ID is written into the CID in host byte order.
+    //
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    const uint32_t PartitionIdLow = PartitionIdOffset + 1u;
+    const uint32_t PartitionIdHigh = PartitionIdOffset;
+#else
+    const uint32_t PartitionIdLow = PartitionIdOffset;
+    const uint32_t PartitionIdHigh = PartitionIdOffset + 1u;
+#endif
+
+    //
+    // The program runs on the UDP payload. Short header packets carry one of
+    // our CIDs, so they are steered to the socket whose index is the
+    // partition encoded in it. PartitionCount is the caller's (the core
+    // library's) partition count, which is what the partition ID indexes; it
+    // may differ from the datapath's. Everything else (long header or
+    // truncated packets) is spread by the receiving CPU.
+    //
     struct sock_filter BpfCode[] = {
+        {BPF_LD | BPF_W | BPF_LEN, 0, 0, 0}, // Load payload length
+        {BPF_JMP | BPF_JGE | BPF_K, 0, 10, PartitionIdOffset + 2u}, // Too short for a partition ID?
+        {BPF_LD | BPF_B | BPF_ABS, 0, 0, 0}, // Load first byte
+        {BPF_JMP | BPF_JSET | BPF_K, 8, 0, 0x80}, // Long header?
+        {BPF_LD | BPF_B | BPF_ABS, 0, 0, PartitionIdHigh}, // Load partition ID high byte
+        {BPF_ALU | BPF_LSH | BPF_K, 0, 0, 8},
+        {BPF_MISC | BPF_TAX, 0, 0, 0},
+        {BPF_LD | BPF_B | BPF_ABS, 0, 0, PartitionIdLow}, // Load partition ID low byte
+        {BPF_ALU | BPF_OR | BPF_X, 0, 0, 0},
+        {BPF_ALU | BPF_AND | BPF_K, 0, 0, PartitionIdMask}, // Partition index bits
+        {BPF_ALU | BPF_MOD, 0, 0, PartitionCount}, // MOD by PartitionCount
+        {BPF_RET | BPF_A, 0, 0, 0}, // Return
         {BPF_LD | BPF_W | BPF_ABS, 0, 0, SKF_AD_OFF | SKF_AD_CPU}, // Load CPU number
         {BPF_ALU | BPF_MOD, 0, 0, SocketCount}, // MOD by SocketCount
         {BPF_RET | BPF_A, 0, 0, 0} // Return
     };
 
     struct sock_fprog BpfConfig = {0};
-	BpfConfig.len = ARRAYSIZE(BpfCode);
-    BpfConfig.filter = BpfCode;
+    if (PartitionIdOffset != 0 && PartitionCount > 1 && PartitionCount <= SocketCount) {
+        BpfConfig.len = ARRAYSIZE(BpfCode);
+        BpfConfig.filter = BpfCode;
+    } else {
+        BpfConfig.len = 3;
+        BpfConfig.filter = &BpfCode[ARRAYSIZE(BpfCode) - 3];
+    }
 
     Result =
         setsockopt(
@@ -232,6 +271,9 @@ CxPlatSocketConfigureRss(
 #else
     UNREFERENCED_PARAMETER(SocketContext);
     UNREFERENCED_PARAMETER(SocketCount);
+    UNREFERENCED_PARAMETER(PartitionIdOffset);
+    UNREFERENCED_PARAMETER(PartitionIdMask);
+    UNREFERENCED_PARAMETER(PartitionCount);
     return QUIC_STATUS_NOT_SUPPORTED;
 #endif
 }
@@ -42,7 +42,10 @@ CxPlatDataPathCalculateFeatureSupport(
 QUIC_STATUS
 CxPlatSocketConfigureRss(
     _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
-    _In_ uint32_t SocketCount
+    _In_ uint32_t SocketCount,
+    _In_ uint8_t PartitionIdOffset,
+    _In_ uint16_t PartitionIdMask,
+    _In_ uint16_t PartitionCount
     );
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -197,6 +197,77 @@ RawSocketGetLocalMtu(
 
 }
 
+//
+// The maximum number of flows tracked at once while coalescing a receive batch.
+// Matches the kernel's per-NAPI GRO flow limit.
+//
+#define CXPLAT_DP_RAW_RX_MAX_FLOWS 8
+
+typedef struct CXPLAT_DP_RAW_RX_FLOW {
+    CXPLAT_RECV_DATA* Head;
+    CXPLAT_RECV_DATA** Tail;
+} CXPLAT_DP_RAW_RX_FLOW;
+
+//
+// Software equivalent of UDP GRO for the raw datapath. Chains the packets of a
+// receive batch, all destined to the same socket, so that packets of the same
+// flow (local and remote address) are contiguous, while keeping their relative
+// order within the flow. The upper layer splits the chain by connection, so
+// this lets it deliver interleaved flows in one batch per connection instead of
+// one per run of packets.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+static
+CXPLAT_RECV_DATA*
+CxPlatDpRawRxCoalesce(
+    _In_reads_(PacketCount)
+        CXPLAT_RECV_DATA** Packets,
+    _In_ uint16_t PacketCount
+    )
+{
+    CXPLAT_RECV_DATA* Chain = NULL;
+    CXPLAT_RECV_DATA** ChainTail = &Chain;
+    CXPLAT_DP_RAW_RX_FLOW Flows[CXPLAT_DP_RAW_RX_MAX_FLOWS];
+    uint8_t FlowCount = 0;
+
+    for (uint16_t i = 0; i < PacketCount; i++) {
+        CXPLAT_RECV_DATA* Packet = Packets[i];
+        CXPLAT_DBG_ASSERT(Packet->Next == NULL);
+
+        uint8_t Flow = 0;
+        while (Flow < FlowCount &&
+               (!QuicAddrCompare(&Flows[Flow].Head->Route->RemoteAddress, &Packet->Route->RemoteAddress) ||
+                !QuicAddrCompare(&Flows[Flow].Head->Route->LocalAddress, &Packet->Route->LocalAddress))) {
+            Flow++;
+        }
+
+        if (Flow == FlowCount) {
+            if (FlowCount == CXPLAT_DP_RAW_RX_MAX_FLOWS) {
+                //
+                // Too many flows in this batch. Move the oldest one to the
+                // output chain to make room.
+                //
+                *ChainTail = Flows[0].Head;
+                ChainTail = Flows[0].Tail;
+                CxPlatMoveMemory(Flows, Flows + 1, sizeof(Flows[0]) * (FlowCount - 1));
+                Flow = --FlowCount;
+            }
+            Flows[Flow].Head = Packet;
+            FlowCount++;
+        } else {
+            *Flows[Flow].Tail = Packet;
+        }
+        Flows[Flow].Tail = &Packet->Next;
+    }
+
+    for (uint8_t Flow = 0; Flow < FlowCount; Flow++) {
+        *ChainTail = Flows[Flow].Head;
+        ChainTail = Flows[Flow].Tail;
+    }
+
+    return Chain;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 CxPlatDpRawRxEthernet(
@@ -224,8 +295,10 @@ CxPlatDpRawRxEthernet(
             if (PacketChain->Reserved == L4_TYPE_UDP || PacketChain->Reserved == L4_TYPE_TCP) {
                 uint8_t SocketType = PacketChain->Route->UseQTIP ? L4_TYPE_TCP : L4_TYPE_UDP;
                 //
-                // Found a match. Chain and deliver contiguous packets with the same 4-tuple.
+                // Found a match. Coalesce and deliver contiguous packets for the
+                // same socket.
                 //
+                const uint16_t First = i;
                 while (i < PacketCount) {
                     QuicTraceEvent(
                         DatapathRecv,
@@ -241,10 +314,9 @@ CxPlatDpRawRxEthernet(
                         !CxPlatSocketCompare(Socket, &Packets[i+1]->Route->LocalAddress, &Packets[i+1]->Route->RemoteAddress)) {
                         break;
                     }
-                    Packets[i]->Next = Packets[i+1];
-                    CXPLAT_DBG_ASSERT(Packets[i+1]->Next == NULL);
                     i++;
                 }
+                PacketChain = CxPlatDpRawRxCoalesce(Packets + First, (uint16_t)(i - First + 1));
                 Datapath->ParentDataPath->UdpHandlers.Receive(CxPlatRawToSocket(Socket), Socket->ClientContext, PacketChain);
             } else if (PacketChain->Reserved == L4_TYPE_TCP_SYN || PacketChain->Reserved == L4_TYPE_TCP_SYNACK) {
                 CxPlatDpRawSocketAckSyn(Socket, PacketChain);
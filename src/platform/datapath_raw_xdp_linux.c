@@ -1236,7 +1236,8 @@ CxPlatXdpExecute(
     }
 
      const BOOLEAN PollingExpired =
-        CxPlatTimeDiff64(State->LastWorkTime, State->TimeNow) >= Xdp->PollingIdleTimeoutUs;
+        CxPlatTimeDiff64(State->LastWorkTime, State->TimeNow) >=
+            CXPLAT_MIN(Xdp->PollingIdleTimeoutUs, State->PollingIdleLimitUs);
 
     BOOLEAN DidWork = FALSE;
     CXPLAT_QUEUE* Queue = Partition->Queues;
@@ -922,6 +922,18 @@ DataPathUpdatePollingIdleTimeout(
     UNREFERENCED_PARAMETER(PollingIdleTimeoutUs);
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatDataPathSetNetworkEmulation(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _In_opt_ const QUIC_NETWORK_EMULATION_CONFIG* Config
+    )
+{
+    UNREFERENCED_PARAMETER(Datapath);
+    UNREFERENCED_PARAMETER(Config);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 CXPLAT_DATAPATH_FEATURES
 DataPathGetSupportedFeatures(
@@ -65,6 +65,9 @@ CxPlatDataPathUninitialize(
     _In_ CXPLAT_DATAPATH* Datapath
     )
 {
+#ifndef _KERNEL_MODE
+    CxPlatNetworkEmulationUninitialize(Datapath);
+#endif
     if (Datapath->RawDataPath) {
         RawDataPathUninitialize(Datapath->RawDataPath);
     }
@@ -217,6 +220,13 @@ CxPlatSocketDelete(
     _In_ CXPLAT_SOCKET* Socket
     )
 {
+#ifndef _KERNEL_MODE
+    CXPLAT_NETWORK_EMULATION* Emulation =
+        CxPlatDataPathGetNetworkEmulation(Socket->Datapath);
+    if (Emulation != NULL) {
+        CxPlatNetworkEmulationSocketDelete(Emulation, Socket);
+    }
+#endif
     if (Socket->RawSocketAvailable) {
         RawSocketDelete(CxPlatSocketToRaw(Socket));
     }
@@ -301,6 +311,14 @@ CxPlatSendDataAlloc(
         SendData = RawSendDataAlloc(Config);
     } else {
         SendData = SendDataAlloc(Socket, Config);
+#ifndef _KERNEL_MODE
+        if (SendData != NULL) {
+            CXPLAT_NETWORK_EMULATION* Emulation =
+                CxPlatDataPathGetNetworkEmulation(Socket->Datapath);
+            ((CXPLAT_SEND_DATA_COMMON*)SendData)->Emulated =
+                Emulation != NULL && CxPlatNetworkEmulationIsEnabled(Emulation);
+        }
+#endif
     }
     return SendData;
 }
@@ -357,8 +375,19 @@ CxPlatSendDataIsFull(
     CXPLAT_DBG_ASSERT(
         DatapathType(SendData) == CXPLAT_DATAPATH_TYPE_NORMAL ||
         DatapathType(SendData) == CXPLAT_DATAPATH_TYPE_RAW);
-    return DatapathType(SendData) == CXPLAT_DATAPATH_TYPE_NORMAL ?
-        SendDataIsFull(SendData) : RawSendDataIsFull(SendData);
+    if (DatapathType(SendData) == CXPLAT_DATAPATH_TYPE_NORMAL) {
+#ifndef _KERNEL_MODE
+        //
+        // Emulation handles (and drops) each datagram individually.
+        //
+        if (((CXPLAT_SEND_DATA_COMMON*)SendData)->Emulated &&
+            ((CXPLAT_SEND_DATA_COMMON*)SendData)->TotalSize != 0) {
+            return TRUE;
+        }
+#endif
+        return SendDataIsFull(SendData);
+    }
+    return RawSendDataIsFull(SendData);
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -370,6 +399,14 @@ CxPlatSocketSend(
     )
 {
     if (DatapathType(SendData) == CXPLAT_DATAPATH_TYPE_NORMAL) {
+#ifndef _KERNEL_MODE
+        CXPLAT_NETWORK_EMULATION* Emulation =
+            CxPlatDataPathGetNetworkEmulation(Socket->Datapath);
+        if (Emulation != NULL &&
+            CxPlatNetworkEmulationSend(Emulation, Socket, Route, SendData)) {
+            return;
+        }
+#endif
         SocketSend(Socket, Route, SendData);
      } else {
         CXPLAT_DBG_ASSERT(DatapathType(SendData) == CXPLAT_DATAPATH_TYPE_RAW);
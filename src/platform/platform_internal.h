@@ -61,6 +61,11 @@ typedef struct CXPLAT_DATAPATH_COMMON {
     CXPLAT_DATAPATH_FEATURES Features;
 
     CXPLAT_DATAPATH_RAW* RawDataPath;
+
+    //
+    // Optional network emulation applied to socket sends.
+    //
+    struct CXPLAT_NETWORK_EMULATION* NetworkEmulation;
 } CXPLAT_DATAPATH_COMMON;
 
 typedef struct CXPLAT_SOCKET_COMMON {
@@ -112,6 +117,12 @@ typedef struct CXPLAT_SEND_DATA_COMMON {
     // The send segmentation size; zero if segmentation is not performed.
     //
     uint16_t SegmentSize;
+
+    //
+    // Set if the send goes through network emulation, which needs one
+    // datagram per send.
+    //
+    BOOLEAN Emulated;
 } CXPLAT_SEND_DATA_COMMON;
 
 typedef enum CXPLAT_DATAPATH_TYPE {
@@ -1145,6 +1156,76 @@ SocketSend(
     _In_ CXPLAT_SEND_DATA* SendData
     );
 
+//
+// Network emulation (datapath_emulation.c).
+//
+
+typedef struct CXPLAT_NETWORK_EMULATION CXPLAT_NETWORK_EMULATION;
+
+//
+// The emulation is created on the first QUIC_PARAM_GLOBAL_NETWORK_EMULATION
+// set call while sends may already be running on other threads, so it is
+// published with release semantics and must be read with acquire semantics.
+//
+QUIC_INLINE
+CXPLAT_NETWORK_EMULATION*
+CxPlatDataPathGetNetworkEmulation(
+    _In_ const CXPLAT_DATAPATH* Datapath
+    )
+{
+#ifdef _WIN32
+    return (CXPLAT_NETWORK_EMULATION*)
+        ReadPointerAcquire((PVOID const volatile*)&Datapath->NetworkEmulation);
+#else
+    return __atomic_load_n(&Datapath->NetworkEmulation, __ATOMIC_ACQUIRE);
+#endif
+}
+
+QUIC_INLINE
+void
+CxPlatDataPathPublishNetworkEmulation(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _In_opt_ CXPLAT_NETWORK_EMULATION* Emulation
+    )
+{
+#ifdef _WIN32
+    WritePointerRelease((PVOID volatile*)&Datapath->NetworkEmulation, Emulation);
+#else
+    __atomic_store_n(&Datapath->NetworkEmulation, Emulation, __ATOMIC_RELEASE);
+#endif
+}
+
+//
+// Returns TRUE if the emulation took ownership of the send.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CxPlatNetworkEmulationSend(
+    _In_ CXPLAT_NETWORK_EMULATION* Emulation,
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ const CXPLAT_ROUTE* Route,
+    _In_ CXPLAT_SEND_DATA* SendData
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CxPlatNetworkEmulationIsEnabled(
+    _In_ const CXPLAT_NETWORK_EMULATION* Emulation
+    );
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatNetworkEmulationSocketDelete(
+    _In_ CXPLAT_NETWORK_EMULATION* Emulation,
+    _In_ CXPLAT_SOCKET* Socket
+    );
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatNetworkEmulationUninitialize(
+    _In_ CXPLAT_DATAPATH* Datapath
+    );
+
 CXPLAT_SOCKET*
 CxPlatRawToSocket(
     _In_ CXPLAT_SOCKET_RAW* Socket
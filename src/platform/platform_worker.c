@@ -68,6 +68,21 @@ typedef struct QUIC_CACHEALIGN CXPLAT_WORKER {
     //
     CXPLAT_SLIST_ENTRY* ExecutionContexts;
 
+    //
+    // The configured idle polling time, which bounds the adaptive limit, and
+    // the moving average of the time between consecutive loops that did work.
+    //
+    uint32_t PollingIdleTimeoutUs;
+    uint32_t WorkGapAvgUs;
+
+    //
+    // CPU efficiency statistics. Time spent processing work vs. time spent
+    // polling without finding any work (excludes time blocked waiting).
+    //
+    uint64_t IntervalStartTime;
+    uint64_t ActiveTimeUs;
+    uint64_t PollTimeUs;
+
 #if DEBUG // Debug statistics
     uint64_t LoopCount;
     uint64_t EcPollCount;
@@ -89,6 +104,7 @@ typedef struct QUIC_CACHEALIGN CXPLAT_WORKER {
     BOOLEAN InitializedUpdatePollSqe : 1;
     BOOLEAN InitializedThread : 1;
     BOOLEAN InitializedECLock : 1;
+    BOOLEAN AdaptivePolling : 1;
     BOOLEAN StoppingThread : 1;
     BOOLEAN StoppedThread : 1;
     BOOLEAN DestroyedThread : 1;
@@ -164,6 +180,10 @@ CxPlatWorkerPoolInitWorker(
     Worker->IdealProcessor = IdealProcessor;
     Worker->State.WaitTime = UINT32_MAX;
     Worker->State.ThreadID = UINT32_MAX;
+    Worker->State.PollingIdleLimitUs = UINT32_MAX;
+    if (Worker->AdaptivePolling) {
+        Worker->State.PollingIdleLimitUs = Worker->PollingIdleTimeoutUs;
+    }
 
     if (EventQ != NULL) {
         Worker->EventQ = *EventQ;
@@ -296,6 +316,7 @@ CxPlatWorkerPoolCreate(
     // Build up the configuration for creating the worker threads.
     //
     uint16_t ThreadFlags = CXPLAT_THREAD_FLAG_SET_IDEAL_PROC;
+    BOOLEAN AdaptivePolling = FALSE;
     if (Config) {
         if (Config->Flags & QUIC_GLOBAL_EXECUTION_CONFIG_FLAG_NO_IDEAL_PROC) {
             ThreadFlags &= ~CXPLAT_THREAD_FLAG_SET_IDEAL_PROC; // Remove the flag
@@ -306,6 +327,10 @@ CxPlatWorkerPoolCreate(
         if (Config->Flags & QUIC_GLOBAL_EXECUTION_CONFIG_FLAG_AFFINITIZE) {
             ThreadFlags |= CXPLAT_THREAD_FLAG_SET_AFFINITIZE;
         }
+        if (Config->Flags & QUIC_GLOBAL_EXECUTION_CONFIG_FLAG_ADAPTIVE_POLLING &&
+            Config->PollingIdleTimeoutUs != 0) {
+            AdaptivePolling = TRUE;
+        }
     }
 
     CXPLAT_THREAD_CONFIG ThreadConfig = {
@@ -326,6 +351,8 @@ CxPlatWorkerPoolCreate(
         CXPLAT_DBG_ASSERT(IdealProcessor < CxPlatProcCount());
 
         CXPLAT_WORKER* Worker = &WorkerPool->Workers[i];
+        Worker->AdaptivePolling = AdaptivePolling;
+        Worker->PollingIdleTimeoutUs = Config ? Config->PollingIdleTimeoutUs : 0;
         if (!CxPlatWorkerPoolInitWorker(
                 Worker, IdealProcessor, NULL, &ThreadConfig)) {
             goto Error;
@@ -468,6 +495,22 @@ CxPlatWorkerPoolGetIdealProcessor(
     return WorkerPool->Workers[Index].IdealProcessor;
 }
 
+void
+CxPlatWorkerPoolGetExecutionTime(
+    _In_ CXPLAT_WORKER_POOL* WorkerPool,
+    _Out_ uint64_t* ActiveTimeUs,
+    _Out_ uint64_t* PollTimeUs
+    )
+{
+    CXPLAT_DBG_ASSERT(WorkerPool);
+    *ActiveTimeUs = 0;
+    *PollTimeUs = 0;
+    for (uint32_t i = 0; i < WorkerPool->WorkerCount; ++i) {
+        *ActiveTimeUs += WorkerPool->Workers[i].ActiveTimeUs;
+        *PollTimeUs += WorkerPool->Workers[i].PollTimeUs;
+    }
+}
+
 CXPLAT_EVENTQ*
 CxPlatWorkerPoolGetEventQ(
     _In_ CXPLAT_WORKER_POOL* WorkerPool,
@@ -672,18 +715,101 @@ CxPlatProcessDynamicPoolAllocators(
     CxPlatLockRelease(&Worker->ECLock);
 }
 
-void
+//
+// The maximum number of completions dequeued per loop.
+//
+#define CXPLAT_WORKER_MAX_CQE_COUNT 16
+
+//
+// Charges the time since the start of the current interval to either the
+// active or the poll time, depending on whether any work has been done in this
+// loop yet.
+//
+static void
+CxPlatWorkerAccountTime(
+    _Inout_ CXPLAT_WORKER* Worker,
+    _In_ BOOLEAN DidWork,
+    _In_ uint64_t TimeNow
+    )
+{
+    const uint64_t Elapsed = CxPlatTimeDiff64(Worker->IntervalStartTime, TimeNow);
+    if (DidWork) {
+        Worker->ActiveTimeUs += Elapsed;
+    } else {
+        Worker->PollTimeUs += Elapsed;
+    }
+    Worker->IntervalStartTime = TimeNow;
+}
+
+//
+// The smallest idle polling limit used while the worker is considered loaded.
+//
+#define CXPLAT_WORKER_MIN_POLLING_IDLE_LIMIT_US 10
+
+//
+// Updates the adaptive idle polling limit after a loop that did work. The limit
+// tracks twice the average gap between loops that found work, so a worker
+// keeps spinning as long as new work is likely to show up before the limit
+// expires. If work arrives less often than the configured idle polling time,
+// the worker stops spinning altogether and falls back to waiting on the event
+// queue. A full batch of completions means there is a backlog, so the average
+// is reset to immediately return to polling.
+//
+static void
+CxPlatWorkerUpdatePollingIdleLimit(
+    _Inout_ CXPLAT_WORKER* Worker,
+    _In_ uint32_t CqeCount
+    )
+{
+    const uint32_t MaxTimeoutUs = Worker->PollingIdleTimeoutUs;
+    if (CqeCount == CXPLAT_WORKER_MAX_CQE_COUNT) {
+        Worker->WorkGapAvgUs = 0;
+    } else {
+        //
+        // The current interval starts after any blocking wait, so this gap
+        // includes the time spent asleep.
+        //
+        uint64_t Gap = CxPlatTimeDiff64(Worker->State.LastWorkTime, Worker->IntervalStartTime);
+        if (Gap > 2 * (uint64_t)MaxTimeoutUs) {
+            Gap = 2 * (uint64_t)MaxTimeoutUs; // Bound how long it takes to recover.
+        }
+        Worker->WorkGapAvgUs = (uint32_t)((7 * (uint64_t)Worker->WorkGapAvgUs + Gap) / 8);
+    }
+
+    uint32_t Limit;
+    if (Worker->WorkGapAvgUs > MaxTimeoutUs) {
+        Limit = 0;
+    } else {
+        Limit = CXPLAT_MAX(2 * Worker->WorkGapAvgUs, CXPLAT_WORKER_MIN_POLLING_IDLE_LIMIT_US);
+        Limit = CXPLAT_MIN(Limit, MaxTimeoutUs);
+    }
+
+    Worker->State.PollingIdleLimitUs = Limit;
+}
+
+uint32_t
 CxPlatProcessEvents(
     _In_ CXPLAT_WORKER* Worker
     )
 {
-    CXPLAT_CQE Cqes[16];
+    CXPLAT_CQE Cqes[CXPLAT_WORKER_MAX_CQE_COUNT];
+    if (Worker->State.WaitTime != 0) {
+        //
+        // The dequeue may block, so close out the current interval first and
+        // start a new one once the wait completes.
+        //
+        CxPlatWorkerAccountTime(
+            Worker, Worker->State.NoWorkCount == 0, CxPlatTimeUs64());
+    }
     uint32_t CqeCount =
         CxPlatEventQDequeue(
             &Worker->EventQ,
             Cqes,
             ARRAYSIZE(Cqes),
             Worker->State.WaitTime);
+    if (Worker->State.WaitTime != 0) {
+        Worker->IntervalStartTime = CxPlatTimeUs64();
+    }
     uint32_t CurrentCqeCount = CqeCount;
     CXPLAT_CQE* CurrentCqe = Cqes;
 
@@ -718,6 +844,8 @@ CxPlatProcessEvents(
         }
         CxPlatEventQReturn(&Worker->EventQ, CqeCount);
     }
+
+    return CqeCount;
 }
 
 //
@@ -740,6 +868,8 @@ CXPLAT_THREAD_CALLBACK(CxPlatWorkerThread, Context)
 
     Worker->State.ThreadID = CxPlatCurThreadID();
     Worker->Running = TRUE;
+    Worker->IntervalStartTime = CxPlatTimeUs64();
+    BOOLEAN DidWork = FALSE;
 
     while (!Worker->StoppedThread) {
 
@@ -748,6 +878,7 @@ CXPLAT_THREAD_CALLBACK(CxPlatWorkerThread, Context)
         ++Worker->LoopCount;
 #endif
         Worker->State.TimeNow = CxPlatTimeUs64();
+        CxPlatWorkerAccountTime(Worker, DidWork, Worker->State.TimeNow);
 
         CxPlatRunExecutionContexts(Worker);
         if (Worker->State.WaitTime && InterlockedFetchAndClearBoolean(&Worker->Running)) {
@@ -755,9 +886,13 @@ CXPLAT_THREAD_CALLBACK(CxPlatWorkerThread, Context)
             CxPlatRunExecutionContexts(Worker); // Run once more to handle race conditions
         }
 
-        CxPlatProcessEvents(Worker);
+        const uint32_t CqeCount = CxPlatProcessEvents(Worker);
 
-        if (Worker->State.NoWorkCount == 0) {
+        DidWork = Worker->State.NoWorkCount == 0;
+        if (DidWork) {
+            if (Worker->AdaptivePolling) {
+                CxPlatWorkerUpdatePollingIdleLimit(Worker, CqeCount);
+            }
             Worker->State.LastWorkTime = Worker->State.TimeNow;
         } else if (Worker->State.NoWorkCount > CXPLAT_WORKER_IDLE_WORK_THRESHOLD_COUNT) {
             CxPlatSchedulerYield();
@@ -45,6 +45,14 @@ uint16_t CxPlatTlsTPHeaderSize = 0;
 const size_t OpenSslFilePrefixLength = sizeof("..\\..\\..\\..\\..\\..\\submodules");
 
 #define PFX_PASSWORD_LENGTH 33
+
+//
+// The maximum number of idle SSL objects kept per server sec config for reuse
+// by new connections, and the number created up front.
+//
+#define CXPLAT_TLS_SSL_POOL_SIZE        64
+#define CXPLAT_TLS_SSL_POOL_PREWARM     16
+
 //
 // The QUIC sec config object. Created once per listener on server side and
 // once per connection on client side.
@@ -77,6 +85,14 @@ typedef struct CXPLAT_SEC_CONFIG {
     //
     CXPLAT_TLS_CREDENTIAL_FLAGS TlsFlags;
 
+    //
+    // Server only. Cleared SSL objects from completed connections, reused by
+    // new connections to avoid an SSL_new/SSL_free per handshake.
+    //
+    CXPLAT_LOCK SslPoolLock;
+    uint32_t SslPoolCount;
+    SSL* SslPool[CXPLAT_TLS_SSL_POOL_SIZE];
+
 } CXPLAT_SEC_CONFIG;
 
 //
@@ -1066,6 +1082,7 @@ CxPlatTlsSecConfigCreate(
     }
 
     CxPlatZeroMemory(SecurityConfig, sizeof(CXPLAT_SEC_CONFIG));
+    CxPlatLockInitialize(&SecurityConfig->SslPoolLock);
     SecurityConfig->Callbacks = *TlsCallbacks;
     SecurityConfig->Flags = CredConfigFlags;
     SecurityConfig->TlsFlags = TlsCredFlags;
@@ -1553,6 +1570,18 @@ CxPlatTlsSecConfigCreate(
 
         SSL_CTX_set_max_early_data(SecurityConfig->SSLCtx, UINT32_MAX);
         SSL_CTX_set_client_hello_cb(SecurityConfig->SSLCtx, CxPlatTlsClientHelloCallback, NULL);
+
+        //
+        // Pre-create some SSL objects so the first handshakes don't pay for
+        // them either. Failure here isn't fatal; they're created on demand.
+        //
+        while (SecurityConfig->SslPoolCount < CXPLAT_TLS_SSL_POOL_PREWARM) {
+            SSL* Ssl = SSL_new(SecurityConfig->SSLCtx);
+            if (Ssl == NULL) {
+                break;
+            }
+            SecurityConfig->SslPool[SecurityConfig->SslPoolCount++] = Ssl;
+        }
     }
 
     //
@@ -1596,6 +1625,11 @@ CxPlatTlsSecConfigDelete(
         CXPLAT_SEC_CONFIG* SecurityConfig
     )
 {
+    while (SecurityConfig->SslPoolCount > 0) {
+        SSL_free(SecurityConfig->SslPool[--SecurityConfig->SslPoolCount]);
+    }
+    CxPlatLockUninitialize(&SecurityConfig->SslPoolLock);
+
     if (SecurityConfig->SSLCtx != NULL) {
         SSL_CTX_free(SecurityConfig->SSLCtx);
     }
@@ -1727,7 +1761,17 @@ CxPlatTlsInitialize(
     // Create a SSL object for the connection.
     //
 
-    TlsContext->Ssl = SSL_new(Config->SecConfig->SSLCtx);
+    if (Config->IsServer) {
+        CXPLAT_SEC_CONFIG* SecConfig = Config->SecConfig;
+        CxPlatLockAcquire(&SecConfig->SslPoolLock);
+        if (SecConfig->SslPoolCount > 0) {
+            TlsContext->Ssl = SecConfig->SslPool[--SecConfig->SslPoolCount];
+        }
+        CxPlatLockRelease(&SecConfig->SslPoolLock);
+    }
+    if (TlsContext->Ssl == NULL) {
+        TlsContext->Ssl = SSL_new(Config->SecConfig->SSLCtx);
+    }
     if (TlsContext->Ssl == NULL) {
         QuicTraceEvent(
             TlsError,
@@ -1832,6 +1876,42 @@ Exit:
     return Status;
 }
 
+//
+// Resets a server SSL object and returns it to the sec config's pool. Returns
+// FALSE if it couldn't be reused, in which case the caller frees it.
+//
+static
+BOOLEAN
+CxPlatTlsSslPoolReturn(
+    _In_ CXPLAT_SEC_CONFIG* SecConfig,
+    _In_ SSL* Ssl
+    )
+{
+    if (SecConfig->SslPoolCount >= CXPLAT_TLS_SSL_POOL_SIZE) {
+        return FALSE; // Racy check, to avoid the reset when it's likely full.
+    }
+
+    //
+    // SSL_clear keeps the settings inherited from the SSL_CTX (including the
+    // QUIC method), but drops all per-connection state: handshake, keys,
+    // transport parameters, ALPN and session.
+    //
+    SSL_set_session(Ssl, NULL);
+    if (!SSL_clear(Ssl)) {
+        return FALSE;
+    }
+    SSL_set_app_data(Ssl, NULL);
+
+    BOOLEAN Pooled = FALSE;
+    CxPlatLockAcquire(&SecConfig->SslPoolLock);
+    if (SecConfig->SslPoolCount < CXPLAT_TLS_SSL_POOL_SIZE) {
+        SecConfig->SslPool[SecConfig->SslPoolCount++] = Ssl;
+        Pooled = TRUE;
+    }
+    CxPlatLockRelease(&SecConfig->SslPoolLock);
+    return Pooled;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 CxPlatTlsUninitialize(
@@ -1850,7 +1930,9 @@ CxPlatTlsUninitialize(
         }
 
         if (TlsContext->Ssl != NULL) {
-            SSL_free(TlsContext->Ssl);
+            if (!TlsContext->IsServer || !CxPlatTlsSslPoolReturn(TlsContext->SecConfig, TlsContext->Ssl)) {
+                SSL_free(TlsContext->Ssl);
+            }
             TlsContext->Ssl = NULL;
         }
 
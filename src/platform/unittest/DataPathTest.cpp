@@ -1089,6 +1089,99 @@ TEST_P(DataPathTest, MultiBindListenerSingleProcessor) {
     ASSERT_EQ(QUIC_STATUS_ADDRESS_IN_USE, Server2.GetInitStatus());
 }
 
+#ifdef CX_PLATFORM_LINUX
+struct UdpSteeringContext {
+    CXPLAT_EVENT RecvEvent;
+    uint16_t PartitionIndex {UINT16_MAX};
+    UdpSteeringContext() {
+        CxPlatEventInitialize(&RecvEvent, FALSE, FALSE);
+    }
+    ~UdpSteeringContext() {
+        CxPlatEventUninitialize(RecvEvent);
+    }
+    static void
+    RecvCallback(
+        _In_ CXPLAT_SOCKET* /* Socket */,
+        _In_ void* Context,
+        _In_ CXPLAT_RECV_DATA* RecvDataChain
+        )
+    {
+        UdpSteeringContext* SteeringContext = (UdpSteeringContext*)Context;
+        if (SteeringContext != nullptr) {
+            SteeringContext->PartitionIndex = RecvDataChain->PartitionIndex;
+            CxPlatEventSet(SteeringContext->RecvEvent);
+        }
+        CxPlatRecvDataReturn(RecvDataChain);
+    }
+};
+
+TEST_P(DataPathTest, UdpPartitionSteering)
+{
+    const uint16_t PartitionCount = 2;
+    const uint8_t PartitionIdOffset = 1;
+    if (CxPlatProcCount() < PartitionCount) {
+        GTEST_SKIP_("Needs more than one processor");
+    }
+
+    const CXPLAT_UDP_DATAPATH_CALLBACKS SteeringCallbacks = {
+        UdpSteeringContext::RecvCallback,
+        EmptyUnreachableCallback,
+    };
+    UdpSteeringContext RecvContext;
+    CxPlatDataPath Datapath(&SteeringCallbacks);
+    VERIFY_QUIC_SUCCESS(Datapath.GetInitStatus());
+    if (Datapath.IsSupported(CXPLAT_DATAPATH_FEATURE_RAW)) {
+        GTEST_SKIP_("Reuseport steering only applies to sockets");
+    }
+
+    auto unspecAddress = GetNewUnspecAddr();
+    CXPLAT_UDP_CONFIG UdpConfig = {0};
+    UdpConfig.LocalAddress = &unspecAddress.SockAddr;
+    UdpConfig.CallbackContext = &RecvContext;
+    UdpConfig.PartitionIdOffset = PartitionIdOffset;
+    UdpConfig.PartitionIdMask = PartitionCount - 1;
+    UdpConfig.PartitionCount = PartitionCount;
+    CXPLAT_SOCKET* Server = nullptr;
+    QUIC_STATUS Status = CxPlatSocketCreateUdp(Datapath, &UdpConfig, &Server);
+    while (Status == QUIC_STATUS_ADDRESS_IN_USE) {
+        unspecAddress.SockAddr.Ipv4.sin_port = GetNextPort();
+        Status = CxPlatSocketCreateUdp(Datapath, &UdpConfig, &Server);
+    }
+    VERIFY_QUIC_SUCCESS(Status);
+
+    QuicAddr ServerAddress = GetNewLocalAddr();
+    QUIC_ADDR ServerLocalAddress;
+    CxPlatSocketGetLocalAddress(Server, &ServerLocalAddress);
+    QuicAddrSetPort(&ServerAddress.SockAddr, QuicAddrGetPort(&ServerLocalAddress));
+
+    CxPlatSocket Client(Datapath, nullptr, &ServerAddress.SockAddr, nullptr);
+    VERIFY_QUIC_SUCCESS(Client.GetInitStatus());
+
+    //
+    // Whatever CPU sends it, a short header packet must be delivered on the
+    // socket (and therefore the datapath partition) of the partition ID it
+    // carries.
+    //
+    for (uint32_t i = 0; i < 4 * PartitionCount; ++i) {
+        const uint16_t PartitionId = (uint16_t)(i % PartitionCount);
+        CXPLAT_SEND_CONFIG SendConfig = { &Client.Route, 0, CXPLAT_ECN_NON_ECT, 0, CXPLAT_DSCP_CS0 };
+        auto SendData = CxPlatSendDataAlloc(Client, &SendConfig);
+        ASSERT_NE(nullptr, SendData);
+        auto Buffer = CxPlatSendDataAllocBuffer(SendData, 32);
+        ASSERT_NE(nullptr, Buffer);
+        CxPlatZeroMemory(Buffer->Buffer, 32);
+        Buffer->Buffer[0] = 0x40; // Short header
+        CxPlatCopyMemory(Buffer->Buffer + PartitionIdOffset, &PartitionId, sizeof(PartitionId));
+
+        Client.Send(SendData);
+        ASSERT_TRUE(CxPlatEventWaitWithTimeout(RecvContext.RecvEvent, 2000));
+        ASSERT_EQ(PartitionId, RecvContext.PartitionIndex);
+    }
+
+    CxPlatSocketDelete(Server);
+}
+#endif // CX_PLATFORM_LINUX
+
 TEST_F(DataPathTest, TcpListener)
 {
     CxPlatDataPath Datapath(nullptr, &EmptyTcpCallbacks);
@@ -136,6 +136,7 @@ namespace QuicTrace.DataModel
         TimerLossDetection,
         TimerKeepAlive,
         TimerIdle,
+        TimerPath,
         TimerShutdown
     }
 
@@ -440,6 +440,8 @@ pub const QUIC_GLOBAL_EXECUTION_CONFIG_FLAGS_QUIC_GLOBAL_EXECUTION_CONFIG_FLAG_H
     QUIC_GLOBAL_EXECUTION_CONFIG_FLAGS = 16;
 pub const QUIC_GLOBAL_EXECUTION_CONFIG_FLAGS_QUIC_GLOBAL_EXECUTION_CONFIG_FLAG_AFFINITIZE:
     QUIC_GLOBAL_EXECUTION_CONFIG_FLAGS = 32;
+pub const QUIC_GLOBAL_EXECUTION_CONFIG_FLAGS_QUIC_GLOBAL_EXECUTION_CONFIG_FLAG_ADAPTIVE_POLLING:
+    QUIC_GLOBAL_EXECUTION_CONFIG_FLAGS = 64;
 pub type QUIC_GLOBAL_EXECUTION_CONFIG_FLAGS = ::std::os::raw::c_uint;
 #[repr(C)]
 #[derive(Debug, Copy, Clone)]
@@ -1193,10 +1195,15 @@ pub struct QUIC_STATISTICS_V2 {
     pub SendEcnCongestionCount: u32,
     pub HandshakeHopLimitTTL: u8,
     pub RttVariance: u32,
+    pub SendConnFlowControlBlockedTimeUs: u64,
+    pub RecvConnFlowControlWindow: u64,
+    pub SendDatagramsDroppedExpired: u64,
+    pub SendDatagramsDroppedBlocked: u64,
+    pub SendDatagramsDroppedTooLarge: u64,
 }
 #[allow(clippy::unnecessary_operation, clippy::identity_op)]
 const _: () = {
-    ["Size of QUIC_STATISTICS_V2"][::std::mem::size_of::<QUIC_STATISTICS_V2>() - 208usize];
+    ["Size of QUIC_STATISTICS_V2"][::std::mem::size_of::<QUIC_STATISTICS_V2>() - 248usize];
     ["Alignment of QUIC_STATISTICS_V2"][::std::mem::align_of::<QUIC_STATISTICS_V2>() - 8usize];
     ["Offset of field: QUIC_STATISTICS_V2::CorrelationId"]
         [::std::mem::offset_of!(QUIC_STATISTICS_V2, CorrelationId) - 0usize];
@@ -1264,6 +1271,16 @@ const _: () = {
         [::std::mem::offset_of!(QUIC_STATISTICS_V2, HandshakeHopLimitTTL) - 200usize];
     ["Offset of field: QUIC_STATISTICS_V2::RttVariance"]
         [::std::mem::offset_of!(QUIC_STATISTICS_V2, RttVariance) - 204usize];
+    ["Offset of field: QUIC_STATISTICS_V2::SendConnFlowControlBlockedTimeUs"]
+        [::std::mem::offset_of!(QUIC_STATISTICS_V2, SendConnFlowControlBlockedTimeUs) - 208usize];
+    ["Offset of field: QUIC_STATISTICS_V2::RecvConnFlowControlWindow"]
+        [::std::mem::offset_of!(QUIC_STATISTICS_V2, RecvConnFlowControlWindow) - 216usize];
+    ["Offset of field: QUIC_STATISTICS_V2::SendDatagramsDroppedExpired"]
+        [::std::mem::offset_of!(QUIC_STATISTICS_V2, SendDatagramsDroppedExpired) - 224usize];
+    ["Offset of field: QUIC_STATISTICS_V2::SendDatagramsDroppedBlocked"]
+        [::std::mem::offset_of!(QUIC_STATISTICS_V2, SendDatagramsDroppedBlocked) - 232usize];
+    ["Offset of field: QUIC_STATISTICS_V2::SendDatagramsDroppedTooLarge"]
+        [::std::mem::offset_of!(QUIC_STATISTICS_V2, SendDatagramsDroppedTooLarge) - 240usize];
 };
 impl QUIC_STATISTICS_V2 {
     #[inline]
@@ -1679,7 +1696,10 @@ pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_SEND_STATELESS_RETRY:
     QUIC_PERFORMANCE_COUNTERS = 30;
 pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_CONN_LOAD_REJECT: QUIC_PERFORMANCE_COUNTERS =
     31;
-pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_MAX: QUIC_PERFORMANCE_COUNTERS = 32;
+pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_WORK_ACTIVE_US: QUIC_PERFORMANCE_COUNTERS =
+    32;
+pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_WORK_POLL_US: QUIC_PERFORMANCE_COUNTERS = 33;
+pub const QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_MAX: QUIC_PERFORMANCE_COUNTERS = 34;
 pub type QUIC_PERFORMANCE_COUNTERS = ::std::os::raw::c_uint;
 #[repr(C)]
 #[derive(Debug, Copy, Clone)]
@@ -258,6 +258,8 @@ pub struct QuicPerformanceCounters {
     pub send_stateless_reset: i64,
     pub send_stateless_retry: i64,
     pub conn_load_reject: i64,
+    pub work_active_us: i64,
+    pub work_poll_us: i64,
 }
 
 pub const QUIC_TLS_SECRETS_MAX_SECRET_LEN: usize = 64;
@@ -524,6 +526,10 @@ impl From<QuicPerformanceCountersParam> for QuicPerformanceCounters {
                     as usize],
             conn_load_reject: value
                 [crate::ffi::QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_CONN_LOAD_REJECT as usize],
+            work_active_us: value
+                [crate::ffi::QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_WORK_ACTIVE_US as usize],
+            work_poll_us: value
+                [crate::ffi::QUIC_PERFORMANCE_COUNTERS_QUIC_PERF_COUNTER_WORK_POLL_US as usize],
         }
     }
 }
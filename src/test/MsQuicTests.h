@@ -62,6 +62,7 @@ void QuicTestVersionSettings();
 void QuicTestValidateParamApi();
 void QuicTestCredentialLoad(const QUIC_CREDENTIAL_CONFIG* Config);
 void QuicTestValidateConnectionPoolCreate();
+void QuicTestValidateContent();
 void QuicTestRetryConfigSetting();
 
 //
@@ -116,6 +117,7 @@ QuicTestMtuDiscovery(
     _In_ BOOLEAN DropServerProbePackets,
     _In_ BOOLEAN RaiseMinimumMtu
     );
+void QuicTestMtuBlackHole(_In_ int Family);
 
 //
 // Path tests
@@ -125,6 +127,11 @@ QuicTestLocalPathChanges(
     _In_ int Family
     );
 
+void
+QuicTestMultipathScheduling(
+    _In_ int Family
+    );
+
 //
 // Handshake Tests
 //
@@ -577,6 +584,14 @@ void
 QuicTestStreamPriorityInfiniteLoop(
     );
 
+void
+QuicTestStreamWeightedFairScheduling(
+    );
+
+void
+QuicTestStreamSendMultiProducer(
+    );
+
 void
 QuicTestStreamDifferentAbortErrors(
     );
@@ -629,6 +644,16 @@ void QuicTestStreamAppProvidedBuffers(
 void QuicTestStreamAppProvidedBuffersOutOfSpace(
     );
 
+void
+QuicTestRecvWindowAutoTune(
+    _In_ int Family
+    );
+
+void
+QuicTestSendBufferLatencyTarget(
+    _In_ int Family
+    );
+
 //
 // QuicDrill tests
 //
@@ -679,6 +704,11 @@ QuicTestDatagramDrop(
     _In_ int Family
     );
 
+void
+QuicTestDatagramSendBatch(
+    _In_ int Family
+    );
+
 //
 // Storage tests
 //
@@ -1407,4 +1437,33 @@ struct QUIC_RUN_CONNECTION_POOL_CREATE_PARAMS {
 #define IOCTL_QUIC_RUN_RETRY_CONFIG_SETTING \
     QUIC_CTL_CODE(134, METHOD_BUFFERED, FILE_WRITE_DATA)
 
-#define QUIC_MAX_IOCTL_FUNC_CODE 134
+#define IOCTL_QUIC_RUN_STREAM_WEIGHTED_FAIR_SCHEDULING \
+    QUIC_CTL_CODE(135, METHOD_BUFFERED, FILE_WRITE_DATA)
+
+#define IOCTL_QUIC_RUN_MULTIPATH_SCHEDULING \
+    QUIC_CTL_CODE(136, METHOD_BUFFERED, FILE_WRITE_DATA)
+    // int - Family
+
+#define IOCTL_QUIC_RUN_MTU_BLACK_HOLE \
+    QUIC_CTL_CODE(137, METHOD_BUFFERED, FILE_WRITE_DATA)
+    // int - Family
+
+#define IOCTL_QUIC_RUN_DATAGRAM_SEND_BATCH \
+    QUIC_CTL_CODE(138, METHOD_BUFFERED, FILE_WRITE_DATA)
+    // int - Family
+
+#define IOCTL_QUIC_RUN_VALIDATE_CONTENT \
+    QUIC_CTL_CODE(139, METHOD_BUFFERED, FILE_WRITE_DATA)
+
+#define IOCTL_QUIC_RUN_STREAM_SEND_MULTI_PRODUCER \
+    QUIC_CTL_CODE(140, METHOD_BUFFERED, FILE_WRITE_DATA)
+
+#define IOCTL_QUIC_RUN_RECV_WINDOW_AUTO_TUNE \
+    QUIC_CTL_CODE(141, METHOD_BUFFERED, FILE_WRITE_DATA)
+    // int - Family
+
+#define IOCTL_QUIC_RUN_SEND_BUFFER_LATENCY_TARGET \
+    QUIC_CTL_CODE(142, METHOD_BUFFERED, FILE_WRITE_DATA)
+    // int - Family
+
+#define QUIC_MAX_IOCTL_FUNC_CODE 142
@@ -367,6 +367,15 @@ TEST(ParameterValidation, ValidateConnectionPoolCreate) {
         QuicTestValidateConnectionPoolCreate();
     }
 }
+
+TEST(ParameterValidation, ValidateContent) {
+    TestLogger Logger("QuicTestValidateContent");
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_VALIDATE_CONTENT));
+    } else {
+        QuicTestValidateContent();
+    }
+}
 #endif
 
 TEST(OwnershipValidation, RegistrationShutdownBeforeConnOpen) {
@@ -628,6 +637,15 @@ TEST_P(WithFamilyArgs, LocalPathChanges) {
     }
 }
 
+TEST_P(WithFamilyArgs, MultipathScheduling) {
+    TestLoggerT<ParamType> Logger("QuicTestMultipathScheduling", GetParam());
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_MULTIPATH_SCHEDULING, GetParam().Family));
+    } else {
+        QuicTestMultipathScheduling(GetParam().Family);
+    }
+}
+
 TEST(Mtu, Settings) {
     TestLogger Logger("QuicTestMtuSettings");
     if (TestingKernelMode) {
@@ -657,6 +675,15 @@ TEST_P(WithMtuArgs, MtuDiscovery) {
     }
 }
 
+TEST_P(WithFamilyArgs, MtuBlackHole) {
+    TestLoggerT<ParamType> Logger("QuicTestMtuBlackHole", GetParam());
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_MTU_BLACK_HOLE, GetParam().Family));
+    } else {
+        QuicTestMtuBlackHole(GetParam().Family);
+    }
+}
+
 #endif // QUIC_TEST_DATAPATH_HOOKS_ENABLED
 
 TEST(Alpn, ValidAlpnLengths) {
@@ -2261,6 +2288,24 @@ TEST(Misc, StreamPriority) {
     }
 }
 
+TEST(Misc, StreamWeightedFairScheduling) {
+    TestLogger Logger("StreamWeightedFairScheduling");
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_STREAM_WEIGHTED_FAIR_SCHEDULING));
+    } else {
+        QuicTestStreamWeightedFairScheduling();
+    }
+}
+
+TEST(Misc, StreamSendMultiProducer) {
+    TestLogger Logger("StreamSendMultiProducer");
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_STREAM_SEND_MULTI_PRODUCER));
+    } else {
+        QuicTestStreamSendMultiProducer();
+    }
+}
+
 TEST(Misc, StreamPriorityInfiniteLoop) {
     TestLogger Logger("StreamPriorityInfiniteLoop");
     if (TestingKernelMode) {
@@ -2345,6 +2390,24 @@ TEST(Misc, StreamAppProvidedBuffersOutOfSpace) {
         QuicTestStreamAppProvidedBuffersOutOfSpace();
     }
 }
+
+TEST_P(WithFamilyArgs, RecvWindowAutoTune) {
+    TestLoggerT<ParamType> Logger("QuicTestRecvWindowAutoTune", GetParam());
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_RECV_WINDOW_AUTO_TUNE, GetParam().Family));
+    } else {
+        QuicTestRecvWindowAutoTune(GetParam().Family);
+    }
+}
+
+TEST_P(WithFamilyArgs, SendBufferLatencyTarget) {
+    TestLoggerT<ParamType> Logger("QuicTestSendBufferLatencyTarget", GetParam());
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_SEND_BUFFER_LATENCY_TARGET, GetParam().Family));
+    } else {
+        QuicTestSendBufferLatencyTarget(GetParam().Family);
+    }
+}
 #endif // QUIC_API_ENABLE_PREVIEW_FEATURES
 
 TEST(Misc, StreamBlockUnblockUnidiConnFlowControl) {
@@ -2471,6 +2534,15 @@ TEST_P(WithFamilyArgs, DatagramDrop) {
     }
 }
 
+TEST_P(WithFamilyArgs, DatagramSendBatch) {
+    TestLoggerT<ParamType> Logger("QuicTestDatagramSendBatch", GetParam());
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_DATAGRAM_SEND_BATCH, GetParam().Family));
+    } else {
+        QuicTestDatagramSendBatch(GetParam().Family);
+    }
+}
+
 #ifdef _WIN32 // Storage tests only supported on Windows
 
 static BOOLEAN CanRunStorageTests = FALSE;
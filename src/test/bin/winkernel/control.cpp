@@ -533,6 +533,14 @@ size_t QUIC_IOCTL_BUFFER_SIZES[] =
     sizeof(QUIC_RUN_CONNECTION_POOL_CREATE_PARAMS),
     0,
     0,
+    0,
+    sizeof(INT32),
+    sizeof(INT32),
+    sizeof(INT32),
+    0,
+    0,
+    sizeof(INT32),
+    sizeof(INT32),
 };
 
 CXPLAT_STATIC_ASSERT(
@@ -1519,6 +1527,16 @@ QuicTestCtlEvtIoDeviceControl(
         QuicTestCtlRun(QuicTestStreamAppProvidedBuffersOutOfSpace());
         break;
 
+    case IOCTL_QUIC_RUN_RECV_WINDOW_AUTO_TUNE:
+        CXPLAT_FRE_ASSERT(Params != nullptr);
+        QuicTestCtlRun(QuicTestRecvWindowAutoTune(Params->Family));
+        break;
+
+    case IOCTL_QUIC_RUN_SEND_BUFFER_LATENCY_TARGET:
+        CXPLAT_FRE_ASSERT(Params != nullptr);
+        QuicTestCtlRun(QuicTestSendBufferLatencyTarget(Params->Family));
+        break;
+
     case IOCTL_QUIC_RUN_CONNECTION_POOL_CREATE:
         CXPLAT_FRE_ASSERT(Params != nullptr);
         QuicTestCtlRun(
@@ -1532,6 +1550,10 @@ QuicTestCtlEvtIoDeviceControl(
     case IOCTL_QUIC_RUN_VALIDATE_CONNECTION_POOL_CREATE:
         QuicTestCtlRun(QuicTestValidateConnectionPoolCreate());
         break;
+
+    case IOCTL_QUIC_RUN_VALIDATE_CONTENT:
+        QuicTestCtlRun(QuicTestValidateContent());
+        break;
 #endif
 
     case IOCTL_QUIC_RUN_TEST_KEY_UPDATE_DURING_HANDSHAKE:
@@ -1548,6 +1570,29 @@ QuicTestCtlEvtIoDeviceControl(
         QuicTestCtlRun(QuicTestRetryConfigSetting());
         break;
 
+    case IOCTL_QUIC_RUN_STREAM_WEIGHTED_FAIR_SCHEDULING:
+        QuicTestCtlRun(QuicTestStreamWeightedFairScheduling());
+        break;
+
+    case IOCTL_QUIC_RUN_STREAM_SEND_MULTI_PRODUCER:
+        QuicTestCtlRun(QuicTestStreamSendMultiProducer());
+        break;
+
+    case IOCTL_QUIC_RUN_MULTIPATH_SCHEDULING:
+        CXPLAT_FRE_ASSERT(Params != nullptr);
+        QuicTestCtlRun(QuicTestMultipathScheduling(Params->Family));
+        break;
+
+    case IOCTL_QUIC_RUN_MTU_BLACK_HOLE:
+        CXPLAT_FRE_ASSERT(Params != nullptr);
+        QuicTestCtlRun(QuicTestMtuBlackHole(Params->Family));
+        break;
+
+    case IOCTL_QUIC_RUN_DATAGRAM_SEND_BATCH:
+        CXPLAT_FRE_ASSERT(Params != nullptr);
+        QuicTestCtlRun(QuicTestDatagramSendBatch(Params->Family));
+        break;
+
     default:
         Status = STATUS_NOT_IMPLEMENTED;
         break;
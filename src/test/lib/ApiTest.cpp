@@ -2990,6 +2990,36 @@ void QuicTestGlobalParam()
         TEST_TRUE(Length >= sizeof(Expected));
     }
 
+    //
+    // QUIC_PARAM_GLOBAL_BUFFER_MEMORY_LIMIT
+    //
+    {
+        TestScopeLogger LogScope0("QUIC_PARAM_GLOBAL_BUFFER_MEMORY_LIMIT");
+        GlobalSettingScope ParamScope(QUIC_PARAM_GLOBAL_BUFFER_MEMORY_LIMIT);
+        uint64_t Limit = 64 * 1024 * 1024;
+        {
+            TestScopeLogger LogScope1("SetParam");
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                MsQuic->SetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_BUFFER_MEMORY_LIMIT,
+                    sizeof(uint32_t),
+                    &Limit));
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->SetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_BUFFER_MEMORY_LIMIT,
+                    sizeof(Limit),
+                    &Limit));
+        }
+
+        {
+            TestScopeLogger LogScope1("GetParam");
+            SimpleGetParamTest(nullptr, QUIC_PARAM_GLOBAL_BUFFER_MEMORY_LIMIT, sizeof(Limit), &Limit);
+        }
+    }
+
     QuicTestStatefulGlobalSetParam();
 }
 
@@ -3077,20 +3107,71 @@ void QuicTestRegistrationParam()
 {
     MsQuicRegistration Registration;
     TEST_TRUE(Registration.IsValid());
+
     //
-    // No parameter for Registration
+    // QUIC_PARAM_REGISTRATION_MEMORY_USAGE
     //
     {
-        uint32_t Dummy = 0;
+        TestScopeLogger LogScope("QUIC_PARAM_REGISTRATION_MEMORY_USAGE is get only");
+        uint64_t Dummy = 0;
         TEST_QUIC_STATUS(
             QUIC_STATUS_INVALID_PARAMETER,
             MsQuic->SetParam(
                 Registration.Handle,
-                QUIC_PARAM_PREFIX_REGISTRATION,
+                QUIC_PARAM_REGISTRATION_MEMORY_USAGE,
                 sizeof(Dummy),
                 &Dummy));
     }
 
+    {
+        TestScopeLogger LogScope("QUIC_PARAM_REGISTRATION_MEMORY_USAGE");
+        uint32_t Length = 0;
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_BUFFER_TOO_SMALL,
+            MsQuic->GetParam(
+                Registration.Handle,
+                QUIC_PARAM_REGISTRATION_MEMORY_USAGE,
+                &Length,
+                nullptr));
+        TEST_EQUAL(Length, sizeof(uint64_t));
+
+        //
+        // No connections have been opened, so nothing is charged yet.
+        //
+        uint64_t MemoryUsage = UINT64_MAX;
+        TEST_QUIC_SUCCEEDED(
+            MsQuic->GetParam(
+                Registration.Handle,
+                QUIC_PARAM_REGISTRATION_MEMORY_USAGE,
+                &Length,
+                &MemoryUsage));
+        TEST_EQUAL(MemoryUsage, 0);
+
+        {
+            MsQuicConnection Connection(Registration);
+            TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->GetParam(
+                    Registration.Handle,
+                    QUIC_PARAM_REGISTRATION_MEMORY_USAGE,
+                    &Length,
+                    &MemoryUsage));
+            TEST_NOT_EQUAL(MemoryUsage, 0);
+        }
+
+        //
+        // Closing the handle unregisters the connection, which takes all of
+        // its usage off the registration.
+        //
+        TEST_QUIC_SUCCEEDED(
+            MsQuic->GetParam(
+                Registration.Handle,
+                QUIC_PARAM_REGISTRATION_MEMORY_USAGE,
+                &Length,
+                &MemoryUsage));
+        TEST_EQUAL(MemoryUsage, 0);
+    }
+
     {
         uint32_t Length = 65535;
         uint32_t Buffer = 65535;
@@ -3098,7 +3179,7 @@ void QuicTestRegistrationParam()
             QUIC_STATUS_INVALID_PARAMETER,
             MsQuic->GetParam(
                 Registration.Handle,
-                QUIC_PARAM_PREFIX_REGISTRATION,
+                QUIC_PARAM_PREFIX_REGISTRATION | 0x1,
                 &Length,
                 &Buffer));
         TEST_EQUAL(Length, 65535);
@@ -6636,6 +6717,146 @@ QuicTestValidateConnectionPoolCreate()
                 ConnectionPool));
     }
 }
+
+static
+_Function_class_(QUIC_CONTENT_RELEASE_CALLBACK)
+void
+QUIC_API
+ContentReleased(
+    _In_opt_ void* Context
+    )
+{
+    CxPlatEventSet(*(CXPLAT_EVENT*)Context);
+}
+
+void
+QuicTestValidateContent()
+{
+    MsQuicRegistration Registration;
+    TEST_TRUE(Registration.IsValid());
+
+    uint8_t Payload[1000] = {0};
+    const QUIC_BUFFER Buffer = { sizeof(Payload), Payload };
+
+    CxPlatEvent ReleaseEvent;
+
+    {
+        TestScopeLogger logScope("Null buffer");
+        HQUIC Content;
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            MsQuic->ContentOpen(nullptr, nullptr, nullptr, &Content));
+    }
+
+    {
+        TestScopeLogger logScope("Null output");
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            MsQuic->ContentOpen(&Buffer, nullptr, nullptr, nullptr));
+    }
+
+    HQUIC Content = nullptr;
+    TEST_QUIC_SUCCEEDED(
+        MsQuic->ContentOpen(&Buffer, ContentReleased, &ReleaseEvent.Handle, &Content));
+
+    {
+        ConnectionScope Connection;
+        TEST_QUIC_SUCCEEDED(
+            MsQuic->ConnectionOpen(
+                Registration,
+                DummyConnectionCallback,
+                nullptr,
+                &Connection.Handle));
+
+        StreamScope Stream;
+        TEST_QUIC_SUCCEEDED(
+            MsQuic->StreamOpen(
+                Connection.Handle,
+                QUIC_STREAM_OPEN_FLAG_NONE,
+                DummyStreamCallback,
+                nullptr,
+                &Stream.Handle));
+
+        {
+            TestScopeLogger logScope("Not a content handle");
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                MsQuic->StreamSendContent(
+                    Stream.Handle,
+                    Connection.Handle,
+                    0,
+                    sizeof(Payload),
+                    QUIC_SEND_FLAG_NONE,
+                    nullptr));
+        }
+
+        {
+            TestScopeLogger logScope("Not a stream handle");
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                MsQuic->StreamSendContent(
+                    Connection.Handle,
+                    Content,
+                    0,
+                    sizeof(Payload),
+                    QUIC_SEND_FLAG_NONE,
+                    nullptr));
+        }
+
+        {
+            TestScopeLogger logScope("Range past the end");
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                MsQuic->StreamSendContent(
+                    Stream.Handle,
+                    Content,
+                    1,
+                    sizeof(Payload),
+                    QUIC_SEND_FLAG_NONE,
+                    nullptr));
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                MsQuic->StreamSendContent(
+                    Stream.Handle,
+                    Content,
+                    UINT64_MAX,
+                    1,
+                    QUIC_SEND_FLAG_NONE,
+                    nullptr));
+        }
+
+        {
+            TestScopeLogger logScope("Queued sends keep the content alive");
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_PENDING,
+                MsQuic->StreamSendContent(
+                    Stream.Handle,
+                    Content,
+                    0,
+                    sizeof(Payload) / 2,
+                    QUIC_SEND_FLAG_NONE,
+                    nullptr));
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_PENDING,
+                MsQuic->StreamSendContent(
+                    Stream.Handle,
+                    Content,
+                    sizeof(Payload) / 2,
+                    sizeof(Payload) / 2,
+                    QUIC_SEND_FLAG_FIN,
+                    nullptr));
+
+            MsQuic->ContentClose(Content);
+            TEST_FALSE(ReleaseEvent.WaitTimeout(100));
+        }
+    }
+
+    //
+    // Closing the connection cancels the sends, which drops the last
+    // references on the content.
+    //
+    TEST_TRUE(ReleaseEvent.WaitTimeout(TestWaitTimeout));
+}
 #endif // QUIC_API_ENABLE_PREVIEW_FEATURES
 
 void
@@ -3093,6 +3093,313 @@ QuicTestStreamPriority(
     TEST_TRUE(Context.ReceiveEvents[2] == Stream1.ID());
 }
 
+struct StreamShareTestContext {
+    static const uint32_t Window = 0x80000;
+    uint64_t TotalBytes {0};
+    uint64_t StreamBytes[2] {}; // Indexed by stream ID >> 2.
+    CxPlatEvent WindowComplete;
+
+    static QUIC_STATUS StreamCallback(_In_ MsQuicStream* Stream, _In_opt_ void* Context, _Inout_ QUIC_STREAM_EVENT* Event) {
+        auto TestContext = (StreamShareTestContext*)Context;
+        if (Event->Type == QUIC_STREAM_EVENT_RECEIVE && TestContext->TotalBytes < Window) {
+            QUIC_UINT62 Id;
+            Stream->GetID(&Id);
+            if ((Id >> 2) >= ARRAYSIZE(StreamBytes)) {
+                TEST_FAILURE("Unexpected stream %llu", (unsigned long long)Id);
+                return QUIC_STATUS_SUCCESS;
+            }
+            TestContext->StreamBytes[Id >> 2] += Event->RECEIVE.TotalBufferLength;
+            TestContext->TotalBytes += Event->RECEIVE.TotalBufferLength;
+            if (TestContext->TotalBytes >= Window) {
+                TestContext->WindowComplete.Set();
+            }
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    static QUIC_STATUS ConnCallback(_In_ MsQuicConnection*, _In_opt_ void* Context, _Inout_ QUIC_CONNECTION_EVENT* Event) {
+        if (Event->Type == QUIC_CONNECTION_EVENT_PEER_STREAM_STARTED) {
+            new(std::nothrow) MsQuicStream(Event->PEER_STREAM_STARTED.Stream, CleanUpAutoDelete, StreamCallback, Context);
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+};
+
+void
+QuicTestStreamWeightedFairScheduling(
+    )
+{
+    MsQuicRegistration Registration(true);
+    TEST_QUIC_SUCCEEDED(Registration.GetInitStatus());
+
+    MsQuicConfiguration ServerConfiguration(Registration, "MsQuicTest", MsQuicSettings().SetPeerUnidiStreamCount(3), ServerSelfSignedCredConfig);
+    TEST_QUIC_SUCCEEDED(ServerConfiguration.GetInitStatus());
+
+    MsQuicConfiguration ClientConfiguration(Registration, "MsQuicTest", MsQuicCredentialConfig());
+    TEST_QUIC_SUCCEEDED(ClientConfiguration.GetInitStatus());
+
+    StreamPriorityTestContext Context;
+    MsQuicAutoAcceptListener Listener(Registration, ServerConfiguration, StreamPriorityTestContext::ConnCallback, &Context);
+    TEST_QUIC_SUCCEEDED(Listener.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Listener.Start("MsQuicTest"));
+    QuicAddr ServerLocalAddr;
+    TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+
+    uint8_t RawBuffer[100];
+    QUIC_BUFFER Buffer { sizeof(RawBuffer), RawBuffer };
+
+    QUIC_STREAM_SCHEDULING_SCHEME Value = QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR;
+    TEST_QUIC_SUCCEEDED(Connection.SetParam(QUIC_PARAM_CONN_STREAM_SCHEDULING_SCHEME, sizeof(Value), &Value));
+
+    //
+    // Streams with a deadline go first, earliest deadline first, regardless
+    // of the order they were queued in.
+    //
+    MsQuicStream Stream1(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL);
+    TEST_QUIC_SUCCEEDED(Stream1.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Stream1.SetPriority(0xFFFF));
+    TEST_QUIC_SUCCEEDED(Stream1.Send(&Buffer, 1, QUIC_SEND_FLAG_START | QUIC_SEND_FLAG_FIN));
+
+    MsQuicStream Stream2(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL);
+    TEST_QUIC_SUCCEEDED(Stream2.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Stream2.Send(&Buffer, 1, QUIC_SEND_FLAG_START | QUIC_SEND_FLAG_FIN));
+    TEST_QUIC_SUCCEEDED(Stream2.SetSendDeadline(S_TO_US(20)));
+
+    MsQuicStream Stream3(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL);
+    TEST_QUIC_SUCCEEDED(Stream3.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Stream3.SetPriority(0));
+    TEST_QUIC_SUCCEEDED(Stream3.Send(&Buffer, 1, QUIC_SEND_FLAG_START | QUIC_SEND_FLAG_FIN));
+    TEST_QUIC_SUCCEEDED(Stream3.SetSendDeadline(S_TO_US(10)));
+
+    uint64_t InvalidDeadline = UINT64_MAX;
+    TEST_QUIC_STATUS(
+        QUIC_STATUS_INVALID_PARAMETER,
+        MsQuic->SetParam(Stream1.Handle, QUIC_PARAM_STREAM_SEND_DEADLINE, sizeof(InvalidDeadline), &InvalidDeadline));
+
+    QUIC_STREAM_SCHEDULING_SCHEME Scheme = QUIC_STREAM_SCHEDULING_SCHEME_FIFO;
+    uint32_t SchemeLength = sizeof(Scheme);
+    TEST_QUIC_SUCCEEDED(Connection.GetParam(QUIC_PARAM_CONN_STREAM_SCHEDULING_SCHEME, &SchemeLength, &Scheme));
+    TEST_EQUAL(Scheme, QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR);
+
+    TEST_QUIC_SUCCEEDED(Connection.Start(ClientConfiguration, ServerLocalAddr.GetFamily(), QUIC_TEST_LOOPBACK_FOR_AF(ServerLocalAddr.GetFamily()), ServerLocalAddr.GetPort()));
+    TEST_TRUE(Connection.HandshakeCompleteEvent.WaitTimeout(TestWaitTimeout));
+    TEST_TRUE(Connection.HandshakeComplete);
+
+    TEST_TRUE(Context.AllReceivesComplete.WaitTimeout(TestWaitTimeout));
+    TEST_TRUE(Context.ReceiveEvents[0] == Stream3.ID());
+    TEST_TRUE(Context.ReceiveEvents[1] == Stream2.ID());
+    TEST_TRUE(Context.ReceiveEvents[2] == Stream1.ID());
+
+    //
+    // Two backlogged streams with weights 1 and 3 (priorities 0 and 2) share
+    // the first bytes of the connection 1:3. Flow control is opened up so
+    // only the scheduler decides who sends.
+    //
+    MsQuicConfiguration ShareServerConfiguration(
+        Registration,
+        "MsQuicTest",
+        MsQuicSettings()
+            .SetPeerUnidiStreamCount(2)
+            .SetStreamRecvWindowDefault(0x400000)
+            .SetConnFlowControlWindow(0x1000000),
+        ServerSelfSignedCredConfig);
+    TEST_QUIC_SUCCEEDED(ShareServerConfiguration.GetInitStatus());
+
+    StreamShareTestContext ShareContext;
+    MsQuicAutoAcceptListener ShareListener(Registration, ShareServerConfiguration, StreamShareTestContext::ConnCallback, &ShareContext);
+    TEST_QUIC_SUCCEEDED(ShareListener.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(ShareListener.Start("MsQuicTest"));
+    TEST_QUIC_SUCCEEDED(ShareListener.GetLocalAddr(ServerLocalAddr));
+
+    MsQuicConnection ShareConnection(Registration);
+    TEST_QUIC_SUCCEEDED(ShareConnection.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(ShareConnection.SetParam(QUIC_PARAM_CONN_STREAM_SCHEDULING_SCHEME, sizeof(Value), &Value));
+
+    const uint32_t ShareBufferLength = 0x100000;
+    UniquePtr<uint8_t[]> ShareRawBuffer(new(std::nothrow) uint8_t[ShareBufferLength]);
+    TEST_NOT_EQUAL(nullptr, ShareRawBuffer.get());
+    CxPlatZeroMemory(ShareRawBuffer.get(), ShareBufferLength);
+    QUIC_BUFFER ShareBuffer { ShareBufferLength, ShareRawBuffer.get() };
+
+    MsQuicStream LightStream(ShareConnection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL);
+    TEST_QUIC_SUCCEEDED(LightStream.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(LightStream.SetPriority(0));
+    TEST_QUIC_SUCCEEDED(LightStream.Send(&ShareBuffer, 1, QUIC_SEND_FLAG_START | QUIC_SEND_FLAG_FIN));
+
+    MsQuicStream HeavyStream(ShareConnection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL);
+    TEST_QUIC_SUCCEEDED(HeavyStream.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(HeavyStream.SetPriority(2));
+    TEST_QUIC_SUCCEEDED(HeavyStream.Send(&ShareBuffer, 1, QUIC_SEND_FLAG_START | QUIC_SEND_FLAG_FIN));
+
+    TEST_QUIC_SUCCEEDED(ShareConnection.Start(ClientConfiguration, ServerLocalAddr.GetFamily(), QUIC_TEST_LOOPBACK_FOR_AF(ServerLocalAddr.GetFamily()), ServerLocalAddr.GetPort()));
+    TEST_TRUE(ShareConnection.HandshakeCompleteEvent.WaitTimeout(TestWaitTimeout));
+    TEST_TRUE(ShareConnection.HandshakeComplete);
+
+    TEST_TRUE(ShareContext.WindowComplete.WaitTimeout(TestWaitTimeout));
+    const uint64_t HeavyPercent =
+        (ShareContext.StreamBytes[HeavyStream.ID() >> 2] * 100) / ShareContext.TotalBytes;
+    if (HeavyPercent < 65 || HeavyPercent > 85) {
+        TEST_FAILURE(
+            "Heavy stream got %llu%% of the first %llu bytes, expected ~75%%",
+            (unsigned long long)HeavyPercent,
+            (unsigned long long)ShareContext.TotalBytes);
+    }
+}
+
+#define MULTI_PRODUCER_THREADS  8
+#define MULTI_PRODUCER_MESSAGES 200
+
+struct MultiProducerMessage {
+    uint32_t Thread;
+    uint32_t Sequence;
+};
+
+struct MultiProducerSendTestContext {
+    MsQuicStream* Stream {nullptr};
+    MultiProducerMessage Messages[MULTI_PRODUCER_THREADS][MULTI_PRODUCER_MESSAGES];
+    QUIC_BUFFER Buffers[MULTI_PRODUCER_THREADS][MULTI_PRODUCER_MESSAGES];
+    uint32_t NextThread {0};
+    uint32_t SendFailures {0};
+
+    //
+    // Receiver state.
+    //
+    uint8_t Partial[sizeof(MultiProducerMessage)];
+    uint32_t PartialLength {0};
+    uint32_t NextSequence[MULTI_PRODUCER_THREADS] {};
+    uint32_t ReceivedMessages {0};
+    bool OutOfOrder {false};
+    CxPlatEvent ReceiveComplete;
+
+    void OnMessage(const MultiProducerMessage* Message) {
+        if (Message->Thread >= MULTI_PRODUCER_THREADS ||
+            Message->Sequence != NextSequence[Message->Thread]) {
+            OutOfOrder = true;
+        } else {
+            NextSequence[Message->Thread]++;
+        }
+        ReceivedMessages++;
+    }
+
+    static QUIC_STATUS StreamCallback(_In_ MsQuicStream*, _In_opt_ void* Context, _Inout_ QUIC_STREAM_EVENT* Event) {
+        auto TestContext = (MultiProducerSendTestContext*)Context;
+        if (Event->Type == QUIC_STREAM_EVENT_RECEIVE) {
+            for (uint32_t i = 0; i < Event->RECEIVE.BufferCount; ++i) {
+                const uint8_t* Data = Event->RECEIVE.Buffers[i].Buffer;
+                uint32_t Length = Event->RECEIVE.Buffers[i].Length;
+                while (Length != 0) {
+                    uint32_t Copy = CXPLAT_MIN(Length, sizeof(MultiProducerMessage) - TestContext->PartialLength);
+                    CxPlatCopyMemory(TestContext->Partial + TestContext->PartialLength, Data, Copy);
+                    TestContext->PartialLength += Copy;
+                    Data += Copy;
+                    Length -= Copy;
+                    if (TestContext->PartialLength == sizeof(MultiProducerMessage)) {
+                        MultiProducerMessage Message;
+                        CxPlatCopyMemory(&Message, TestContext->Partial, sizeof(Message));
+                        TestContext->OnMessage(&Message);
+                        TestContext->PartialLength = 0;
+                    }
+                }
+            }
+        } else if (Event->Type == QUIC_STREAM_EVENT_PEER_SEND_SHUTDOWN) {
+            TestContext->ReceiveComplete.Set();
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    static QUIC_STATUS ConnCallback(_In_ MsQuicConnection*, _In_opt_ void* Context, _Inout_ QUIC_CONNECTION_EVENT* Event) {
+        if (Event->Type == QUIC_CONNECTION_EVENT_PEER_STREAM_STARTED) {
+            new(std::nothrow) MsQuicStream(Event->PEER_STREAM_STARTED.Stream, CleanUpAutoDelete, StreamCallback, Context);
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    static CXPLAT_THREAD_CALLBACK(ProducerThread, Context) {
+        auto TestContext = (MultiProducerSendTestContext*)Context;
+        const uint32_t Thread = (uint32_t)InterlockedIncrement((long*)&TestContext->NextThread) - 1;
+        for (uint32_t i = 0; i < MULTI_PRODUCER_MESSAGES; ++i) {
+            if (QUIC_FAILED(TestContext->Stream->Send(&TestContext->Buffers[Thread][i]))) {
+                InterlockedIncrement((long*)&TestContext->SendFailures);
+            }
+        }
+        CXPLAT_THREAD_RETURN(0);
+    }
+};
+
+void
+QuicTestStreamSendMultiProducer(
+    )
+{
+    MsQuicRegistration Registration(true);
+    TEST_QUIC_SUCCEEDED(Registration.GetInitStatus());
+
+    MsQuicConfiguration ServerConfiguration(Registration, "MsQuicTest", MsQuicSettings().SetPeerUnidiStreamCount(1), ServerSelfSignedCredConfig);
+    TEST_QUIC_SUCCEEDED(ServerConfiguration.GetInitStatus());
+
+    MsQuicConfiguration ClientConfiguration(Registration, "MsQuicTest", MsQuicCredentialConfig());
+    TEST_QUIC_SUCCEEDED(ClientConfiguration.GetInitStatus());
+
+    UniquePtr<MultiProducerSendTestContext> Context(new(std::nothrow) MultiProducerSendTestContext);
+    TEST_NOT_EQUAL(nullptr, Context);
+    for (uint32_t t = 0; t < MULTI_PRODUCER_THREADS; ++t) {
+        for (uint32_t i = 0; i < MULTI_PRODUCER_MESSAGES; ++i) {
+            Context->Messages[t][i].Thread = t;
+            Context->Messages[t][i].Sequence = i;
+            Context->Buffers[t][i].Buffer = (uint8_t*)&Context->Messages[t][i];
+            Context->Buffers[t][i].Length = sizeof(MultiProducerMessage);
+        }
+    }
+
+    MsQuicAutoAcceptListener Listener(Registration, ServerConfiguration, MultiProducerSendTestContext::ConnCallback, Context.get());
+    TEST_QUIC_SUCCEEDED(Listener.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Listener.Start("MsQuicTest"));
+    QuicAddr ServerLocalAddr;
+    TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Connection.Start(ClientConfiguration, ServerLocalAddr.GetFamily(), QUIC_TEST_LOOPBACK_FOR_AF(ServerLocalAddr.GetFamily()), ServerLocalAddr.GetPort()));
+    TEST_TRUE(Connection.HandshakeCompleteEvent.WaitTimeout(TestWaitTimeout));
+    TEST_TRUE(Connection.HandshakeComplete);
+
+    MsQuicStream Stream(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL);
+    TEST_QUIC_SUCCEEDED(Stream.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Stream.Start(QUIC_STREAM_START_FLAG_IMMEDIATE));
+    Context->Stream = &Stream;
+
+    //
+    // Have several app threads send on the same stream at once. Each thread's
+    // messages must still arrive in the order that thread sent them.
+    //
+    CXPLAT_THREAD_CONFIG Config = {
+        0,
+        0,
+        "MultiProducer",
+        MultiProducerSendTestContext::ProducerThread,
+        Context.get()
+    };
+    CXPLAT_THREAD Threads[MULTI_PRODUCER_THREADS];
+    CxPlatZeroMemory(&Threads, sizeof(Threads));
+    for (uint32_t i = 0; i < MULTI_PRODUCER_THREADS; ++i) {
+        TEST_QUIC_SUCCEEDED(CxPlatThreadCreate(&Config, &Threads[i]));
+    }
+    for (uint32_t i = 0; i < MULTI_PRODUCER_THREADS; ++i) {
+        CxPlatThreadWait(&Threads[i]);
+        CxPlatThreadDelete(&Threads[i]);
+    }
+    TEST_EQUAL(0, Context->SendFailures);
+
+    TEST_QUIC_SUCCEEDED(Stream.Send(nullptr, 0, QUIC_SEND_FLAG_FIN));
+    TEST_TRUE(Context->ReceiveComplete.WaitTimeout(TestWaitTimeout));
+
+    TEST_EQUAL(MULTI_PRODUCER_THREADS * MULTI_PRODUCER_MESSAGES, Context->ReceivedMessages);
+    TEST_FALSE(Context->OutOfOrder);
+    TEST_EQUAL(0, Context->PartialLength);
+}
+
 void
 QuicTestStreamPriorityInfiniteLoop(
     )
@@ -4968,4 +5275,184 @@ QuicTestStreamAppProvidedBuffersOutOfSpace(
     }
 }
 
+
+struct RecvWindowAutoTuneContext {
+    CxPlatEvent ServerStreamShutdown;
+    MsQuicConnection* ServerConnection {nullptr};
+    uint64_t ServerBytesReceived {0};
+    QUIC_STATISTICS_V2 ServerStats {};
+
+    static QUIC_STATUS StreamCallback(_In_ MsQuicStream*, _In_opt_ void* Context, _Inout_ QUIC_STREAM_EVENT* Event) {
+        auto TestContext = (RecvWindowAutoTuneContext*)Context;
+        if (Event->Type == QUIC_STREAM_EVENT_RECEIVE) {
+            TestContext->ServerBytesReceived += Event->RECEIVE.TotalBufferLength;
+        } else if (Event->Type == QUIC_STREAM_EVENT_SHUTDOWN_COMPLETE) {
+            //
+            // Snapshot the receive window while the connection is still alive.
+            //
+            TestContext->ServerConnection->GetStatistics(&TestContext->ServerStats);
+            TestContext->ServerStreamShutdown.Set();
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    static QUIC_STATUS ConnCallback(_In_ MsQuicConnection* Connection, _In_opt_ void* Context, _Inout_ QUIC_CONNECTION_EVENT* Event) {
+        auto TestContext = (RecvWindowAutoTuneContext*)Context;
+        if (Event->Type == QUIC_CONNECTION_EVENT_PEER_STREAM_STARTED) {
+            TestContext->ServerConnection = Connection;
+            new(std::nothrow) MsQuicStream(Event->PEER_STREAM_STARTED.Stream, CleanUpAutoDelete, StreamCallback, Context);
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+};
+
+void
+QuicTestRecvWindowAutoTune(
+    _In_ int Family
+    )
+{
+    const uint32_t ConnFlowControlWindow = 0x8000;
+    const uint32_t SendLength = 0x400000;
+    QUIC_ADDRESS_FAMILY QuicAddrFamily = (Family == 4) ? QUIC_ADDRESS_FAMILY_INET : QUIC_ADDRESS_FAMILY_INET6;
+
+    UniquePtr<uint8_t[]> SendDataBuffer{new(std::nothrow) uint8_t[SendLength]};
+    TEST_NOT_EQUAL(nullptr, SendDataBuffer);
+    CxPlatZeroMemory(SendDataBuffer.get(), SendLength);
+
+    for (uint32_t AutoTune = 0; AutoTune < 2; ++AutoTune) {
+        TestScopeLogger LogScope(AutoTune ? "Auto-tune enabled" : "Auto-tune disabled");
+        MsQuicRegistration Registration(true);
+        TEST_QUIC_SUCCEEDED(Registration.GetInitStatus());
+
+        MsQuicSettings ServerSettings;
+        ServerSettings.SetPeerUnidiStreamCount(1).SetConnFlowControlWindow(ConnFlowControlWindow);
+        if (AutoTune) {
+            ServerSettings.SetRecvWindowAutoTuneEnabled(true);
+        }
+        MsQuicConfiguration ServerConfiguration(Registration, "MsQuicTest", ServerSettings, ServerSelfSignedCredConfig);
+        TEST_QUIC_SUCCEEDED(ServerConfiguration.GetInitStatus());
+
+        MsQuicConfiguration ClientConfiguration(Registration, "MsQuicTest", MsQuicCredentialConfig());
+        TEST_QUIC_SUCCEEDED(ClientConfiguration.GetInitStatus());
+
+        RecvWindowAutoTuneContext Context;
+        MsQuicAutoAcceptListener Listener(Registration, ServerConfiguration, RecvWindowAutoTuneContext::ConnCallback, &Context);
+        TEST_QUIC_SUCCEEDED(Listener.GetInitStatus());
+        TEST_QUIC_SUCCEEDED(Listener.Start("MsQuicTest"));
+        QuicAddr ServerLocalAddr;
+        TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        TEST_QUIC_SUCCEEDED(Connection.Start(ClientConfiguration, QuicAddrFamily, QUIC_TEST_LOOPBACK_FOR_AF(QuicAddrFamily), ServerLocalAddr.GetPort()));
+        TEST_TRUE(Connection.HandshakeCompleteEvent.WaitTimeout(TestWaitTimeout));
+        TEST_TRUE(Connection.HandshakeComplete);
+
+        MsQuicStream Stream(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL);
+        TEST_QUIC_SUCCEEDED(Stream.GetInitStatus());
+
+        QUIC_BUFFER Buffer { SendLength, SendDataBuffer.get() };
+        TEST_QUIC_SUCCEEDED(Stream.Send(&Buffer, 1, QUIC_SEND_FLAG_START | QUIC_SEND_FLAG_FIN));
+        TEST_TRUE(Context.ServerStreamShutdown.WaitTimeout(TestWaitTimeout));
+        TEST_EQUAL(Context.ServerBytesReceived, SendLength);
+
+        if (AutoTune) {
+            //
+            // The transfer is limited by the small initial window, so the
+            // measured BDP must have grown the window past it.
+            //
+            TEST_TRUE(Context.ServerStats.RecvConnFlowControlWindow > ConnFlowControlWindow);
+        } else {
+            TEST_EQUAL(Context.ServerStats.RecvConnFlowControlWindow, ConnFlowControlWindow);
+        }
+    }
+}
+
+struct SendBufferLatencyTargetContext {
+    CxPlatEvent ClientStreamShutdown;
+    uint64_t IdealSendBufferSize {0};
+
+    static QUIC_STATUS ClientStreamCallback(_In_ MsQuicStream* Stream, _In_opt_ void* Context, _Inout_ QUIC_STREAM_EVENT* Event) {
+        auto TestContext = (SendBufferLatencyTargetContext*)Context;
+        if (Event->Type == QUIC_STREAM_EVENT_SEND_COMPLETE) {
+            //
+            // All data has been acknowledged, so the connection has sampled
+            // the pacing rate over many round trips by now.
+            //
+            (void)Stream->GetIdealSendBufferSize(&TestContext->IdealSendBufferSize);
+        } else if (Event->Type == QUIC_STREAM_EVENT_SHUTDOWN_COMPLETE) {
+            TestContext->ClientStreamShutdown.Set();
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    static QUIC_STATUS ServerStreamCallback(_In_ MsQuicStream*, _In_opt_ void*, _Inout_ QUIC_STREAM_EVENT*) {
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    static QUIC_STATUS ServerConnCallback(_In_ MsQuicConnection*, _In_opt_ void* Context, _Inout_ QUIC_CONNECTION_EVENT* Event) {
+        if (Event->Type == QUIC_CONNECTION_EVENT_PEER_STREAM_STARTED) {
+            new(std::nothrow) MsQuicStream(Event->PEER_STREAM_STARTED.Stream, CleanUpAutoDelete, ServerStreamCallback, Context);
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+};
+
+void
+QuicTestSendBufferLatencyTarget(
+    _In_ int Family
+    )
+{
+    const uint32_t SendLength = 0x200000;
+    const uint32_t LatencyTargetsMs[] = { 0, 1000 };
+    uint64_t IdealSendBufferSizes[ARRAYSIZE(LatencyTargetsMs)] = { 0 };
+    QUIC_ADDRESS_FAMILY QuicAddrFamily = (Family == 4) ? QUIC_ADDRESS_FAMILY_INET : QUIC_ADDRESS_FAMILY_INET6;
+
+    UniquePtr<uint8_t[]> SendDataBuffer{new(std::nothrow) uint8_t[SendLength]};
+    TEST_NOT_EQUAL(nullptr, SendDataBuffer);
+    CxPlatZeroMemory(SendDataBuffer.get(), SendLength);
+
+    for (uint32_t i = 0; i < ARRAYSIZE(LatencyTargetsMs); ++i) {
+        TestScopeLogger LogScope(i == 0 ? "Zero latency target" : "Large latency target");
+        MsQuicRegistration Registration(true);
+        TEST_QUIC_SUCCEEDED(Registration.GetInitStatus());
+
+        MsQuicConfiguration ServerConfiguration(Registration, "MsQuicTest", MsQuicSettings().SetPeerUnidiStreamCount(1), ServerSelfSignedCredConfig);
+        TEST_QUIC_SUCCEEDED(ServerConfiguration.GetInitStatus());
+
+        MsQuicSettings ClientSettings;
+        ClientSettings.SetSendBufferLatencyTargetMs(LatencyTargetsMs[i]);
+        MsQuicConfiguration ClientConfiguration(Registration, "MsQuicTest", ClientSettings, MsQuicCredentialConfig());
+        TEST_QUIC_SUCCEEDED(ClientConfiguration.GetInitStatus());
+
+        SendBufferLatencyTargetContext Context;
+        MsQuicAutoAcceptListener Listener(Registration, ServerConfiguration, SendBufferLatencyTargetContext::ServerConnCallback, &Context);
+        TEST_QUIC_SUCCEEDED(Listener.GetInitStatus());
+        TEST_QUIC_SUCCEEDED(Listener.Start("MsQuicTest"));
+        QuicAddr ServerLocalAddr;
+        TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        TEST_QUIC_SUCCEEDED(Connection.Start(ClientConfiguration, QuicAddrFamily, QUIC_TEST_LOOPBACK_FOR_AF(QuicAddrFamily), ServerLocalAddr.GetPort()));
+        TEST_TRUE(Connection.HandshakeCompleteEvent.WaitTimeout(TestWaitTimeout));
+        TEST_TRUE(Connection.HandshakeComplete);
+
+        MsQuicStream Stream(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL, CleanUpManual, SendBufferLatencyTargetContext::ClientStreamCallback, &Context);
+        TEST_QUIC_SUCCEEDED(Stream.GetInitStatus());
+
+        QUIC_BUFFER Buffer { SendLength, SendDataBuffer.get() };
+        TEST_QUIC_SUCCEEDED(Stream.Send(&Buffer, 1, QUIC_SEND_FLAG_START | QUIC_SEND_FLAG_FIN));
+        TEST_TRUE(Context.ClientStreamShutdown.WaitTimeout(TestWaitTimeout));
+        TEST_TRUE(Context.IdealSendBufferSize != 0);
+        IdealSendBufferSizes[i] = Context.IdealSendBufferSize;
+    }
+
+    //
+    // The ideal size covers the RTT plus the latency target at the pacing
+    // rate, so a longer target must yield a larger buffer.
+    //
+    TEST_TRUE(IdealSendBufferSizes[1] > IdealSendBufferSizes[0]);
+}
+
 #endif // QUIC_API_ENABLE_PREVIEW_FEATURES
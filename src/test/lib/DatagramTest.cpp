@@ -367,3 +367,183 @@ QuicTestDatagramDrop(
         }
     }
 }
+
+struct DatagramSentOrderContext {
+    uint8_t Priorities[20];
+    uint32_t Count {0};
+
+    static
+    _Function_class_(DATAGRAM_SENT_CALLBACK)
+    void
+    DatagramSent(
+        _In_ TestConnection* Connection,
+        _In_opt_ void* ClientContext
+        )
+    {
+        auto Ctx = (DatagramSentOrderContext*)Connection->Context;
+        auto Item = (const QUIC_DATAGRAM_SEND_ITEM*)ClientContext;
+        if (Item != nullptr && Ctx->Count < ARRAYSIZE(Ctx->Priorities)) {
+            Ctx->Priorities[Ctx->Count++] = Item->Priority;
+        }
+    }
+};
+
+void
+QuicTestDatagramSendBatch(
+    _In_ int Family
+    )
+{
+    MsQuicRegistration Registration;
+    TEST_TRUE(Registration.IsValid());
+
+    MsQuicAlpn Alpn("MsQuicTest");
+
+    MsQuicSettings Settings;
+    Settings.SetDatagramReceiveEnabled(true);
+
+    MsQuicCredentialConfig ClientCredConfig;
+    MsQuicConfiguration ClientConfiguration(Registration, Alpn, Settings, ClientCredConfig);
+    TEST_TRUE(ClientConfiguration.IsValid());
+
+    MsQuicConfiguration ServerConfiguration(Registration, Alpn, Settings, ServerSelfSignedCredConfig);
+    TEST_TRUE(ServerConfiguration.IsValid());
+
+    uint8_t RawBuffer[1100] = {0};
+
+    //
+    // Every other datagram gets a deadline that will have passed long before
+    // the handshake completes, so only those without one should be sent.
+    //
+    QUIC_DATAGRAM_SEND_ITEM Items[20];
+    for (uint32_t i = 0; i < ARRAYSIZE(Items); i++) {
+        Items[i].Buffer.Length = sizeof(RawBuffer);
+        Items[i].Buffer.Buffer = RawBuffer;
+        Items[i].DeadlineUs = (i % 2 == 0) ? 1 : 0;
+        Items[i].Priority = (uint8_t)i;
+        Items[i].ClientContext = &Items[i];
+    }
+    DatagramSentOrderContext SentOrder;
+
+    {
+        TestListener Listener(Registration, ListenerAcceptConnection, ServerConfiguration);
+        TEST_TRUE(Listener.IsValid());
+
+        QUIC_ADDRESS_FAMILY QuicAddrFamily = (Family == 4) ? QUIC_ADDRESS_FAMILY_INET : QUIC_ADDRESS_FAMILY_INET6;
+        QuicAddr ServerLocalAddr(QuicAddrFamily);
+        TEST_QUIC_SUCCEEDED(Listener.Start(Alpn, &ServerLocalAddr.SockAddr));
+        TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+        {
+            UniquePtr<TestConnection> Server;
+            ServerAcceptContext ServerAcceptCtx((TestConnection**)&Server);
+            Listener.Context = &ServerAcceptCtx;
+
+            {
+                TestConnection Client(Registration);
+                TEST_TRUE(Client.IsValid());
+
+                TEST_TRUE(Client.GetDatagramSendEnabled());
+                Client.Context = &SentOrder;
+                Client.SetDatagramSentCallback(DatagramSentOrderContext::DatagramSent);
+
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_INVALID_PARAMETER,
+                    MsQuic->DatagramSendBatch(
+                        Client.GetConnection(),
+                        Items,
+                        0,
+                        QUIC_SEND_FLAG_NONE));
+
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->DatagramSendBatch(
+                        Client.GetConnection(),
+                        Items,
+                        ARRAYSIZE(Items),
+                        QUIC_SEND_FLAG_NONE));
+
+                TEST_QUIC_SUCCEEDED(
+                    Client.Start(
+                        ClientConfiguration,
+                        QuicAddrFamily,
+                        QUIC_TEST_LOOPBACK_FOR_AF(QuicAddrFamily),
+                        ServerLocalAddr.GetPort()));
+
+                if (!Client.WaitForConnectionComplete()) {
+                    return;
+                }
+                TEST_TRUE(Client.GetIsConnected());
+
+                TEST_NOT_EQUAL(nullptr, Server);
+                if (!Server->WaitForConnectionComplete()) {
+                    return;
+                }
+                TEST_TRUE(Server->GetIsConnected());
+
+                uint32_t Tries = 0;
+                while (Client.GetDatagramsSent() + Client.GetDatagramsCanceled() != 20 && ++Tries < 10) {
+                    CxPlatSleep(100);
+                }
+
+                TEST_EQUAL(10, Client.GetDatagramsCanceled());
+                TEST_EQUAL(10, Client.GetDatagramsSent());
+
+                //
+                // The whole batch was queued before the handshake, so the
+                // surviving datagrams must go out highest priority first.
+                //
+                TEST_EQUAL(10, SentOrder.Count);
+                for (uint32_t i = 0; i < SentOrder.Count; i++) {
+                    TEST_EQUAL(19 - 2 * i, SentOrder.Priorities[i]);
+                }
+
+                //
+                // A datagram that is too long is canceled on its own, without
+                // failing the rest of the batch.
+                //
+                QUIC_DATAGRAM_SEND_ITEM MixedItems[2];
+                MixedItems[0] = Items[1];
+                MixedItems[1] = Items[3];
+                MixedItems[1].Buffer.Buffer = nullptr;
+
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_INVALID_PARAMETER,
+                    MsQuic->DatagramSendBatch(
+                        Client.GetConnection(),
+                        MixedItems,
+                        ARRAYSIZE(MixedItems),
+                        QUIC_SEND_FLAG_NONE));
+
+                MixedItems[1].Buffer.Buffer = RawBuffer;
+                MixedItems[1].Buffer.Length = UINT16_MAX + 1;
+
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->DatagramSendBatch(
+                        Client.GetConnection(),
+                        MixedItems,
+                        ARRAYSIZE(MixedItems),
+                        QUIC_SEND_FLAG_NONE));
+
+                Tries = 0;
+                while (Client.GetDatagramsSent() + Client.GetDatagramsCanceled() != 22 && ++Tries < 10) {
+                    CxPlatSleep(100);
+                }
+
+                TEST_EQUAL(11, Client.GetDatagramsCanceled());
+                TEST_EQUAL(11, Client.GetDatagramsSent());
+
+                QUIC_STATISTICS_V2 Stats = Client.GetStatistics();
+                TEST_EQUAL(10, Stats.SendDatagramsDroppedExpired);
+                TEST_EQUAL(0, Stats.SendDatagramsDroppedBlocked);
+                TEST_EQUAL(1, Stats.SendDatagramsDroppedTooLarge);
+
+                Client.Shutdown(QUIC_CONNECTION_SHUTDOWN_FLAG_NONE, QUIC_TEST_NO_ERROR);
+                if (!Client.WaitForShutdownComplete()) {
+                    return;
+                }
+
+                TEST_FALSE(Client.GetPeerClosed());
+                TEST_FALSE(Client.GetTransportClosed());
+            }
+        }
+    }
+}
@@ -4139,6 +4139,28 @@ struct ConnectionPoolConnectionContext {
 };
 
 #ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+struct ConnectionPoolCompleteContext {
+    CxPlatEvent CompleteEvent;
+    uint16_t ConnectedCount {0};
+    uint16_t FailedCount {0};
+
+    static
+    _Function_class_(QUIC_CONNECTION_POOL_COMPLETE_CALLBACK)
+    void
+    QUIC_API
+    PoolComplete(
+        _In_opt_ void* Context,
+        _In_ uint16_t ConnectedCount,
+        _In_ uint16_t FailedCount
+        )
+    {
+        auto This = (ConnectionPoolCompleteContext*)Context;
+        This->ConnectedCount = ConnectedCount;
+        This->FailedCount = FailedCount;
+        This->CompleteEvent.Set();
+    }
+};
+
 void
 QuicTestConnectionPoolCreate(
     _In_ int Family,
@@ -4216,6 +4238,9 @@ QuicTestConnectionPoolCreate(
     PoolConfig.Family = QuicAddrFamily;
     PoolConfig.NumberOfConnections = NumberOfConnections;
     PoolConfig.Flags = QUIC_CONNECTION_POOL_FLAG_NONE;
+    ConnectionPoolCompleteContext CompleteContext;
+    PoolConfig.CompleteHandler = ConnectionPoolCompleteContext::PoolComplete;
+    PoolConfig.CompleteContext = &CompleteContext;
 
     //
     // Provide CIBIR IDs if requested for the test.
@@ -4252,6 +4277,13 @@ QuicTestConnectionPoolCreate(
             }
         }
         TEST_EQUAL(NumberOfConnections, Listener.AcceptedConnectionCount);
+
+        //
+        // All handshakes are done, so the pool completion must be indicated.
+        //
+        TEST_TRUE(CompleteContext.CompleteEvent.WaitTimeout(TestWaitTimeout));
+        TEST_EQUAL(NumberOfConnections, CompleteContext.ConnectedCount);
+        TEST_EQUAL(0, CompleteContext.FailedCount);
     } else {
         //
         // When testing no XDP support, the loopback address is used,
@@ -363,3 +363,85 @@ QuicTestMtuDiscovery(
     TEST_QUIC_SUCCEEDED(Listener.LastConnection->GetStatistics(&ServerStats));
     TEST_EQUAL(ServerExpectedMtu, ServerStats.SendPathMtu);
 }
+
+void
+QuicTestMtuBlackHole(
+    _In_ int Family
+    )
+{
+    MsQuicRegistration Registration(true);
+    TEST_QUIC_SUCCEEDED(Registration.GetInitStatus());
+
+    const uint16_t MinimumMtu = 1248;
+#if defined(QUIC_API_ENABLE_PREVIEW_FEATURES)
+    const uint16_t MaximumMtu = UseQTIP ? 1488 : 1500; // reserve 12B for TCP header
+#else
+    const uint16_t MaximumMtu = 1500;
+#endif
+    const uint16_t BlackHoleMtu = 1400;
+
+    MsQuicAlpn Alpn("MsQuicTest");
+    MsQuicSettings Settings;
+    Settings.SetMinimumMtu(MinimumMtu).SetMaximumMtu(MaximumMtu).SetIdleTimeoutMs(30000).SetDisconnectTimeoutMs(30000);
+
+    MsQuicConfiguration ServerConfiguration(Registration, Alpn, Settings, ServerSelfSignedCredConfig);
+    TEST_QUIC_SUCCEEDED(ServerConfiguration.GetInitStatus());
+
+    MsQuicCredentialConfig ClientCredConfig;
+    MsQuicConfiguration ClientConfiguration(Registration, Alpn, Settings, ClientCredConfig);
+    TEST_QUIC_SUCCEEDED(ClientConfiguration.GetInitStatus());
+
+    MsQuicAutoAcceptListener Listener(Registration, ServerConfiguration, MtuSettingsCallback);
+    TEST_QUIC_SUCCEEDED(Listener.GetInitStatus());
+    QUIC_ADDRESS_FAMILY QuicAddrFamily = (Family == 4) ? QUIC_ADDRESS_FAMILY_INET : QUIC_ADDRESS_FAMILY_INET6;
+    QuicAddr ServerLocalAddr(QuicAddrFamily);
+    TEST_QUIC_SUCCEEDED(Listener.Start(Alpn, &ServerLocalAddr.SockAddr));
+    TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+    //
+    // Nothing is dropped until the client has found the maximum MTU.
+    //
+    MtuDropHelper ServerDropper(
+        0,
+        ServerLocalAddr.GetPort(),
+        0xFFFF);
+
+    uint8_t RawBuffer[4000];
+    CxPlatZeroMemory(RawBuffer, sizeof(RawBuffer));
+    QUIC_BUFFER Buffer { sizeof(RawBuffer), RawBuffer };
+
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Connection.Start(ClientConfiguration, ServerLocalAddr.GetFamily(), QUIC_TEST_LOOPBACK_FOR_AF(ServerLocalAddr.GetFamily()), ServerLocalAddr.GetPort()));
+    MsQuicStream Stream(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL);
+    TEST_QUIC_SUCCEEDED(Stream.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Stream.Send(&Buffer, 1, QUIC_SEND_FLAG_START));
+
+    QUIC_STATISTICS_V2 Stats;
+    uint32_t Tries = 0;
+    do {
+        CxPlatSleep(50);
+        TEST_QUIC_SUCCEEDED(Connection.GetStatistics(&Stats));
+    } while (Stats.SendPathMtu != MaximumMtu && ++Tries < 40);
+    TEST_EQUAL(MaximumMtu, Stats.SendPathMtu);
+
+    //
+    // Start black holing everything larger than BlackHoleMtu and keep sending
+    // full-size packets. The client should fall back and settle below it.
+    //
+    ServerDropper.ClientDropPacketSize = BlackHoleMtu;
+
+    Tries = 0;
+    do {
+        TEST_QUIC_SUCCEEDED(Stream.Send(&Buffer, 1, QUIC_SEND_FLAG_NONE));
+        CxPlatSleep(100);
+        TEST_QUIC_SUCCEEDED(Connection.GetStatistics(&Stats));
+    } while (Stats.SendPathMtu > BlackHoleMtu && ++Tries < 40);
+    TEST_TRUE(Stats.SendPathMtu <= BlackHoleMtu);
+    TEST_TRUE(Stats.SendPathMtu >= MinimumMtu);
+
+    TEST_QUIC_SUCCEEDED(Stream.Send(&Buffer, 1, QUIC_SEND_FLAG_FIN));
+
+    Stream.Shutdown(1);
+    Connection.Shutdown(1);
+}
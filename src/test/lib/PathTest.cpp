@@ -119,3 +119,167 @@ QuicTestLocalPathChanges(
         PeerStreamsChanged.Reset();
     }
 }
+
+//
+// Counts the datagrams and bytes the server receives on any path other than
+// the client's original one.
+//
+struct MultipathRecvCounter : public DatapathHook
+{
+    uint16_t ServerPort;
+    QUIC_ADDR ClientAddr;
+    uint64_t OtherPathBytes {0};
+    CxPlatEvent OtherPathEvent;
+    MultipathRecvCounter(uint16_t Port, const QUIC_ADDR& Addr) :
+        ServerPort(Port), ClientAddr(Addr) {
+        DatapathHooks::Instance->AddHook(this);
+    }
+    ~MultipathRecvCounter() {
+        DatapathHooks::Instance->RemoveHook(this);
+    }
+    _IRQL_requires_max_(DISPATCH_LEVEL)
+    BOOLEAN
+    Receive(
+        _Inout_ struct CXPLAT_RECV_DATA* Datagram
+        ) {
+        if (QuicAddrGetPort(&Datagram->Route->LocalAddress) == ServerPort &&
+            !QuicAddrCompare(&Datagram->Route->RemoteAddress, &ClientAddr)) {
+            OtherPathBytes += Datagram->BufferLength;
+            OtherPathEvent.Set();
+        }
+        return FALSE;
+    }
+};
+
+struct MultipathTestContext {
+    CxPlatEvent StreamDoneEvent;
+    CxPlatEvent ClientStreamDoneEvent;
+    QUIC_PATH_SCHEDULING_SCHEME Scheme {QUIC_PATH_SCHEDULING_SCHEME_ACTIVE};
+
+    static QUIC_STATUS ClientStreamCallback(_In_ MsQuicStream*, _In_opt_ void* Context, _Inout_ QUIC_STREAM_EVENT* Event) {
+        if (Event->Type == QUIC_STREAM_EVENT_SHUTDOWN_COMPLETE) {
+            static_cast<MultipathTestContext*>(Context)->ClientStreamDoneEvent.Set();
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    static QUIC_STATUS StreamCallback(_In_ MsQuicStream*, _In_opt_ void* Context, _Inout_ QUIC_STREAM_EVENT* Event) {
+        if (Event->Type == QUIC_STREAM_EVENT_SHUTDOWN_COMPLETE) {
+            static_cast<MultipathTestContext*>(Context)->StreamDoneEvent.Set();
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    static QUIC_STATUS ConnCallback(_In_ MsQuicConnection* Conn, _In_opt_ void* Context, _Inout_ QUIC_CONNECTION_EVENT* Event) {
+        MultipathTestContext* Ctx = static_cast<MultipathTestContext*>(Context);
+        if (Event->Type == QUIC_CONNECTION_EVENT_CONNECTED) {
+            Conn->SetParam(QUIC_PARAM_CONN_PATH_SCHEDULING_SCHEME, sizeof(Ctx->Scheme), &Ctx->Scheme);
+        } else if (Event->Type == QUIC_CONNECTION_EVENT_PEER_STREAM_STARTED) {
+            new(std::nothrow) MsQuicStream(Event->PEER_STREAM_STARTED.Stream, CleanUpAutoDelete, StreamCallback, Context);
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+};
+
+void
+QuicTestMultipathScheduling(
+    _In_ int Family
+    )
+{
+    const uint32_t SendLength = 0x100000;
+
+    MsQuicRegistration Registration{true};
+    TEST_QUIC_SUCCEEDED(Registration.GetInitStatus());
+
+    MsQuicConfiguration ServerConfiguration(Registration, "MsQuicTest", MsQuicSettings().SetPeerUnidiStreamCount(2), ServerSelfSignedCredConfig);
+    TEST_QUIC_SUCCEEDED(ServerConfiguration.GetInitStatus());
+
+    MsQuicConfiguration ClientConfiguration(Registration, "MsQuicTest", MsQuicCredentialConfig{});
+    TEST_QUIC_SUCCEEDED(ClientConfiguration.GetInitStatus());
+
+    UniquePtr<uint8_t[]> RawBuffer{new(std::nothrow) uint8_t[SendLength]};
+    TEST_NOT_EQUAL(nullptr, RawBuffer.get());
+    QUIC_BUFFER Buffer { SendLength, RawBuffer.get() };
+
+    const QUIC_PATH_SCHEDULING_SCHEME Schemes[] = {
+        QUIC_PATH_SCHEDULING_SCHEME_MIN_RTT,
+        QUIC_PATH_SCHEDULING_SCHEME_WEIGHTED
+    };
+
+    for (auto Scheme : Schemes) {
+        MultipathTestContext Context;
+        Context.Scheme = Scheme;
+
+        MsQuicAutoAcceptListener Listener(Registration, ServerConfiguration, MultipathTestContext::ConnCallback, &Context);
+        TEST_QUIC_SUCCEEDED(Listener.GetInitStatus());
+        QUIC_ADDRESS_FAMILY QuicAddrFamily = (Family == 4) ? QUIC_ADDRESS_FAMILY_INET : QUIC_ADDRESS_FAMILY_INET6;
+        QuicAddr ServerLocalAddr(QuicAddrFamily);
+        TEST_QUIC_SUCCEEDED(Listener.Start("MsQuicTest", &ServerLocalAddr.SockAddr));
+        TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        TEST_QUIC_SUCCEEDED(Connection.SetParam(QUIC_PARAM_CONN_PATH_SCHEDULING_SCHEME, sizeof(Context.Scheme), &Context.Scheme));
+        TEST_QUIC_SUCCEEDED(Connection.Start(ClientConfiguration, ServerLocalAddr.GetFamily(), QUIC_TEST_LOOPBACK_FOR_AF(ServerLocalAddr.GetFamily()), ServerLocalAddr.GetPort()));
+        TEST_TRUE(Connection.HandshakeCompleteEvent.WaitTimeout(TestWaitTimeout));
+        TEST_TRUE(Connection.HandshakeComplete);
+
+        QuicAddr LocalAddr;
+        TEST_QUIC_SUCCEEDED(Connection.GetLocalAddr(LocalAddr));
+        MultipathRecvCounter Counter(ServerLocalAddr.GetPort(), LocalAddr.SockAddr);
+
+        //
+        // A stream round trip makes sure the client has the server's
+        // HANDSHAKE_DONE and spare CIDs, which a second path needs.
+        //
+        {
+            uint8_t WarmUp = 0;
+            QUIC_BUFFER WarmUpBuffer { sizeof(WarmUp), &WarmUp };
+            MsQuicStream Stream(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL, CleanUpManual, MultipathTestContext::ClientStreamCallback, &Context);
+            TEST_QUIC_SUCCEEDED(Stream.GetInitStatus());
+            TEST_QUIC_SUCCEEDED(Stream.Send(&WarmUpBuffer, 1, QUIC_SEND_FLAG_START | QUIC_SEND_FLAG_FIN));
+            TEST_TRUE(Context.ClientStreamDoneEvent.WaitTimeout(TestWaitTimeout));
+            TEST_TRUE(Context.StreamDoneEvent.WaitTimeout(TestWaitTimeout));
+            Context.StreamDoneEvent.Reset();
+        }
+
+        //
+        // Open a second path from another local port, and wait for its path
+        // challenge to reach the server.
+        //
+        QuicAddr SecondLocalAddr = LocalAddr;
+        QuicAddrSetPort(&SecondLocalAddr.SockAddr, 0);
+        TEST_QUIC_SUCCEEDED(
+            Connection.SetParam(
+                QUIC_PARAM_CONN_ADD_LOCAL_ADDRESS,
+                sizeof(SecondLocalAddr.SockAddr),
+                &SecondLocalAddr.SockAddr));
+        TEST_TRUE(Counter.OtherPathEvent.WaitTimeout(TestWaitTimeout));
+        const uint64_t ValidationBytes = Counter.OtherPathBytes;
+
+        MsQuicStream Stream(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL);
+        TEST_QUIC_SUCCEEDED(Stream.GetInitStatus());
+        TEST_QUIC_SUCCEEDED(Stream.Send(&Buffer, 1, QUIC_SEND_FLAG_START | QUIC_SEND_FLAG_FIN));
+        TEST_TRUE(Context.StreamDoneEvent.WaitTimeout(TestWaitTimeout));
+
+        if (Scheme == QUIC_PATH_SCHEDULING_SCHEME_WEIGHTED) {
+            //
+            // Both loopback paths have similar RTTs, so the weighted scheduler
+            // must have put some of the stream's data on the second path.
+            //
+            TEST_TRUE(Counter.OtherPathBytes > ValidationBytes);
+        }
+
+        //
+        // Sending across both paths must not make the client migrate.
+        //
+        QuicAddr CurrentLocalAddr;
+        TEST_QUIC_SUCCEEDED(Connection.GetLocalAddr(CurrentLocalAddr));
+        TEST_TRUE(QuicAddrCompare(&LocalAddr.SockAddr, &CurrentLocalAddr.SockAddr));
+
+        QUIC_PATH_SCHEDULING_SCHEME CurrentScheme = QUIC_PATH_SCHEDULING_SCHEME_ACTIVE;
+        uint32_t SchemeLength = sizeof(CurrentScheme);
+        TEST_QUIC_SUCCEEDED(Connection.GetParam(QUIC_PARAM_CONN_PATH_SCHEDULING_SCHEME, &SchemeLength, &CurrentScheme));
+        TEST_EQUAL(CurrentScheme, Context.Scheme);
+    }
+}
@@ -28,6 +28,7 @@ TestConnection::TestConnection(
     ExpectedCustomValidationResult(false), PeerCertEventReturnStatus(QUIC_STATUS_SUCCESS),
     EventDeleted(nullptr),
     NewStreamCallback(NewStreamCallbackHandler), ShutdownCompleteCallback(nullptr),
+    DatagramSentCallback(nullptr),
     DatagramsSent(0), DatagramsCanceled(0), DatagramsSuspectLost(0),
     DatagramsLost(0), DatagramsAcknowledged(0), NegotiatedAlpn(nullptr),
     NegotiatedAlpnLength(0), SslKeyLogFileName(nullptr), Context(nullptr)
@@ -62,6 +63,7 @@ TestConnection::TestConnection(
     ExpectedCustomValidationResult(false), PeerCertEventReturnStatus(QUIC_STATUS_SUCCESS),
     EventDeleted(nullptr),
     NewStreamCallback(NewStreamCallbackHandler), ShutdownCompleteCallback(nullptr),
+    DatagramSentCallback(nullptr),
     DatagramsSent(0), DatagramsCanceled(0), DatagramsSuspectLost(0),
     DatagramsLost(0), DatagramsAcknowledged(0), NegotiatedAlpn(nullptr),
     NegotiatedAlpnLength(0), SslKeyLogFileName(nullptr), Context(nullptr)
@@ -920,6 +922,9 @@ TestConnection::HandleConnectionEvent(
             break;
         case QUIC_DATAGRAM_SEND_SENT:
             DatagramsSent++;
+            if (DatagramSentCallback) {
+                DatagramSentCallback(this, Event->DATAGRAM_SEND_STATE_CHANGED.ClientContext);
+            }
             break;
         case QUIC_DATAGRAM_SEND_LOST_SUSPECT:
             DatagramsSuspectLost++;
@@ -45,6 +45,19 @@ void
 
 typedef CONN_SHUTDOWN_COMPLETE_CALLBACK *CONN_SHUTDOWN_COMPLETE_CALLBACK_HANDLER;
 
+//
+// Callback for processing a datagram being sent.
+//
+typedef
+_Function_class_(DATAGRAM_SENT_CALLBACK)
+void
+(DATAGRAM_SENT_CALLBACK)(
+    _In_ TestConnection* Connection,
+    _In_opt_ void* ClientContext
+    );
+
+typedef DATAGRAM_SENT_CALLBACK *DATAGRAM_SENT_CALLBACK_HANDLER;
+
 //
 // A C++ Wrapper for the MsQuic Connection handle.
 //
@@ -86,6 +99,7 @@ class TestConnection
 
     NEW_STREAM_CALLBACK_HANDLER NewStreamCallback;
     CONN_SHUTDOWN_COMPLETE_CALLBACK_HANDLER ShutdownCompleteCallback;
+    DATAGRAM_SENT_CALLBACK_HANDLER DatagramSentCallback;
 
     QUIC_BUFFER* ResumptionTicket {nullptr};
 
@@ -182,6 +196,10 @@ public:
         ShutdownCompleteCallback = Handler;
     }
 
+    void SetDatagramSentCallback(DATAGRAM_SENT_CALLBACK_HANDLER Handler) {
+        DatagramSentCallback = Handler;
+    }
+
     //
     // State
     //
@@ -311,6 +311,12 @@ QuicTraceGlobalEvent(
             case QUIC_PERF_COUNTER_CONN_LOAD_REJECT:
                 printf("    Total connections rejected due to worker load:      ");
                 break;
+            case QUIC_PERF_COUNTER_WORK_ACTIVE_US:
+                printf("    Total microseconds workers spent processing work:   ");
+                break;
+            case QUIC_PERF_COUNTER_WORK_POLL_US:
+                printf("    Total microseconds workers spent polling idle:      ");
+                break;
             default:
                 printf("    Unknown:                                            ");
                 break;
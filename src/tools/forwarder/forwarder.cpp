@@ -16,6 +16,8 @@ Abstract:
 
 #include "msquichelper.h"
 #include "msquic.hpp"
+#include <atomic>
+#include <mutex>
 
 const char* Alpn;
 uint16_t FrontEndPort;
@@ -31,7 +33,11 @@ MsQuicConfiguration* FrontEndConfiguration;
 MsQuicConfiguration* BackEndConfiguration;
 
 #define USAGE \
-    "Usage: quicforward <alpn> <local-port> <target-name/ip>:<target-port> <thumbprint> [0/1-buffered-mode] [fc-window]\n"
+    "Usage: quicforward <alpn> <local-port> <target-name/ip>:<target-port> <thumbprint> [0/1-buffered-mode] [fc-window]\n" \
+    "\n" \
+    "  buffered-mode 1 (default) copies received data and completes the receive immediately.\n" \
+    "  buffered-mode 0 (splice) sends the received buffers as-is and completes the receive once\n" \
+    "  the peer stream's send completes, so back pressure propagates end to end.\n"
 
 bool ParseArgs(int argc, char **argv) {
     if (argc < 5) {
@@ -60,13 +66,77 @@ bool ParseArgs(int argc, char **argv) {
     return true;
 }
 
+//
+// Relay statistics, printed on exit. Latency is measured from the receive on
+// one stream until the forwarded data is acknowledged on the peer stream.
+// Outstanding bytes are either copies (buffered mode) or receive buffers held
+// by MsQuic until ReceiveComplete (splice mode).
+//
+struct RelayStats {
+    std::atomic<uint64_t> BytesRelayed {0};
+    std::atomic<uint64_t> SendsCompleted {0};
+    std::atomic<uint64_t> TotalLatencyUs {0};
+    std::atomic<uint64_t> MaxLatencyUs {0};
+    std::atomic<uint64_t> BytesOutstanding {0};
+    std::atomic<uint64_t> MaxBytesOutstanding {0};
+    std::atomic<uint64_t> SendsOutstanding {0};
+    std::atomic<uint64_t> MaxSendsOutstanding {0};
+
+    static void UpdateMax(std::atomic<uint64_t>& Max, uint64_t Value) {
+        uint64_t Current = Max.load(std::memory_order_relaxed);
+        while (Value > Current &&
+               !Max.compare_exchange_weak(Current, Value, std::memory_order_relaxed)) { }
+    }
+
+    void OnSend(uint64_t Length) {
+        UpdateMax(MaxBytesOutstanding, BytesOutstanding.fetch_add(Length) + Length);
+        UpdateMax(MaxSendsOutstanding, SendsOutstanding.fetch_add(1) + 1);
+    }
+
+    void OnSendComplete(uint64_t Length, uint64_t LatencyUs, bool Canceled) {
+        BytesOutstanding.fetch_sub(Length);
+        SendsOutstanding.fetch_sub(1);
+        if (!Canceled) {
+            BytesRelayed.fetch_add(Length, std::memory_order_relaxed);
+            SendsCompleted.fetch_add(1, std::memory_order_relaxed);
+            TotalLatencyUs.fetch_add(LatencyUs, std::memory_order_relaxed);
+            UpdateMax(MaxLatencyUs, LatencyUs);
+        }
+    }
+
+    void Print() {
+        const uint64_t Sends = SendsCompleted.load();
+        printf("Relayed %llu bytes in %llu sends\n",
+            (unsigned long long)BytesRelayed.load(),
+            (unsigned long long)Sends);
+        printf("Relay latency: avg %llu us, max %llu us\n",
+            (unsigned long long)(Sends ? TotalLatencyUs.load() / Sends : 0),
+            (unsigned long long)MaxLatencyUs.load());
+        printf("Outstanding high-water: %llu bytes, %llu sends\n",
+            (unsigned long long)MaxBytesOutstanding.load(),
+            (unsigned long long)MaxSendsOutstanding.load());
+    }
+} Stats;
+
 struct ForwardedSend {
     uint64_t TotalLength;
+    uint64_t ReceiveTimeUs;
+    ForwardedSend* Next; // Free list linkage (splice mode)
     QUIC_BUFFER Buffers[3];
+
+    //
+    // Splice mode sends reference the receive buffers directly, so the send
+    // contexts are all the same size and are recycled instead of allocated
+    // for every receive.
+    //
+    static std::mutex FreeListLock;
+    static ForwardedSend* FreeList;
+
     static ForwardedSend* New(QUIC_STREAM_EVENT* Event) {
+        ForwardedSend* SendContext;
         if (BufferedMode) {
-            auto SendContext = (ForwardedSend*)malloc(sizeof(ForwardedSend) + (size_t)Event->RECEIVE.TotalBufferLength);
-            SendContext->TotalLength = Event->RECEIVE.TotalBufferLength;
+            SendContext = (ForwardedSend*)malloc(sizeof(ForwardedSend) + (size_t)Event->RECEIVE.TotalBufferLength);
+            if (!SendContext) { return nullptr; }
             SendContext->Buffers[0].Buffer = (uint8_t*)SendContext + sizeof(ForwardedSend);
             SendContext->Buffers[0].Length = 0;
             for (uint32_t i = 0; i < Event->RECEIVE.BufferCount; ++i) {
@@ -76,22 +146,44 @@ struct ForwardedSend {
                     Event->RECEIVE.Buffers[i].Length);
                 SendContext->Buffers[0].Length += Event->RECEIVE.Buffers[i].Length;
             }
-            return SendContext;
+        } else {
+            {
+                std::lock_guard<std::mutex> Scope(FreeListLock);
+                SendContext = FreeList;
+                if (SendContext) { FreeList = SendContext->Next; }
+            }
+            if (!SendContext) {
+                SendContext = new(std::nothrow) ForwardedSend;
+                if (!SendContext) { return nullptr; }
+            }
+            CXPLAT_FRE_ASSERT(Event->RECEIVE.BufferCount <= ARRAYSIZE(SendContext->Buffers));
+            for (uint32_t i = 0; i < Event->RECEIVE.BufferCount; ++i) {
+                SendContext->Buffers[i].Length = Event->RECEIVE.Buffers[i].Length;
+                SendContext->Buffers[i].Buffer = Event->RECEIVE.Buffers[i].Buffer;
+            }
         }
-        auto SendContext = new(std::nothrow) ForwardedSend;
         SendContext->TotalLength = Event->RECEIVE.TotalBufferLength;
-        for (uint32_t i = 0; i < Event->RECEIVE.BufferCount; ++i) {
-            SendContext->Buffers[i].Length = Event->RECEIVE.Buffers[i].Length;
-            SendContext->Buffers[i].Buffer = Event->RECEIVE.Buffers[i].Buffer;
-        }
+        SendContext->ReceiveTimeUs = CxPlatTimeUs64();
+        Stats.OnSend(SendContext->TotalLength);
         return SendContext;
     }
-    static void Delete(ForwardedSend* SendContext) {
+    static void Delete(ForwardedSend* SendContext, bool Canceled = true) {
+        Stats.OnSendComplete(
+            SendContext->TotalLength,
+            CxPlatTimeDiff64(SendContext->ReceiveTimeUs, CxPlatTimeUs64()),
+            Canceled);
         if (BufferedMode) { free(SendContext); }
-        else { delete SendContext; }
+        else {
+            std::lock_guard<std::mutex> Scope(FreeListLock);
+            SendContext->Next = FreeList;
+            FreeList = SendContext;
+        }
     }
 };
 
+std::mutex ForwardedSend::FreeListLock;
+ForwardedSend* ForwardedSend::FreeList = nullptr;
+
 QUIC_STATUS StreamCallback(
     _In_ struct MsQuicStream* /* Stream */,
     _In_opt_ void* Context,
@@ -110,6 +202,10 @@ QUIC_STATUS StreamCallback(
             return QUIC_STATUS_SUCCESS;
         }
         auto SendContext = ForwardedSend::New(Event);
+        if (!SendContext) {
+            PeerStream->Shutdown(0, QUIC_STREAM_SHUTDOWN_FLAG_ABORT);
+            return QUIC_STATUS_SUCCESS;
+        }
         QUIC_SEND_FLAGS Flags = QUIC_SEND_FLAG_START;
         if (Event->RECEIVE.Flags & QUIC_RECEIVE_FLAG_FIN)   { Flags |= QUIC_SEND_FLAG_FIN; }
         if (Event->RECEIVE.Flags & QUIC_RECEIVE_FLAG_0_RTT) { Flags |= QUIC_SEND_FLAG_ALLOW_0_RTT; }
@@ -120,6 +216,11 @@ QUIC_STATUS StreamCallback(
             return QUIC_STATUS_SUCCESS;
         }
         CXPLAT_FRE_ASSERT(QUIC_SUCCEEDED(Status));
+        //
+        // In splice mode the receive stays pending until the peer stream has
+        // sent (and had acknowledged) the data, so the front end's flow control
+        // window only opens as fast as the back end drains it.
+        //
         return BufferedMode ? QUIC_STATUS_SUCCESS : QUIC_STATUS_PENDING;
     }
     case QUIC_STREAM_EVENT_SEND_COMPLETE: {
@@ -128,7 +229,7 @@ QUIC_STATUS StreamCallback(
         if (!BufferedMode && !Event->SEND_COMPLETE.Canceled && PeerStream) {
             PeerStream->ReceiveComplete(SendContext->TotalLength);
         }
-        ForwardedSend::Delete(SendContext);
+        ForwardedSend::Delete(SendContext, Event->SEND_COMPLETE.Canceled);
         break;
     }
     case QUIC_STREAM_EVENT_PEER_SEND_ABORTED:
@@ -235,5 +336,6 @@ int QUIC_MAIN_EXPORT main(int argc, char **argv) {
 
     printf("Press Enter to exit.\n\n");
     (void)getchar();
+    Stats.Print();
     return 0;
 }
@@ -11,7 +11,7 @@ Abstract:
 --*/
 
 #include <vector>
-#include <unordered_map>
+#include <atomic>
 #include <mutex>
 
 #include "quic_datapath.h"
@@ -22,6 +22,18 @@ bool Verbose = false;
 CXPLAT_DATAPATH* Datapath;
 struct LbInterface* PublicInterface;
 std::vector<QUIC_ADDR> PrivateAddrs;
+uint32_t MaxFlows = 65536;
+
+//
+// QUIC-LB style routing, matching the private servers' load balancing mode
+// (QUIC_PARAM_GLOBAL_LOAD_BALACING_MODE). Those servers encode a 4 byte
+// server ID after the first byte of every CID they issue, so packets that
+// arrive on a new 4-tuple can still be routed to the server that owns the
+// connection.
+//
+QUIC_LOAD_BALANCING_MODE LbMode = QUIC_LOAD_BALANCING_DISABLED;
+std::vector<uint32_t> ServerIds; // One per private address
+const uint8_t LbCidLength = 5 + 2 + 7; // Server ID + partition ID + payload
 
 struct LbInterface {
     bool IsPublic;
@@ -50,11 +62,18 @@ struct LbInterface {
     }
 
     virtual ~LbInterface() {
-        CxPlatSocketDelete(Socket);
+        if (Socket) {
+            CxPlatSocketDelete(Socket);
+        }
     }
 
     virtual void Receive(_In_ CXPLAT_RECV_DATA* RecvDataChain) = 0;
 
+    //
+    // Forwards the whole chain, coalescing consecutive datagrams of the same
+    // size into one segmented (GSO) send. A shorter datagram may still end a
+    // batch; a larger one starts a new batch.
+    //
     void Send(_In_ CXPLAT_RECV_DATA* RecvDataChain, _In_opt_ const QUIC_ADDR* PeerAddress = nullptr) {
         QUIC_ADDR RemoteAddress;
         if (PeerAddress == nullptr) {
@@ -67,20 +86,25 @@ struct LbInterface {
         CXPLAT_SEND_DATA* Send = nullptr;
         CXPLAT_SEND_CONFIG SendConfig = { &Route, MAX_UDP_PAYLOAD_LENGTH, CXPLAT_ECN_NON_ECT, 0, CXPLAT_DSCP_CS0 };
         while (RecvDataChain) {
+            if (Send && RecvDataChain->BufferLength > SendConfig.MaxPacketSize) {
+                (void)CxPlatSocketSend(Socket, &Route, Send);
+                Send = nullptr;
+            }
             if (!Send) {
+                SendConfig.MaxPacketSize = RecvDataChain->BufferLength;
                 Send = CxPlatSendDataAlloc(Socket, &SendConfig);
             }
             if (Send) {
-                auto Buffer = CxPlatSendDataAllocBuffer(Send, MAX_UDP_PAYLOAD_LENGTH);
+                auto Buffer = CxPlatSendDataAllocBuffer(Send, RecvDataChain->BufferLength);
                 if (!Buffer) {
                     (void)CxPlatSocketSend(Socket, &Route, Send);
+                    SendConfig.MaxPacketSize = RecvDataChain->BufferLength;
                     Send = CxPlatSendDataAlloc(Socket, &SendConfig);
                     if (Send) {
-                        Buffer = CxPlatSendDataAllocBuffer(Send, MAX_UDP_PAYLOAD_LENGTH);
+                        Buffer = CxPlatSendDataAllocBuffer(Send, RecvDataChain->BufferLength);
                     }
                 }
                 if (Buffer) {
-                    Buffer->Length = RecvDataChain->BufferLength;
                     CxPlatCopyMemory(Buffer->Buffer, RecvDataChain->Buffer, RecvDataChain->BufferLength);
                 }
             }
@@ -115,56 +139,236 @@ struct LbPrivateInterface : public LbInterface {
 };
 
 //
-// Represents the public listening socket that load balances (and NATs) UDP
-// packets between public clients and back end (private) server addresses.
+// Returns the index of the private server that issued the packet's destination
+// CID, or UINT32_MAX if it can't be determined (e.g. a client Initial, whose
+// CID is chosen by the client).
 //
-struct LbPublicInterface : public LbInterface {
-    struct Hasher {
-        CXPLAT_TOEPLITZ_HASH Toeplitz;
-        Hasher() {
-            CxPlatRandom(CXPLAT_TOEPLITZ_INPUT_SIZE_QUIC, &Toeplitz.HashKey);
-            Toeplitz.InputSize = CXPLAT_TOEPLITZ_INPUT_SIZE_QUIC;
-            CxPlatToeplitzHashInitialize(&Toeplitz);
+uint32_t FindServerForPacket(_In_reads_(Length) const uint8_t* Buffer, uint32_t Length) {
+    if (LbMode == QUIC_LOAD_BALANCING_DISABLED || Length == 0) {
+        return UINT32_MAX;
+    }
+    const uint8_t* Cid;
+    if (Buffer[0] & 0x80) { // Long header
+        if (Length < 6 || Buffer[5] != LbCidLength || Length < 6u + LbCidLength) {
+            return UINT32_MAX;
         }
-        size_t operator() (const std::pair<QUIC_ADDR, QUIC_ADDR> key) const {
-            uint32_t Key = 0, Offset;
-            CxPlatToeplitzHashComputeAddr(&Toeplitz, &key.first, &Key, &Offset);
-            CxPlatToeplitzHashComputeAddr(&Toeplitz, &key.second, &Key, &Offset);
-            return Key;
+        Cid = Buffer + 6;
+    } else {
+        if (Length < 1u + LbCidLength) {
+            return UINT32_MAX;
         }
-    };
-
-    struct EqualFn {
-        bool operator() (const std::pair<QUIC_ADDR, QUIC_ADDR>& t1, const std::pair<QUIC_ADDR, QUIC_ADDR>& t2) const {
-            return QuicAddrCompare(&t1.second, &t2.second);
+        Cid = Buffer + 1;
+    }
+    uint32_t ServerId;
+    CxPlatCopyMemory(&ServerId, Cid + 1, sizeof(ServerId)); // First byte is random
+    for (uint32_t i = 0; i < (uint32_t)ServerIds.size(); ++i) {
+        if (ServerIds[i] == ServerId) {
+            return i;
         }
-    };
+    }
+    return UINT32_MAX;
+}
+
+//
+// A flow (public 4-tuple) that has been assigned to a private interface.
+// Entries are immutable once published in the flow table.
+//
+struct LbFlow {
+    const QUIC_ADDR Local;
+    const QUIC_ADDR Remote;
+    const uint32_t Hash;
+    LbPrivateInterface* const PrivateInterface;
+
+    LbFlow(
+        _In_ const QUIC_ADDR* Local,
+        _In_ const QUIC_ADDR* Remote,
+        uint32_t Hash,
+        _In_ LbPrivateInterface* PrivateInterface)
+        : Local(*Local), Remote(*Remote), Hash(Hash), PrivateInterface(PrivateInterface) { }
+};
 
-    std::unordered_map<std::pair<QUIC_ADDR, QUIC_ADDR>, LbPrivateInterface*, Hasher, EqualFn> PrivateInterfaces;
+//
+// Open addressing (linear probing) flow table. Lookups are lock-free; inserts
+// are serialized by the shard lock, which is only taken for new flows. Flows
+// are never removed while the load balancer runs, so a published slot stays
+// valid until the table is destroyed.
+//
+struct LbFlowTableShard {
     std::mutex Lock;
-    uint32_t NextInterface = 0;
+    uint32_t Mask {0};
+    uint32_t Count {0};
+    std::atomic<LbFlow*>* Slots {nullptr};
+
+    ~LbFlowTableShard() {
+        for (uint32_t i = 0; Slots && i <= Mask; ++i) {
+            auto Flow = Slots[i].load(std::memory_order_relaxed);
+            if (Flow) {
+                delete Flow->PrivateInterface;
+                delete Flow;
+            }
+        }
+        delete [] Slots;
+    }
 
-    LbPublicInterface(_In_ const QUIC_ADDR* PublicAddress) : LbInterface(PublicAddress, true) { }
+    bool Initialize(uint32_t SlotCount) {
+        Slots = new(std::nothrow) std::atomic<LbFlow*>[SlotCount];
+        if (!Slots) {
+            return false;
+        }
+        for (uint32_t i = 0; i < SlotCount; ++i) {
+            Slots[i].store(nullptr, std::memory_order_relaxed);
+        }
+        Mask = SlotCount - 1;
+        return true;
+    }
+
+    LbFlow* Lookup(_In_ const QUIC_ADDR* Local, _In_ const QUIC_ADDR* Remote, uint32_t Hash) const {
+        for (uint32_t i = 0; i <= Mask; ++i) {
+            auto Flow = Slots[(Hash + i) & Mask].load(std::memory_order_acquire);
+            if (!Flow) {
+                return nullptr;
+            }
+            if (Flow->Hash == Hash &&
+                QuicAddrCompare(&Flow->Remote, Remote) &&
+                QuicAddrCompare(&Flow->Local, Local)) {
+                return Flow;
+            }
+        }
+        return nullptr;
+    }
+
+    //
+    // Inserts the flow, unless the table is full. Must be called with the lock
+    // held, after a locked Lookup missed.
+    //
+    bool Insert(_In_ LbFlow* Flow) {
+        if (Count >= (Mask + 1) - ((Mask + 1) / 4)) { // Keep the load factor <= 75%
+            return false;
+        }
+        uint32_t i = Flow->Hash & Mask;
+        while (Slots[i].load(std::memory_order_relaxed)) {
+            i = (i + 1) & Mask;
+        }
+        Slots[i].store(Flow, std::memory_order_release);
+        Count++;
+        return true;
+    }
+};
+
+//
+// Represents the public listening socket that load balances (and NATs) UDP
+// packets between public clients and back end (private) server addresses.
+//
+struct LbPublicInterface : public LbInterface {
+    CXPLAT_TOEPLITZ_HASH Toeplitz;
+    LbFlowTableShard* Shards {nullptr};
+    uint32_t ShardMask {0};
+    std::atomic<uint32_t> NextInterface {0};
+
+    LbPublicInterface(_In_ const QUIC_ADDR* PublicAddress) : LbInterface(PublicAddress, true) {
+        CxPlatRandom(CXPLAT_TOEPLITZ_INPUT_SIZE_QUIC, &Toeplitz.HashKey);
+        Toeplitz.InputSize = CXPLAT_TOEPLITZ_INPUT_SIZE_QUIC;
+        CxPlatToeplitzHashInitialize(&Toeplitz);
+
+        //
+        // One shard per partition (rounded up to a power of 2), so that
+        // concurrent receives on different cores rarely touch the same shard.
+        //
+        uint32_t ShardCount = 1;
+        while (ShardCount < CxPlatProcCount()) {
+            ShardCount <<= 1;
+        }
+        uint32_t SlotCount = 16;
+        while (SlotCount * ShardCount < MaxFlows + MaxFlows / 3) {
+            SlotCount <<= 1;
+        }
+        Shards = new(std::nothrow) LbFlowTableShard[ShardCount];
+        if (!Shards) {
+            printf("Failed to allocate flow table.\n");
+            exit(1);
+        }
+        for (uint32_t i = 0; i < ShardCount; ++i) {
+            if (!Shards[i].Initialize(SlotCount)) {
+                printf("Failed to allocate flow table.\n");
+                exit(1);
+            }
+        }
+        ShardMask = ShardCount - 1;
+    }
 
     ~LbPublicInterface() {
-        // TODO - Iterate over private interfaces and delete
+        //
+        // The public socket must be closed before the private interfaces are
+        // deleted, so that no receive can still be using them.
+        //
+        CxPlatSocketDelete(Socket);
+        Socket = nullptr;
+        delete [] Shards;
     }
 
     void Receive(_In_ CXPLAT_RECV_DATA* RecvDataChain) {
-        auto PrivateInterface =
-            GetPrivateInterface(
-                &RecvDataChain->Route->LocalAddress,
-                &RecvDataChain->Route->RemoteAddress);
-        PrivateInterface->Send(RecvDataChain);
+        //
+        // A receive batch can contain packets from many flows. Forward each run
+        // of packets from the same flow as a single (segmented) send.
+        //
+        while (RecvDataChain) {
+            auto Last = RecvDataChain;
+            while (Last->Next &&
+                QuicAddrCompare(&Last->Next->Route->RemoteAddress, &RecvDataChain->Route->RemoteAddress) &&
+                QuicAddrCompare(&Last->Next->Route->LocalAddress, &RecvDataChain->Route->LocalAddress)) {
+                Last = Last->Next;
+            }
+            auto Next = Last->Next;
+            Last->Next = nullptr;
+            auto PrivateInterface = GetPrivateInterface(RecvDataChain);
+            if (PrivateInterface) {
+                PrivateInterface->Send(RecvDataChain);
+            }
+            Last->Next = Next; // Restored so the whole chain is returned.
+            RecvDataChain = Next;
+        }
     }
 
-    LbInterface* GetPrivateInterface(_In_ const QUIC_ADDR* Local, _In_ const QUIC_ADDR* Remote) {
-        std::lock_guard<std::mutex> Scope(Lock);
-        auto& Entry = PrivateInterfaces[std::pair{*Local, *Remote}];
-        if (!Entry) {
-            Entry = new LbPrivateInterface(&PrivateAddrs[NextInterface++ % PrivateAddrs.size()], Remote);
+    LbInterface* GetPrivateInterface(_In_ const CXPLAT_RECV_DATA* RecvData) {
+        const QUIC_ADDR* Local = &RecvData->Route->LocalAddress;
+        const QUIC_ADDR* Remote = &RecvData->Route->RemoteAddress;
+        uint32_t Hash = 0, Offset;
+        CxPlatToeplitzHashComputeAddr(&Toeplitz, Local, &Hash, &Offset);
+        CxPlatToeplitzHashComputeAddr(&Toeplitz, Remote, &Hash, &Offset);
+
+        auto& Shard = Shards[Hash & ShardMask];
+        Hash >>= 8; // The low bits already picked the shard.
+        auto Flow = Shard.Lookup(Local, Remote, Hash);
+        if (Flow) {
+            return Flow->PrivateInterface;
+        }
+
+        std::lock_guard<std::mutex> Scope(Shard.Lock);
+        Flow = Shard.Lookup(Local, Remote, Hash);
+        if (Flow) {
+            return Flow->PrivateInterface;
+        }
+
+        //
+        // A new 4-tuple. If the packet's destination CID was issued by one of
+        // the private servers (i.e. the client migrated or was rebound by a
+        // NAT), stick with that server. Otherwise, pick the next one.
+        //
+        uint32_t Index = FindServerForPacket(RecvData->Buffer, RecvData->BufferLength);
+        if (Index == UINT32_MAX) {
+            Index = NextInterface.fetch_add(1, std::memory_order_relaxed) % (uint32_t)PrivateAddrs.size();
         }
-        return Entry;
+        auto PrivateInterface = new LbPrivateInterface(&PrivateAddrs[Index], Remote);
+        Flow = new(std::nothrow) LbFlow(Local, Remote, Hash, PrivateInterface);
+        if (!Flow || !Shard.Insert(Flow)) {
+            if (Verbose) {
+                printf("Flow table full, dropping packets.\n");
+            }
+            delete Flow;
+            delete PrivateInterface;
+            return nullptr;
+        }
+        return PrivateInterface;
     }
 };
 
@@ -183,10 +387,39 @@ main(int argc, char **argv)
     const char* PrivateAddresses = "";
     if (!TryGetValue(argc, argv, "pub", &PublicAddress) ||
         !TryGetValue(argc, argv, "priv", &PrivateAddresses)) {
-        printf("Usage: quiclb -pub:<address> -priv:<address>,<address>\n");
+        printf(
+            "Usage: quiclb -pub:<address> -priv:<address>,<address> [options]\n"
+            "\n"
+            "Options:\n"
+            "  -flows:<####>            The maximum number of flows (public 4-tuples) to track. (def:65536)\n"
+            "  -lbmode:<mode>           Route packets for known CIDs to the server that issued them.\n"
+            "                            - {none, ip, fixed} (def:none)\n"
+            "                            ip: servers use QUIC_LOAD_BALANCING_SERVER_ID_IP.\n"
+            "                            fixed: servers use QUIC_LOAD_BALANCING_SERVER_ID_FIXED.\n"
+            "  -sids:<####>,<####>      The fixed server IDs, in the same order as -priv (e.g. secnetperf -serverid).\n"
+            "  -v                       Verbose output.\n");
         exit(1);
     }
     Verbose = GetFlag(argc, argv, "v") || GetFlag(argc, argv, "verbose");
+    TryGetValue(argc, argv, "flows", &MaxFlows);
+    if (MaxFlows == 0) {
+        printf("-flows must be greater than zero.\n");
+        exit(1);
+    }
+
+    const char* LbModeStr = nullptr;
+    if (TryGetValue(argc, argv, "lbmode", &LbModeStr)) {
+        if (IsValue(LbModeStr, "none")) {
+            LbMode = QUIC_LOAD_BALANCING_DISABLED;
+        } else if (IsValue(LbModeStr, "ip")) {
+            LbMode = QUIC_LOAD_BALANCING_SERVER_ID_IP;
+        } else if (IsValue(LbModeStr, "fixed")) {
+            LbMode = QUIC_LOAD_BALANCING_SERVER_ID_FIXED;
+        } else {
+            printf("Unknown -lbmode: %s.\n", LbModeStr);
+            exit(1);
+        }
+    }
 
     QUIC_ADDR PublicAddr;
     if (!QuicAddrFromString(PublicAddress, 0, &PublicAddr) ||
@@ -211,6 +444,38 @@ main(int argc, char **argv)
         PrivateAddresses = End + 1;
     }
 
+    if (LbMode == QUIC_LOAD_BALANCING_SERVER_ID_IP) {
+        for (auto& Addr : PrivateAddrs) {
+            uint32_t ServerId;
+            if (QuicAddrGetFamily(&Addr) == QUIC_ADDRESS_FAMILY_INET) {
+                CxPlatCopyMemory(&ServerId, &Addr.Ipv4.sin_addr, sizeof(ServerId));
+            } else {
+                CxPlatCopyMemory(&ServerId, ((uint8_t*)&Addr.Ipv6.sin6_addr) + 12, sizeof(ServerId));
+            }
+            ServerIds.push_back(ServerId);
+        }
+    } else if (LbMode == QUIC_LOAD_BALANCING_SERVER_ID_FIXED) {
+        const char* ServerIdList = nullptr;
+        if (!TryGetValue(argc, argv, "sids", &ServerIdList)) {
+            printf("-lbmode:fixed requires -sids.\n");
+            exit(1);
+        }
+        while (true) {
+            char* End = nullptr;
+            ServerIds.push_back((uint32_t)strtoul(ServerIdList, &End, 0));
+            if (End == ServerIdList || (*End != ',' && *End != '\0')) {
+                printf("Failed to decode -sids: %s.\n", ServerIdList);
+                exit(1);
+            }
+            if (*End == '\0') { break; }
+            ServerIdList = End + 1;
+        }
+        if (ServerIds.size() != PrivateAddrs.size()) {
+            printf("-sids must have one server ID per -priv address.\n");
+            exit(1);
+        }
+    }
+
     CxPlatSystemLoad();
     CxPlatInitialize();
     CXPLAT_WORKER_POOL* WorkerPool = CxPlatWorkerPoolCreate(nullptr);
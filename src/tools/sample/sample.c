@@ -1181,7 +1181,10 @@
 // Context structures
 //
 typedef struct ServerStreamContext {
-    volatile int32_t OutstandingSends;
+    uint64_t OutstandingBytes;
+    uint64_t TargetOutstandingBytes;
+    uint64_t BytesSent;
+    uint32_t AppLimitedCount;
 } ServerStreamContext;
 
 typedef struct ClientContext {
@@ -1202,7 +1205,9 @@ HQUIC Registration;
 HQUIC Configuration;
 uint16_t UdpPort = 4567;
 const uint64_t IdleTimeoutMs = 65000;
-const uint32_t SendBufferLength = 4096;
+uint32_t SendBufferLength = 4096;
+uint64_t MinOutstandingBytes = 8 * 4096;
+QUIC_BUFFER SendBuffer; // Shared, read-only payload for all server sends
 const QUIC_BUFFER Alpn = { sizeof("sample") - 1, (uint8_t*)"sample" };
 const QUIC_REGISTRATION_CONFIG RegConfig = { "quicsample", QUIC_EXECUTION_PROFILE_LOW_LATENCY };
 
@@ -1279,28 +1284,22 @@ ServerListenerCallback(
 //
 // Server Implementation
 //
+//
+// Keeps at least TargetOutstandingBytes queued on the stream. Every send uses
+// the same preallocated, read-only payload, so nothing is allocated, copied
+// or initialized per send. The target follows MsQuic's ideal send buffer
+// hint, so the server keeps up with whatever the congestion controller allows.
+//
 void
 ServerSend(
     _In_ HQUIC Stream,
     _In_ ServerStreamContext* Context
     )
 {
-    while (Context->OutstandingSends < 8) {
-        void* SendBufferRaw = malloc(sizeof(QUIC_BUFFER) + SendBufferLength);
-        if (SendBufferRaw == NULL) {
-            MsQuic->StreamShutdown(Stream, QUIC_STREAM_SHUTDOWN_FLAG_ABORT, 0);
-            return;
-        }
-        QUIC_BUFFER* SendBuffer = (QUIC_BUFFER*)SendBufferRaw;
-        SendBuffer->Buffer = (uint8_t*)SendBufferRaw + sizeof(QUIC_BUFFER);
-        SendBuffer->Length = SendBufferLength;
-        memset(SendBuffer->Buffer, 'S', SendBuffer->Length);
-
-        Context->OutstandingSends++;
-
-        if (QUIC_FAILED(MsQuic->StreamSend(Stream, SendBuffer, 1, QUIC_SEND_FLAG_NONE, SendBufferRaw))) {
-            free(SendBufferRaw);
-            Context->OutstandingSends--;
+    while (Context->OutstandingBytes < Context->TargetOutstandingBytes) {
+        Context->OutstandingBytes += SendBuffer.Length;
+        if (QUIC_FAILED(MsQuic->StreamSend(Stream, &SendBuffer, 1, QUIC_SEND_FLAG_NONE, NULL))) {
+            Context->OutstandingBytes -= SendBuffer.Length;
             break;
         }
     }
@@ -1319,8 +1318,23 @@ ServerStreamCallback(
     ServerStreamContext* StreamContext = (ServerStreamContext*)Context;
     switch (Event->Type) {
     case QUIC_STREAM_EVENT_SEND_COMPLETE:
-        free(Event->SEND_COMPLETE.ClientContext);
-        StreamContext->OutstandingSends--;
+        StreamContext->OutstandingBytes -= SendBuffer.Length;
+        if (!Event->SEND_COMPLETE.Canceled) {
+            StreamContext->BytesSent += SendBuffer.Length;
+            if (StreamContext->OutstandingBytes == 0) {
+                //
+                // Everything queued has been sent, so the connection was
+                // (briefly) limited by the server instead of the network.
+                //
+                StreamContext->AppLimitedCount++;
+            }
+            ServerSend(Stream, StreamContext);
+        }
+        break;
+    case QUIC_STREAM_EVENT_IDEAL_SEND_BUFFER_SIZE:
+        StreamContext->TargetOutstandingBytes =
+            Event->IDEAL_SEND_BUFFER_SIZE.ByteCount > MinOutstandingBytes ?
+                Event->IDEAL_SEND_BUFFER_SIZE.ByteCount : MinOutstandingBytes;
         ServerSend(Stream, StreamContext);
         break;
     case QUIC_STREAM_EVENT_RECEIVE:
@@ -1329,8 +1343,16 @@ ServerStreamCallback(
         ServerSend(Stream, StreamContext);
         break;
     case QUIC_STREAM_EVENT_SHUTDOWN_COMPLETE:
-        printf("[SERVER-strm][%p] All done\n", Stream);
-        if (StreamContext != NULL) { free(StreamContext); }
+        if (StreamContext != NULL) {
+            printf("[SERVER-strm][%p] All done, sent %llu bytes, app-limited %u times (target %llu bytes)\n",
+                Stream,
+                (unsigned long long)StreamContext->BytesSent,
+                StreamContext->AppLimitedCount,
+                (unsigned long long)StreamContext->TargetOutstandingBytes);
+            free(StreamContext);
+        } else {
+            printf("[SERVER-strm][%p] All done\n", Stream);
+        }
         MsQuic->StreamClose(Stream);
         break;
     default:
@@ -1358,7 +1380,8 @@ ServerConnectionCallback(
         printf("[SERVER-strm][%p] Peer started\n", Event->PEER_STREAM_STARTED.Stream);
         ServerStreamContext* StreamContext = (ServerStreamContext*)malloc(sizeof(ServerStreamContext));
         if (StreamContext == NULL) { return QUIC_STATUS_OUT_OF_MEMORY; }
-        StreamContext->OutstandingSends = 0;
+        memset(StreamContext, 0, sizeof(*StreamContext));
+        StreamContext->TargetOutstandingBytes = MinOutstandingBytes;
         MsQuic->SetCallbackHandler(Event->PEER_STREAM_STARTED.Stream, (void*)ServerStreamCallback, StreamContext);
         break;
     case QUIC_CONNECTION_EVENT_SHUTDOWN_COMPLETE:
@@ -1488,6 +1511,27 @@ RunServer(
     )
 {
     if (!LoadConfiguration(argc, argv, TRUE)) return;
+
+    const char* Value;
+    if ((Value = GetValue(argc, argv, "sendsize")) != NULL) {
+        SendBufferLength = (uint32_t)strtoul(Value, NULL, 10);
+        if (SendBufferLength == 0) {
+            printf("Invalid -sendsize!\n");
+            return;
+        }
+    }
+    MinOutstandingBytes = 8 * (uint64_t)SendBufferLength;
+    if ((Value = GetValue(argc, argv, "outstanding")) != NULL) {
+        MinOutstandingBytes = strtoull(Value, NULL, 10);
+    }
+    SendBuffer.Buffer = (uint8_t*)malloc(SendBufferLength);
+    if (SendBuffer.Buffer == NULL) {
+        printf("SendBuffer allocation failed!\n");
+        return;
+    }
+    SendBuffer.Length = SendBufferLength;
+    memset(SendBuffer.Buffer, 'S', SendBuffer.Length);
+
     HQUIC Listener = NULL;
     QUIC_ADDR Address = {0};
     QuicAddrSetFamily(&Address, QUIC_ADDRESS_FAMILY_UNSPEC);
@@ -1808,6 +1852,9 @@ Error:
         }
         MsQuicClose(MsQuic);
     }
+    if (SendBuffer.Buffer != NULL) {
+        free(SendBuffer.Buffer); // Only after all streams are closed.
+    }
     return (int)Status;
 }
 
@@ -1869,6 +1916,9 @@ PrintUsage(void)
         "\n"
         "  -cert_file:<path>       Path to a PEM-encoded certificate file.\n"
         "  -key_file:<path>        Path to a PEM-encoded private key file.\n"
+        "  -sendsize:<bytes>       The size of each stream send. (def:4096)\n"
+        "  -outstanding:<bytes>    The minimum bytes to keep queued per stream; MsQuic's ideal\n"
+        "                          send buffer size is used when larger. (def:8 * sendsize)\n"
         "\n"
     );
 }
\ No newline at end of file